@@ -26,7 +26,7 @@ Rm_session::Local_addr
 Core_rm_session::attach(Dataspace_capability ds_cap, size_t size,
                         off_t offset, bool use_local_addr,
                         Rm_session::Local_addr local_addr,
-                        bool executable)
+                        bool executable, bool)
 {
 	using namespace Codezero;
 
@@ -30,7 +30,8 @@ namespace Genode {
 
 			Local_addr attach(Dataspace_capability ds_cap, size_t size=0,
 			                  off_t offset=0, bool use_local_addr = false,
-			                  Local_addr local_addr = 0, bool = false);
+			                  Local_addr local_addr = 0, bool = false,
+			                  bool = true);
 
 			void detach(Local_addr local_addr) { }
 
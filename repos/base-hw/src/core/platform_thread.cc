@@ -182,7 +182,7 @@ int Platform_thread::start(void * const ip, void * const sp)
 			return -1;
 		};
 		Rm_session_component * const rm = _rm_client->member_rm_session();
-		try { rm->attach(_utcb, 0, 0, true, _utcb_pd_addr, 0); }
+		try { rm->attach(_utcb, 0, 0, true, _utcb_pd_addr, 0, true); }
 		catch (...) {
 			PERR("failed to attach UTCB");
 			return -1;
@@ -75,6 +75,32 @@ namespace Genode {
 		 */
 		Thread_meta_data *meta_data;
 
+		/**
+		 * Reply channels used when the thread acts as RPC client
+		 *
+		 * Each channel is a socket pair created on the first RPC call to a
+		 * server and reused for subsequent calls to the same server. The
+		 * remote end is passed to the server with each request. A channel
+		 * is bound to the inode of the server socket rather than to the
+		 * socket descriptor, which may get reused for another server. Because
+		 * a channel is never shared among servers, a server that keeps the
+		 * remote end cannot inject replies into calls to other servers.
+		 *
+		 * The channels are kept in most-recently-used order.
+		 */
+		struct Reply_channel
+		{
+			unsigned long dst_ino;    /* inode of the server socket */
+			int           local_sd;   /* end used for receiving the reply */
+			int           remote_sd;  /* end passed to the server */
+
+			Reply_channel() : dst_ino(0), local_sd(-1), remote_sd(-1) { }
+		};
+
+		enum { NUM_REPLY_CHANNELS = 8 };
+
+		Reply_channel reply_channel[NUM_REPLY_CHANNELS];
+
 		Native_thread() : is_ipc_server(false), futex_counter(0), meta_data(0) { }
 	};
 
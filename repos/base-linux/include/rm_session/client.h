@@ -36,10 +36,11 @@ namespace Genode {
 		Local_addr attach(Dataspace_capability ds, size_t size = 0,
 		                  off_t offset = 0, bool use_local_addr = false,
 		                  Local_addr local_addr = (void *)0,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool writeable = true)
 		{
 			return _local()->attach(ds, size, offset, use_local_addr,
-			                        local_addr, executable);
+			                        local_addr, executable, writeable);
 		}
 
 		void detach(Local_addr local_addr) {
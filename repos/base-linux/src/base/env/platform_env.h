@@ -235,6 +235,7 @@ namespace Genode {
 					                 bool                 use_local_addr,
 					                 addr_t               local_addr,
 					                 bool                 executable,
+					                 bool                 writeable,
 					                 bool                 overmap = false);
 
 					/**
@@ -276,7 +277,7 @@ namespace Genode {
 
 					Local_addr attach(Dataspace_capability ds, size_t size,
 					                  off_t, bool, Local_addr,
-					                  bool executable);
+					                  bool executable, bool writeable);
 
 					void detach(Local_addr local_addr);
 
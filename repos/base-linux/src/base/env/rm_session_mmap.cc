@@ -107,10 +107,11 @@ Platform_env_base::Rm_session_mmap::_map_local(Dataspace_capability ds,
                                                bool                 use_local_addr,
                                                addr_t               local_addr,
                                                bool                 executable,
+                                               bool                 writeable,
                                                bool                 overmap)
 {
 	int  const  fd        = _dataspace_fd(ds);
-	bool const  writable  = _dataspace_writable(ds);
+	bool const  writable  = _dataspace_writable(ds) && writeable;
 
 	int  const  flags     = MAP_SHARED | (overmap ? MAP_FIXED : 0);
 	int  const  prot      = PROT_READ
@@ -156,7 +157,7 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
                                       size_t size, off_t offset,
                                       bool use_local_addr,
                                       Rm_session::Local_addr local_addr,
-                                      bool executable)
+                                      bool executable, bool writeable)
 {
 	Lock::Guard lock_guard(_lock);
 
@@ -223,7 +224,8 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
 		 * argument as the region was reserved by a PROT_NONE mapping.
 		 */
 		if (_is_attached())
-			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr, executable, true);
+			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr,
+			           executable, writeable, true);
 
 		return (void *)local_addr;
 
@@ -274,7 +276,7 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
 				 */
 				_map_local(region.dataspace(), region.size(), region.offset(),
 				           true, rm->_base + region.start() + region.offset(),
-				           executable, true);
+				           executable, true, true);
 			}
 
 			return rm->_base;
@@ -288,7 +290,7 @@ Platform_env::Rm_session_mmap::attach(Dataspace_capability ds,
 			 * Note, we do not overmap.
 			 */
 			void *addr = _map_local(ds, region_size, offset, use_local_addr,
-			                        local_addr, executable);
+			                        local_addr, executable, writeable);
 
 			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size));
 
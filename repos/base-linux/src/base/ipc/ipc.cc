@@ -301,50 +301,135 @@ static void extract_sds_from_message(unsigned start_index, Message const &msg,
 
 
 /**
- * Send request to server and wait for reply
+ * Reply channel of the calling thread for calls to a given server
+ *
+ * The channel is taken from the 'Native_thread' of the caller and created
+ * on demand. It is looked up by the inode of the server socket. Socket
+ * descriptors are no suitable key because the descriptor of a closed
+ * capability may get reused for another server. Sockets get inode numbers
+ * from an increasing counter, so an inode is not reused for another socket
+ * while channels may still refer to it. If all channels are taken, the
+ * least recently used one is replaced.
  */
-static inline void lx_call(int dst_sd,
-                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
-                           Genode::Msgbuf_base &recv_msgbuf)
+class Reply_channel
 {
-	int ret;
-	Message send_msg(send_msgbuf.buf, send_msg_len);
+	private:
 
-	/*
-	 * Create reply channel
-	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
-	 */
-	struct Reply_channel
-	{
-		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
+		typedef Genode::Native_thread::Reply_channel Channel;
+
+		enum { NUM = Genode::Native_thread::NUM_REPLY_CHANNELS };
+
+		unsigned long const _dst_ino;
+		Channel            &_channel;
+
+		/*
+		 * The main thread is not represented by a 'Thread_base' object
+		 */
+		static Channel *_main_channels()
+		{
+			static Channel channels[NUM];
+			return channels;
+		}
+
+		static unsigned long _inode(int dst_sd)
+		{
+			struct stat64 s;
+			if (lx_fstat(dst_sd, &s) < 0) {
+				PRAW("[%d] lx_fstat of sd %d failed", lx_getpid(), dst_sd);
+				throw Genode::Ipc_error();
+			}
+			return s.st_ino;
+		}
 
-		Reply_channel()
+		/**
+		 * Return channel for server and make it the most recently used
+		 *
+		 * If no channel exists for the server, the least recently used
+		 * channel is returned, which must be replaced by the caller.
+		 */
+		static Channel &_lookup(unsigned long dst_ino)
 		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
+			Genode::Thread_base * const myself = Genode::Thread_base::myself();
 
+			Channel * const channels = myself ? myself->tid().reply_channel
+			                                  : _main_channels();
+			unsigned i = 0;
+			for (; i < NUM - 1; i++)
+				if (channels[i].dst_ino == dst_ino && channels[i].local_sd != -1)
+					break;
+
+			Channel const channel = channels[i];
+			for (; i > 0; i--)
+				channels[i] = channels[i - 1];
+
+			channels[0] = channel;
+			return channels[0];
+		}
+
+	public:
+
+		Reply_channel(int dst_sd)
+		: _dst_ino(_inode(dst_sd)), _channel(_lookup(_dst_ino))
+		{
+			if (_channel.dst_ino == _dst_ino && _channel.local_sd != -1)
+				return;
+
+			destruct();
+
+			int sd[2];
 			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
 			if (ret < 0) {
 				PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
 				throw Genode::Ipc_error();
 			}
+
+			_channel.dst_ino   = _dst_ino;
+			_channel.local_sd  = sd[0];
+			_channel.remote_sd = sd[1];
 		}
 
-		~Reply_channel()
+		/**
+		 * Close channel, a new one gets created by the next call
+		 */
+		void destruct()
 		{
-			if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
-			if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
+			if (_channel.local_sd  != -1) lx_close(_channel.local_sd);
+			if (_channel.remote_sd != -1) lx_close(_channel.remote_sd);
+
+			_channel.dst_ino   = 0;
+			_channel.local_sd  = -1;
+			_channel.remote_sd = -1;
 		}
 
-		int local_socket()  const { return sd[LOCAL_SOCKET];  }
-		int remote_socket() const { return sd[REMOTE_SOCKET]; }
+		int local_socket()  const { return _channel.local_sd;  }
+		int remote_socket() const { return _channel.remote_sd; }
+};
 
-	} reply_channel;
+
+/**
+ * Send request to server and wait for reply
+ */
+static inline void lx_call(int dst_sd,
+                           Genode::Msgbuf_base &send_msgbuf, Genode::size_t send_msg_len,
+                           Genode::Msgbuf_base &recv_msgbuf)
+{
+	int ret;
+	Message send_msg(send_msgbuf.buf, send_msg_len);
+
+	Reply_channel reply_channel(dst_sd);
 
 	/* assemble message */
 
-	/* marshal reply capability */
+	/*
+	 * Marshal reply capability
+	 *
+	 * The remote end of the channel is passed with each request because
+	 * the server closes its copy after replying. Keeping the reply sockets
+	 * at the server would require it to track its clients and to learn
+	 * when a client replaces or closes a channel, which the protocol lacks.
+	 * The persistent channel saves the creation and destruction of a
+	 * socket pair per call but not the descriptor transfer.
+	 */
 	send_msg.marshal_socket(reply_channel.remote_socket());
 
 	/* marshal capabilities contained in 'send_msgbuf' */
@@ -365,6 +450,14 @@ static inline void lx_call(int dst_sd,
 
 	ret = lx_recvmsg(reply_channel.local_socket(), recv_msg.msg(), 0);
 
+	/*
+	 * The server may still reply to a call that we abandon. Replace the
+	 * channel such that such a late reply cannot be mistaken for the reply
+	 * to a subsequent call.
+	 */
+	if (ret < 0)
+		reply_channel.destruct();
+
 	/* system call got interrupted by a signal */
 	if (ret == -LX_EINTR)
 		throw Genode::Blocking_canceled();
@@ -112,6 +112,13 @@ void Thread_base::_deinit_platform_thread()
 		lx_nanosleep(&ts, 0);
 	}
 
+	/* release reply channels of the thread */
+	for (unsigned i = 0; i < Native_thread::NUM_REPLY_CHANNELS; i++) {
+		Native_thread::Reply_channel &channel = _tid.reply_channel[i];
+		if (channel.local_sd  != -1) lx_close(channel.local_sd);
+		if (channel.remote_sd != -1) lx_close(channel.remote_sd);
+	}
+
 	/* inform core about the killed thread */
 	_cpu_session->kill_thread(_thread_cap);
 }
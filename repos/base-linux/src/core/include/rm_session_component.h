@@ -50,7 +50,8 @@ namespace Genode {
 
 			void upgrade_ram_quota(size_t ram_quota) { }
 
-			Local_addr attach(Dataspace_capability, size_t, off_t, bool, Local_addr, bool) {
+			Local_addr attach(Dataspace_capability, size_t, off_t, bool,
+			                  Local_addr, bool, bool) {
 				return (addr_t)0; }
 
 			void detach(Local_addr) { }
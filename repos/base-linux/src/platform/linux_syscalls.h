@@ -38,6 +38,7 @@
 #include <signal.h>
 #include <sched.h>
 #include <sys/syscall.h>
+#include <sys/stat.h>
 
 /* Genode includes */
 #include <util/string.h>
@@ -92,6 +93,16 @@ inline int lx_dup2(int fd, int to)
 }
 
 
+inline int lx_fstat(int fd, struct stat64 *buf)
+{
+#ifdef _LP64
+	return lx_syscall(SYS_fstat, fd, buf);
+#else
+	return lx_syscall(SYS_fstat64, fd, buf);
+#endif
+}
+
+
 /*****************************************
  ** Functions used by the IPC framework **
  *****************************************/
@@ -455,6 +455,13 @@ Thread_base::~Thread_base()
 
 	_tid.meta_data = 0;
 
+	/* release reply channels of the thread */
+	for (unsigned i = 0; i < Native_thread::NUM_REPLY_CHANNELS; i++) {
+		Native_thread::Reply_channel &channel = _tid.reply_channel[i];
+		if (channel.local_sd  != -1) lx_close(channel.local_sd);
+		if (channel.remote_sd != -1) lx_close(channel.remote_sd);
+	}
+
 	/* inform core about the killed thread */
 	cpu_session(_cpu_session)->kill_thread(_thread_cap);
 }
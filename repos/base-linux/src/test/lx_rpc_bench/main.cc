@@ -0,0 +1,139 @@
+/*
+ * \brief  Microbenchmark for the RPC round-trip time on Linux
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The benchmark measures the number of RPC calls per second for calls to a
+ * local entrypoint and for calls to core. Each measurement is performed
+ * by the main thread and by a secondary thread because both kinds of threads
+ * use different code paths to obtain their persistent reply channel.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/env.h>
+#include <base/thread.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <cap_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	struct Session;
+	struct Client;
+	struct Component;
+	struct Bench_thread;
+
+	enum { NUM_CALLS = 100000 };
+}
+
+
+/**
+ * Trivial RPC interface
+ */
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "LX_RPC_BENCH"; }
+
+	GENODE_RPC(Rpc_nop, int, nop, int);
+	GENODE_RPC_INTERFACE(Rpc_nop);
+};
+
+
+struct Test::Client : Genode::Rpc_client<Session>
+{
+	Client(Genode::Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	int nop(int value) { return call<Rpc_nop>(value); }
+};
+
+
+struct Test::Component : Genode::Rpc_object<Session, Component>
+{
+	int nop(int value) { return value + 1; }
+};
+
+
+/**
+ * Execute 'fn' NUM_CALLS times and print the resulting call rate
+ */
+template <typename FUNC>
+static void measure(char const *label, Timer::Session &timer, FUNC const &fn)
+{
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < Test::NUM_CALLS; i++)
+		fn(i);
+
+	unsigned long const duration_ms = timer.elapsed_ms() - start_ms;
+
+	Genode::printf("%-24s %u calls in %lu ms -> %lu calls/s\n",
+	               label, (unsigned)Test::NUM_CALLS, duration_ms,
+	               duration_ms ? (Test::NUM_CALLS*1000UL)/duration_ms : 0UL);
+}
+
+
+static void run_benchmarks(char const *thread_label, Timer::Session &timer,
+                           Genode::Capability<Test::Session> cap)
+{
+	using namespace Genode;
+
+	Genode::printf("-- calls issued by %s --\n", thread_label);
+
+	Test::Client client(cap);
+	measure("local entrypoint:", timer, [&] (unsigned i) {
+		if (client.nop(i) != (int)i + 1)
+			PERR("unexpected result of nop RPC");
+	});
+
+	measure("core (RAM quota):", timer, [&] (unsigned) {
+		env()->ram_session()->quota(); });
+}
+
+
+struct Test::Bench_thread : Genode::Thread<4*4096>
+{
+	Timer::Session              &timer;
+	Genode::Capability<Session>  cap;
+
+	Bench_thread(Timer::Session &timer, Genode::Capability<Session> cap)
+	: Genode::Thread<4*4096>("bench"), timer(timer), cap(cap) { }
+
+	void entry() { run_benchmarks("secondary thread", timer, cap); }
+};
+
+
+int main(int argc, char **argv)
+{
+	using namespace Genode;
+
+	printf("--- Linux RPC benchmark ---\n");
+
+	static Timer::Connection timer;
+
+	enum { STACK_SIZE = 4*4096 };
+	static Cap_connection cap_session;
+	static Rpc_entrypoint ep(&cap_session, STACK_SIZE, "bench_ep");
+
+	static Test::Component component;
+	Capability<Test::Session> cap = ep.manage(&component);
+
+	run_benchmarks("main thread", timer, cap);
+
+	static Test::Bench_thread thread(timer, cap);
+	thread.start();
+	thread.join();
+
+	ep.dissolve(&component);
+
+	printf("--- finished Linux RPC benchmark ---\n");
+	return 0;
+}
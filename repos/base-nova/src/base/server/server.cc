@@ -16,6 +16,7 @@
 /* Genode includes */
 #include <base/printf.h>
 #include <base/rpc_server.h>
+#include <base/rpc_entrypoint_group.h>
 #include <base/env.h>
 
 /* NOVA includes */
@@ -70,7 +71,7 @@ void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 	 * eventually blocking operation and let the activation leave the context
 	 * of the object.
 	 */
-	_leave_server_object(obj);
+	_leave_server_object_in_group(obj);
 
 	/* wait until nobody is inside dispatch */
 	obj->acquire();
@@ -193,9 +194,11 @@ void Rpc_entrypoint::activate()
 
 Rpc_entrypoint::Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
                                const char  *name, bool start_on_construction,
-                               Affinity::Location location)
+                               Affinity::Location location,
+                               Rpc_entrypoint_group *group)
 :
 	Thread_base(name, stack_size),
+	_group(group), _pool(_init_pool(group)),
 	_curr_obj(start_on_construction ? 0 : (Rpc_object_base *)~0UL),
 	_delay_start(Lock::LOCKED),
 	_cap_session(cap_session)
@@ -234,16 +237,17 @@ Rpc_entrypoint::Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
 
 Rpc_entrypoint::~Rpc_entrypoint()
 {
-	typedef Object_pool<Rpc_object_base> Pool;
-
-	if (Pool::first()) {
+	/* the objects of a shared pool are dissolved by the group */
+	if (!_group && first()) {
 		PWRN("Object pool not empty in %s", __func__);
 
 		/* dissolve all objects - objects are not destroyed! */
-		while (Rpc_object_base *obj = Pool::first())
+		while (Rpc_object_base *obj = first())
 			_dissolve(obj);
 	}
 
+	_deinit_pool();
+
 	if (!_cap.valid())
 		return;
 
@@ -44,6 +44,15 @@ namespace Genode {
 					short  _id;         /* for debugging   */
 					size_t _max_avail;  /* biggest free block size of subtree */
 
+					/*
+					 * Links within the free list of the block's size class,
+					 * used for free blocks only
+					 */
+					Block *_free_prev;
+					Block *_free_next;
+
+					friend class Allocator_avl_base;
+
 					/**
 					 * Request max_avail value of subtree
 					 */
@@ -94,19 +103,30 @@ namespace Genode {
 					 * This constructor is called from meta-data allocator during
 					 * initialization of new meta-data blocks.
 					 */
-					Block() : _addr(0), _size(0), _used(0), _max_avail(0) { }
+					Block()
+					: _addr(0), _size(0), _used(0), _max_avail(0),
+					  _free_prev(0), _free_next(0) { }
 
 					/**
 					 * Constructor
 					 */
 					Block(addr_t addr, size_t size, bool used)
 					: _addr(addr), _size(size), _used(used),
-					  _max_avail(used ? 0 : size)
+					  _max_avail(used ? 0 : size),
+					  _free_prev(0), _free_next(0)
 					{
 						static int num_blocks;
 						_id = ++num_blocks;
 					}
 
+					/**
+					 * Query if block can hold a specified subblock
+					 *
+					 * \param n      number of bytes
+					 * \param align  alignment (log2)
+					 */
+					bool fits(size_t n, unsigned align) { return _fits(n, align); }
+
 					/**
 					 * Find best-fitting block
 					 */
@@ -132,9 +152,42 @@ namespace Genode {
 
 		private:
 
+			/*
+			 * Free blocks are additionally kept in segregated lists, one
+			 * list per log2 size class. Class 'i' holds the free blocks with
+			 * a size in the range [2^i, 2^(i+1)). The bits of
+			 * '_free_classes' mark the non-empty lists.
+			 */
+			enum {
+				NUM_SIZE_CLASSES = 8*sizeof(unsigned long),
+
+				/* number of blocks inspected per list for a best fit */
+				MAX_BEST_FIT_SCAN = 4
+			};
+
 			Avl_tree<Block>  _addr_tree;      /* blocks sorted by base address */
 			Allocator       *_md_alloc;       /* meta-data allocator           */
 			size_t           _md_entry_size;  /* size of block meta-data entry */
+			Block           *_free_lists[NUM_SIZE_CLASSES];
+			unsigned long    _free_classes;
+
+			/**
+			 * Insert free block into the list of its size class
+			 */
+			void _enqueue_free(Block *b);
+
+			/**
+			 * Remove free block from the list of its size class
+			 */
+			void _dequeue_free(Block *b);
+
+			/**
+			 * Find free block for the specified size and alignment
+			 *
+			 * The lookup uses the size-class lists and falls back to the
+			 * address tree if the lists yield no result.
+			 */
+			Block *_find_free(size_t size, unsigned align);
 
 			/**
 			 * Alloc meta-data block
@@ -188,7 +241,12 @@ namespace Genode {
 			 * we can attach custom information to block meta data.
 			 */
 			Allocator_avl_base(Allocator *md_alloc, size_t md_entry_size) :
-				_md_alloc(md_alloc), _md_entry_size(md_entry_size) { }
+				_md_alloc(md_alloc), _md_entry_size(md_entry_size),
+				_free_classes(0)
+			{
+				for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++)
+					_free_lists[i] = 0;
+			}
 
 		public:
 
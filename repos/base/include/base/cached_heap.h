@@ -0,0 +1,314 @@
+/*
+ * \brief  Heap front end with per-thread caches of small blocks
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__CACHED_HEAP_H_
+#define _INCLUDE__BASE__CACHED_HEAP_H_
+
+#include <base/heap.h>
+#include <base/thread.h>
+#include <util/string.h>
+
+namespace Genode { class Cached_heap; }
+
+
+/**
+ * Allocator that caches small blocks of a 'Heap' per thread
+ *
+ * Small allocations are rounded up to a power-of-two size class. Each thread
+ * owns a magazine of free blocks per size class. As long as its magazine is
+ * neither empty nor full, a thread allocates and frees blocks without
+ * acquiring any lock. Otherwise, the magazine is refilled from or partially
+ * flushed to the heap via 'Heap::alloc_batch' and 'Heap::free_batch', which
+ * acquire the heap lock once per batch. Large blocks are passed to the heap
+ * directly.
+ *
+ * Because the size class of a block is derived from the size argument of
+ * 'free', the allocator requires the size of each block to be free'd.
+ *
+ * A cache is assigned to a thread on its first use. Before a thread exits,
+ * it calls 'release' to hand the blocks of its cache back to the heap and to
+ * make the cache available to other threads. Alternatively, the thread that
+ * joins an exited thread may release the cache on its behalf. If more than
+ * 'MAX_THREADS' threads use the allocator at a time, the surplus threads use
+ * the heap directly.
+ */
+class Genode::Cached_heap : public Allocator
+{
+	public:
+
+		enum {
+			MIN_CLASS_LOG2 = 4,    /* 16 bytes   */
+			MAX_CLASS_LOG2 = 10,   /* 1024 bytes */
+			NUM_CLASSES    = MAX_CLASS_LOG2 - MIN_CLASS_LOG2 + 1,
+			MAGAZINE_SIZE  = 16,
+			BATCH          = MAGAZINE_SIZE / 2,
+			MAX_THREADS    = 32,
+		};
+
+	private:
+
+		/*
+		 * Owner values of caches not assigned to a thread
+		 *
+		 * Thread keys are odd, so they never clash with these values. A
+		 * cache that was never assigned terminates the probing sequence of
+		 * a lookup. A released cache does not, because caches of other
+		 * threads may follow it in their probing sequence.
+		 */
+		enum { UNUSED = 0, RELEASED = 2 };
+
+		struct Magazine
+		{
+			unsigned  count;
+			void     *blocks[MAGAZINE_SIZE];
+		};
+
+		struct Cache
+		{
+			addr_t volatile owner;
+			unsigned long   hits;
+			Magazine        magazines[NUM_CLASSES];
+		};
+
+		Heap  &_heap;
+		Cache  _caches[MAX_THREADS];
+
+		/**
+		 * Return size class of block, or -1 if the block is not cached
+		 */
+		static int _size_class(size_t size)
+		{
+			if (size > (1UL << MAX_CLASS_LOG2))
+				return -1;
+
+			int c = 0;
+			while ((1UL << (c + MIN_CLASS_LOG2)) < size)
+				c++;
+
+			return c;
+		}
+
+		static size_t _class_size(int c) { return 1UL << (c + MIN_CLASS_LOG2); }
+
+		/**
+		 * Return key of thread, the main thread has no 'Thread_base' object
+		 */
+		static addr_t _key(Thread_base *thread) { return (addr_t)thread | 1; }
+
+		/**
+		 * Return cache of thread
+		 *
+		 * \param assign  assign a free cache if the thread has none
+		 * \return        0 if the thread has no cache
+		 *
+		 * Only the owner of a cache or a thread releasing the cache of an
+		 * exited thread change the owner of an assigned cache. Caches never
+		 * become 'UNUSED' again. Hence, the lookup of a thread's own cache
+		 * is stable.
+		 */
+		Cache *_cache(addr_t key, bool assign)
+		{
+			unsigned const start = (key >> 6) % MAX_THREADS;
+
+			for (;;) {
+				Cache *free = 0;
+				addr_t free_owner = UNUSED;
+
+				for (unsigned i = 0; i < MAX_THREADS; i++) {
+
+					Cache &cache = _caches[(start + i) % MAX_THREADS];
+					addr_t const owner = cache.owner;
+
+					if (owner == key)
+						return &cache;
+
+					if (!free && (owner == UNUSED || owner == RELEASED)) {
+						free       = &cache;
+						free_owner = owner;
+					}
+
+					if (owner == UNUSED)
+						break;
+				}
+
+				if (!assign || !free)
+					return 0;
+
+				if (__sync_bool_compare_and_swap(&free->owner, free_owner, key))
+					return free;
+
+				/* another thread took the cache, look up again */
+			}
+		}
+
+		Cache *_cache() { return _cache(_key(Thread_base::myself()), true); }
+
+		/**
+		 * Return oldest 'count' blocks of magazine to the heap
+		 */
+		void _flush(Magazine &magazine, int c, unsigned count)
+		{
+			_heap.free_batch(magazine.blocks, _class_size(c), count);
+
+			magazine.count -= count;
+			memmove(magazine.blocks, magazine.blocks + count,
+			        magazine.count*sizeof(void *));
+		}
+
+		void _flush(Cache &cache)
+		{
+			for (int c = 0; c < NUM_CLASSES; c++) {
+				Magazine &magazine = cache.magazines[c];
+				_flush(magazine, c, magazine.count);
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param heap  heap used as backing store
+		 */
+		Cached_heap(Heap &heap) : _heap(heap)
+		{
+			memset(_caches, 0, sizeof(_caches));
+		}
+
+		/**
+		 * Destructor
+		 *
+		 * Must not be called while other threads use the allocator.
+		 */
+		~Cached_heap()
+		{
+			for (unsigned i = 0; i < MAX_THREADS; i++)
+				_flush(_caches[i]);
+		}
+
+		/**
+		 * Return all blocks cached for the calling thread to the heap
+		 */
+		void flush()
+		{
+			if (Cache *cache = _cache(_key(Thread_base::myself()), false))
+				_flush(*cache);
+		}
+
+		/**
+		 * Return the blocks of a thread's cache and free the cache
+		 *
+		 * \param thread  thread that owns the cache, 0 for the main thread
+		 *
+		 * A thread calls this function for itself before it exits. For
+		 * another thread, the function must be called only after the
+		 * thread has exited.
+		 */
+		void release(Thread_base *thread)
+		{
+			addr_t const key = _key(thread);
+
+			Cache *cache = _cache(key, false);
+			if (!cache)
+				return;
+
+			_flush(*cache);
+			cache->hits = 0;
+
+			__sync_bool_compare_and_swap(&cache->owner, key, (addr_t)RELEASED);
+		}
+
+		/**
+		 * Release the cache of the calling thread
+		 */
+		void release() { release(Thread_base::myself()); }
+
+		/**
+		 * Return number of allocations served by the calling thread's cache
+		 */
+		unsigned long hits()
+		{
+			Cache *cache = _cache(_key(Thread_base::myself()), false);
+			return cache ? cache->hits : 0;
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr)
+		{
+			int const c = _size_class(size);
+			if (c < 0)
+				return _heap.alloc(size, out_addr);
+
+			Cache *cache = _cache();
+			if (!cache)
+				return _heap.alloc(_class_size(c), out_addr);
+
+			Magazine &magazine = cache->magazines[c];
+
+			if (magazine.count) {
+				cache->hits++;
+			} else {
+				magazine.count = _heap.alloc_batch(_class_size(c),
+				                                   magazine.blocks, BATCH);
+				if (!magazine.count)
+					return false;
+			}
+
+			*out_addr = magazine.blocks[--magazine.count];
+			return true;
+		}
+
+		void free(void *addr, size_t size)
+		{
+			int const c = _size_class(size);
+			if (c < 0) {
+				_heap.free(addr, size);
+				return;
+			}
+
+			Cache *cache = _cache();
+			if (!cache) {
+				_heap.free(addr, _class_size(c));
+				return;
+			}
+
+			Magazine &magazine = cache->magazines[c];
+
+			if (magazine.count == MAGAZINE_SIZE)
+				_flush(magazine, c, BATCH);
+
+			magazine.blocks[magazine.count++] = addr;
+		}
+
+		/**
+		 * Return consumed heap quota, including the blocks held in caches
+		 */
+		size_t consumed() { return _heap.consumed(); }
+
+		size_t overhead(size_t size)
+		{
+			int const c = _size_class(size);
+			if (c < 0)
+				return _heap.overhead(size);
+
+			return _heap.overhead(_class_size(c)) + _class_size(c) - size;
+		}
+
+		bool need_size_for_free() const override { return true; }
+};
+
+#endif /* _INCLUDE__BASE__CACHED_HEAP_H_ */
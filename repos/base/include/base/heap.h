@@ -101,6 +101,22 @@ namespace Genode {
 			size_t         _quota_used;
 			size_t         _chunk_size;
 
+			/*
+			 * Lock statistics
+			 *
+			 * '_users' counts the threads that hold or wait for '_lock'
+			 * and is updated atomically. The other counters are updated
+			 * while holding '_lock'.
+			 */
+			int volatile   _users;
+			unsigned long  _acquisitions;
+			unsigned long  _contentions;
+
+			/**
+			 * Guard for '_lock' that accounts contended acquisitions
+			 */
+			class Lock_guard;
+
 			/**
 			 * Try to allocate block at our local allocator
 			 *
@@ -111,10 +127,28 @@ namespace Genode {
 			 */
 			bool _try_local_alloc(size_t size, void **out_addr);
 
+			/**
+			 * Allocate block, '_lock' must be held by the caller
+			 */
+			bool _unsynchronized_alloc(size_t size, void **out_addr);
+
 		public:
 
 			enum { UNLIMITED = ~0 };
 
+			/**
+			 * Lock statistics
+			 *
+			 * 'contentions' counts the acquisitions of the heap lock that
+			 * had to wait for another thread. Each contended acquisition
+			 * is reported as 'Trace::Heap_stats' event.
+			 */
+			struct Stats
+			{
+				unsigned long acquisitions;
+				unsigned long contentions;
+			};
+
 			Heap(Ram_session *ram_session,
 			     Rm_session  *rm_session,
 			     size_t       quota_limit = UNLIMITED,
@@ -124,7 +158,8 @@ namespace Genode {
 				_ds_pool(ram_session, rm_session),
 				_alloc(0),
 				_quota_limit(quota_limit), _quota_used(0),
-				_chunk_size(MIN_CHUNK_SIZE)
+				_chunk_size(MIN_CHUNK_SIZE),
+				_users(0), _acquisitions(0), _contentions(0)
 			{
 				if (static_addr)
 					_alloc.add_range((addr_t)static_addr, static_size);
@@ -144,6 +179,37 @@ namespace Genode {
 			void reassign_resources(Ram_session *ram, Rm_session *rm) {
 				_ds_pool.reassign_resources(ram, rm); }
 
+			/**
+			 * Return lock statistics
+			 *
+			 * The values are read without synchronization and are thereby
+			 * meant for diagnostic purposes only.
+			 */
+			Stats stats() const
+			{
+				Stats const stats = { _acquisitions, _contentions };
+				return stats;
+			}
+
+			/**
+			 * Allocate multiple blocks of the same size at once
+			 *
+			 * \param size   size of each block
+			 * \param out    array to store the block addresses
+			 * \param count  number of blocks to allocate
+			 * \return       number of allocated blocks, which may be lower
+			 *               than 'count' if the quota is exhausted
+			 *
+			 * In contrast to calling 'alloc' repeatedly, the heap lock is
+			 * acquired only once.
+			 */
+			size_t alloc_batch(size_t size, void **out, size_t count);
+
+			/**
+			 * Free multiple blocks of the same size at once
+			 */
+			void free_batch(void * const *addrs, size_t size, size_t count);
+
 
 			/*************************
 			 ** Allocator interface **
@@ -28,6 +28,13 @@ namespace Genode {
 	 *
 	 * The local names of a capabilities are used to differentiate multiple server
 	 * objects managed by one and the same object pool.
+	 *
+	 * The objects are distributed over a number of buckets by their ids, each
+	 * bucket being an AVL tree with its own lock. By default, a pool has a
+	 * single bucket. A pool that is accessed by many threads concurrently,
+	 * e.g., the pool of a multi-threaded server, should be instantiated as
+	 * 'Bucketed_object_pool' instead. Then, concurrent lookups of different
+	 * objects rarely contend for the same lock.
 	 */
 	template <typename OBJ_TYPE>
 	class Object_pool
@@ -128,30 +135,81 @@ namespace Genode {
 					void acquire() { lock(); add_ref();   }
 			};
 
+		protected:
+
+			/**
+			 * Part of the pool holding the objects of a subset of ids
+			 *
+			 * Each bucket is protected by a lock of its own. Hence, the
+			 * lookups of objects residing in different buckets do not
+			 * serialize each other.
+			 */
+			struct Bucket
+			{
+				Avl_tree<Entry> tree;
+				Lock            lock;
+			};
+
 		private:
 
-			Avl_tree<Entry> _tree;
-			Lock            _lock;
+			Bucket         _default_bucket;
+			Bucket * const _buckets;
+			unsigned const _buckets_log2;
+
+			unsigned _num_buckets() const { return 1U << _buckets_log2; }
+
+			/**
+			 * Return bucket responsible for the specified object id
+			 *
+			 * Ids are typically allocated in sequence. The multiplicative
+			 * hash spreads such ids evenly over all buckets.
+			 */
+			Bucket &_bucket(unsigned long obj_id)
+			{
+				unsigned long const folded = obj_id ^ ((obj_id >> 16) >> 16);
+				unsigned      const hash   = (unsigned)folded * 2654435761U;
+
+				return _buckets[(hash >> (31 - _buckets_log2)) >> 1];
+			}
+
+			Bucket &_bucket(Entry *obj) { return _bucket(obj->_obj_id()); }
+
+		protected:
+
+			/**
+			 * Constructor used by 'Bucketed_object_pool'
+			 *
+			 * \param buckets       array of '1 << buckets_log2' buckets
+			 * \param buckets_log2  number of buckets as power of two
+			 */
+			Object_pool(Bucket *buckets, unsigned buckets_log2)
+			: _buckets(buckets), _buckets_log2(buckets_log2) { }
 
 		public:
 
+			Object_pool() : _buckets(&_default_bucket), _buckets_log2(0) { }
+
 			void insert(OBJ_TYPE *obj)
 			{
-				Lock::Guard lock_guard(_lock);
-				_tree.insert(obj);
+				Bucket &bucket = _bucket(obj);
+
+				Lock::Guard lock_guard(bucket.lock);
+				bucket.tree.insert(obj);
 			}
 
 			void remove_locked(OBJ_TYPE *obj)
 			{
+				Bucket &bucket = _bucket(obj);
+
 				obj->is_dead(true);
 				obj->del_ref();
 
 				while (true) {
 					obj->unlock();
 					{
-						Lock::Guard lock_guard(_lock);
+						Lock::Guard lock_guard(bucket.lock);
 						if (obj->is_ref_zero()) {
-							_tree.remove(obj);
+							bucket.tree.remove(obj);
 							return;
 						}
 					}
@@ -164,10 +222,12 @@ namespace Genode {
 			 */
 			OBJ_TYPE *lookup_and_lock(addr_t obj_id)
 			{
+				Bucket &bucket = _bucket(obj_id);
+
 				OBJ_TYPE * obj_typed;
 				{
-					Lock::Guard lock_guard(_lock);
-					Entry *obj = _tree.first();
+					Lock::Guard lock_guard(bucket.lock);
+					Entry *obj = bucket.tree.first();
 					if (!obj) return 0;
 
 					obj_typed = (OBJ_TYPE *)obj->find_by_obj_id(obj_id);
@@ -187,30 +247,60 @@ namespace Genode {
 			}
 
 			/**
-			 * Return first element of tree
+			 * Return first element of pool
 			 *
-			 * This function is used for removing tree elements step by step.
+			 * This function is used for removing pool elements step by step.
 			 */
 			OBJ_TYPE *first()
 			{
-				Lock::Guard lock_guard(_lock);
-				return (OBJ_TYPE *)_tree.first();
+				for (unsigned i = 0; i < _num_buckets(); i++) {
+					Lock::Guard lock_guard(_buckets[i].lock);
+					Entry * const obj = _buckets[i].tree.first();
+					if (obj) return (OBJ_TYPE *)obj;
+				}
+				return 0;
 			}
 
 			/**
-			 * Return first element of tree locked
+			 * Return first element of pool locked
 			 *
-			 * This function is used for removing tree elements step by step.
+			 * This function is used for removing pool elements step by step.
 			 */
 			OBJ_TYPE *first_locked()
 			{
-				Lock::Guard lock_guard(_lock);
-				OBJ_TYPE * const obj_typed = (OBJ_TYPE *)_tree.first();
-				if (!obj_typed) { return 0; }
-				obj_typed->lock();
-				return obj_typed;
+				for (unsigned i = 0; i < _num_buckets(); i++) {
+					Lock::Guard lock_guard(_buckets[i].lock);
+					OBJ_TYPE * const obj_typed = (OBJ_TYPE *)_buckets[i].tree.first();
+					if (!obj_typed) continue;
+					obj_typed->lock();
+					return obj_typed;
+				}
+				return 0;
 			}
 	};
+
+
+	/**
+	 * Object pool with '1 << BUCKETS_LOG2' buckets
+	 *
+	 * Each bucket costs an AVL tree and a lock. Hence, only pools that are
+	 * looked up by several threads in parallel should use more than the
+	 * single bucket of a plain 'Object_pool'.
+	 */
+	template <typename OBJ_TYPE, unsigned BUCKETS_LOG2>
+	class Bucketed_object_pool : public Object_pool<OBJ_TYPE>
+	{
+		private:
+
+			typedef typename Object_pool<OBJ_TYPE>::Bucket Bucket;
+
+			Bucket _buckets[1 << BUCKETS_LOG2];
+
+		public:
+
+			Bucketed_object_pool()
+			: Object_pool<OBJ_TYPE>(_buckets, BUCKETS_LOG2) { }
+	};
 }
 
 #endif /* _INCLUDE__BASE__OBJECT_POOL_H_ */
@@ -0,0 +1,220 @@
+/*
+ * \brief  Group of RPC entrypoints sharing one object pool
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__BASE__RPC_ENTRYPOINT_GROUP_H_
+#define _INCLUDE__BASE__RPC_ENTRYPOINT_GROUP_H_
+
+#include <base/rpc_server.h>
+#include <base/env.h>
+#include <base/snprintf.h>
+#include <util/construct_at.h>
+
+namespace Genode { class Rpc_entrypoint_group; }
+
+
+/**
+ * Group of RPC entrypoints serving RPC objects in parallel
+ *
+ * Each entrypoint of the group is executed by a thread of its own. The
+ * threads are distributed over the CPUs of the component's affinity space.
+ * The capability of an RPC object refers to the entrypoint that manages
+ * the object. Hence, all requests for one object are handled by the same
+ * thread, one at a time. Requests for objects managed by different
+ * entrypoints are handled in parallel.
+ *
+ * All entrypoints of the group share one object pool. So any entrypoint of
+ * the group is able to look up and to dissolve any object of the group,
+ * e.g., if the capability of an object is passed as RPC argument to an
+ * object managed by another entrypoint.
+ *
+ * The granularity of serialization is determined by the placement of the
+ * RPC objects:
+ *
+ * :Per session: A root component selects one entrypoint per session and
+ *   manages all objects of the session at this entrypoint. The
+ *   'Root_component' does so when constructed with a group.
+ *
+ * :Per object: Each object is managed via 'manage', which distributes the
+ *   objects over the entrypoints. The objects of one session may then be
+ *   invoked concurrently.
+ */
+class Genode::Rpc_entrypoint_group
+{
+	public:
+
+		enum { MAX_ENTRYPOINTS = 16 };
+
+		class Invalid_entrypoint_count : public Exception { };
+
+	private:
+
+		/*
+		 * The pool is looked up by all entrypoints of the group in
+		 * parallel. So it is worth spending a few buckets on it.
+		 */
+		enum { POOL_BUCKETS_LOG2 = 5 };
+
+		Bucketed_object_pool<Rpc_object_base, POOL_BUCKETS_LOG2> _pool;
+
+		Cap_session    *_cap_session;
+		unsigned const  _count;
+		Rpc_entrypoint *_eps[MAX_ENTRYPOINTS];
+		unsigned        _next;
+		Lock            _next_lock;
+
+		friend class Rpc_entrypoint;
+
+		static unsigned _checked(unsigned count)
+		{
+			if (!count || count > MAX_ENTRYPOINTS)
+				throw Invalid_entrypoint_count();
+
+			return count;
+		}
+
+		void _leave_server_object(Rpc_object_base *obj)
+		{
+			for (unsigned i = 0; i < _count; i++)
+				if (_eps[i])
+					_eps[i]->_leave_server_object(obj);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param cap_session  'Cap_session' for creating capabilities
+		 *                     for the RPC objects managed by the group
+		 * \param stack_size   stack size of each entrypoint thread
+		 * \param name         name prefix of the entrypoint threads
+		 * \param count        number of entrypoints
+		 * \param space        affinity space to distribute the entrypoint
+		 *                     threads over
+		 *
+		 * \throw Invalid_entrypoint_count
+		 */
+		Rpc_entrypoint_group(Cap_session *cap_session, size_t stack_size,
+		                     char const *name, unsigned count,
+		                     Affinity::Space space =
+		                         env()->cpu_session()->affinity_space())
+		:
+			_cap_session(cap_session), _count(_checked(count)), _next(0)
+		{
+			for (unsigned i = 0; i < MAX_ENTRYPOINTS; i++)
+				_eps[i] = 0;
+
+			for (unsigned i = 0; i < _count; i++) {
+
+				char ep_name[32];
+				snprintf(ep_name, sizeof(ep_name), "%s.%u", name, i);
+
+				Affinity::Location const location = space.total()
+				                                  ? space.location_of_index(i)
+				                                  : Affinity::Location();
+
+				_eps[i] = new (env()->heap())
+					Rpc_entrypoint(cap_session, stack_size, ep_name, true,
+					               location, this);
+			}
+		}
+
+		~Rpc_entrypoint_group()
+		{
+			for (unsigned i = 0; i < _count; i++) {
+				destroy(env()->heap(), _eps[i]);
+				_eps[i] = 0;
+			}
+
+			if (_pool.first()) {
+				PWRN("Object pool not empty in %s", __func__);
+
+				/* dissolve all objects - objects are not destroyed! */
+				while (Rpc_object_base *obj = _pool.first()) {
+					_pool.remove_locked(obj);
+					_cap_session->free(obj->cap());
+				}
+			}
+		}
+
+		/**
+		 * Return number of entrypoints
+		 */
+		unsigned count() const { return _count; }
+
+		/**
+		 * Return entrypoint of the specified index
+		 */
+		Rpc_entrypoint &ep(unsigned i) { return *_eps[i % _count]; }
+
+		/**
+		 * Select entrypoint for serving a new session or object
+		 *
+		 * The entrypoints are selected round-robin.
+		 */
+		Rpc_entrypoint &select()
+		{
+			Lock::Guard lock_guard(_next_lock);
+
+			Rpc_entrypoint &ep = *_eps[_next];
+			_next = (_next + 1) % _count;
+			return ep;
+		}
+
+		/**
+		 * Associate RPC object with an entrypoint of the group
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		Capability<RPC_INTERFACE>
+		manage(Rpc_object<RPC_INTERFACE, RPC_SERVER> *obj)
+		{
+			return select().manage(obj);
+		}
+
+		/**
+		 * Dissolve RPC object from the group
+		 */
+		template <typename RPC_INTERFACE, typename RPC_SERVER>
+		void dissolve(Rpc_object<RPC_INTERFACE, RPC_SERVER> *obj)
+		{
+			_eps[0]->dissolve(obj);
+		}
+
+		/**
+		 * Look up RPC object managed by any entrypoint of the group
+		 */
+		Rpc_object_base *lookup_and_lock(Untyped_capability cap) {
+			return _pool.lookup_and_lock(cap); }
+};
+
+
+inline Genode::Object_pool<Genode::Rpc_object_base> &
+Genode::Rpc_entrypoint::_init_pool(Rpc_entrypoint_group *group)
+{
+	if (group)
+		return group->_pool;
+
+	return *construct_at<Pool>(_own_pool);
+}
+
+
+inline void
+Genode::Rpc_entrypoint::_leave_server_object_in_group(Rpc_object_base *obj)
+{
+	if (_group)
+		_group->_leave_server_object(obj);
+	else
+		_leave_server_object(obj);
+}
+
+#endif /* _INCLUDE__BASE__RPC_ENTRYPOINT_GROUP_H_ */
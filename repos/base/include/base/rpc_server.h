@@ -187,6 +187,9 @@ namespace Genode {
 	};
 
 
+	class Rpc_entrypoint_group;
+
+
 	class Rpc_object_base : public Object_pool<Rpc_object_base>::Entry
 	{
 		public:
@@ -242,16 +245,52 @@ namespace Genode {
 	 * shortcut for the common case where the server's capability is handed
 	 * over to other parties _after_ the server is completely initialized.
 	 */
-	class Rpc_entrypoint : Thread_base, public Object_pool<Rpc_object_base>
+	class Rpc_entrypoint : Thread_base
 	{
 		private:
 
+			typedef Object_pool<Rpc_object_base> Pool;
+
 			/**
 			 * Prototype capability to derive capabilities for RPC objects
 			 * from.
 			 */
 			Untyped_capability _cap;
 
+			/**
+			 * Group the entrypoint belongs to, or 0
+			 */
+			Rpc_entrypoint_group * const _group;
+
+			/**
+			 * Backing store of the entrypoint's own pool
+			 *
+			 * The pool is constructed only if the entrypoint is not a member
+			 * of a group.
+			 */
+			char _own_pool[sizeof(Pool)] __attribute__((aligned));
+
+			/**
+			 * Pool of the RPC objects served by the entrypoint
+			 *
+			 * This is the entrypoint's own pool unless the entrypoint is
+			 * a member of a group. In this case, it is the pool shared by
+			 * all entrypoints of the group.
+			 */
+			Pool &_pool;
+
+			/**
+			 * Return pool to be used by an entrypoint of the given group
+			 */
+			Pool &_init_pool(Rpc_entrypoint_group *group);
+
+			/**
+			 * Destruct the entrypoint's own pool
+			 */
+			void _deinit_pool() { if (!_group) _pool.~Pool(); }
+
+			friend class Rpc_entrypoint_group;
+
 			enum { SND_BUF_SIZE = 1024, RCV_BUF_SIZE = 1024 };
 			Msgbuf<SND_BUF_SIZE> _snd_buf;
 			Msgbuf<RCV_BUF_SIZE> _rcv_buf;
@@ -305,6 +344,15 @@ namespace Genode {
 			 */
 			void _leave_server_object(Rpc_object_base *obj);
 
+			/**
+			 * Force all activations that may dispatch the specified server
+			 * object to cancel dispatching it
+			 *
+			 * An object of a shared pool may have been managed by any
+			 * entrypoint of the group.
+			 */
+			void _leave_server_object_in_group(Rpc_object_base *obj);
+
 			/**
 			 * Wait until the entrypoint activation is initialized
 			 */
@@ -326,13 +374,37 @@ namespace Genode {
 			 * \param stack_size   stack size of entrypoint thread
 			 * \param name         name of entrypoint thread
 			 * \param location     CPU affinity
+			 * \param group        group sharing its object pool with the
+			 *                     entrypoint, used by 'Rpc_entrypoint_group'
 			 */
 			Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
 			               char const *name, bool start_on_construction = true,
-			               Affinity::Location location = Affinity::Location());
+			               Affinity::Location location = Affinity::Location(),
+			               Rpc_entrypoint_group *group = 0);
 
 			~Rpc_entrypoint();
 
+			/*
+			 * Object-pool functions
+			 *
+			 * These functions operate on the pool shared by all entrypoints
+			 * of a group, or on the entrypoint's own pool.
+			 */
+
+			void insert(Rpc_object_base *obj) { _pool.insert(obj); }
+
+			void remove_locked(Rpc_object_base *obj) { _pool.remove_locked(obj); }
+
+			Rpc_object_base *lookup_and_lock(addr_t obj_id) {
+				return _pool.lookup_and_lock(obj_id); }
+
+			Rpc_object_base *lookup_and_lock(Untyped_capability cap) {
+				return _pool.lookup_and_lock(cap); }
+
+			Rpc_object_base *first() { return _pool.first(); }
+
+			Rpc_object_base *first_locked() { return _pool.first_locked(); }
+
 			/**
 			 * Associate RPC object with the entry point
 			 */
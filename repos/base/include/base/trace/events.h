@@ -24,6 +24,7 @@ namespace Genode { namespace Trace {
 	struct Rpc_reply;
 	struct Signal_submit;
 	struct Signal_received;
+	struct Heap_stats;
 } }
 
 
@@ -120,4 +121,24 @@ struct Genode::Trace::Signal_received
 };
 
 
+struct Genode::Trace::Heap_stats
+{
+	unsigned long const acquisitions;
+	unsigned long const contentions;
+	unsigned long const quota_used;
+
+	Heap_stats(unsigned long acquisitions, unsigned long contentions,
+	           unsigned long quota_used)
+	:
+		acquisitions(acquisitions), contentions(contentions),
+		quota_used(quota_used)
+	{
+		Thread_base::trace(this);
+	}
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.heap_stats(dst, acquisitions, contentions, quota_used); }
+};
+
+
 #endif /* _INCLUDE__BASE__TRACE__EVENTS_H_ */
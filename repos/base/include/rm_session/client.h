@@ -27,11 +27,12 @@ namespace Genode {
 		Local_addr attach(Dataspace_capability ds, size_t size = 0,
 		                  off_t offset = 0, bool use_local_addr = false,
 		                  Local_addr local_addr = (void *)0,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool writeable = true)
 		{
 			return call<Rpc_attach>(ds, size, offset,
 			                        use_local_addr, local_addr,
-			                        executable);
+			                        executable, writeable);
 		}
 
 		void detach(Local_addr local_addr) {
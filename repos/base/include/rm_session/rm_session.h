@@ -118,6 +118,11 @@ namespace Genode {
 		 *                         the specified 'local_addr'
 		 * \param local_addr       local destination address
 		 * \param executable       if the mapping should be executable
+		 * \param writeable        if false, the region is mapped read-only
+		 *                         even if the dataspace is writeable, and
+		 *                         write accesses are reflected as
+		 *                         'WRITE_FAULT' to the fault handler of the
+		 *                         RM session
 		 *
 		 * \throw Attach_failed    if dataspace or offset is invalid,
 		 *                         or on region conflict
@@ -130,7 +135,8 @@ namespace Genode {
 		                          size_t size = 0, off_t offset = 0,
 		                          bool use_local_addr = false,
 		                          Local_addr local_addr = (void *)0,
-		                          bool executable = false) = 0;
+		                          bool executable = false,
+		                          bool writeable = true) = 0;
 
 		/**
 		 * Shortcut for attaching a dataspace at a predefined local address
@@ -201,7 +207,8 @@ namespace Genode {
 		GENODE_RPC_THROW(Rpc_attach, Local_addr, attach,
 		                 GENODE_TYPE_LIST(Invalid_dataspace, Region_conflict,
 		                                  Out_of_metadata, Invalid_args),
-		                 Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
+		                 Dataspace_capability, size_t, off_t, bool, Local_addr,
+		                 bool, bool);
 		GENODE_RPC(Rpc_detach, void, detach, Local_addr);
 		GENODE_RPC_THROW(Rpc_add_client, Pager_capability, add_client,
 		                 GENODE_TYPE_LIST(Invalid_thread, Out_of_metadata),
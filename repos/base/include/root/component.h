@@ -19,6 +19,7 @@
 
 #include <root/root.h>
 #include <base/rpc_server.h>
+#include <base/rpc_entrypoint_group.h>
 #include <base/heap.h>
 #include <ram_session/ram_session.h>
 #include <util/arg_string.h>
@@ -95,8 +96,20 @@ namespace Genode {
 			/*
 			 * Entry point that manages the session objects
 			 * created by this root interface
+			 *
+			 * If the sessions are served by a group, this is the first
+			 * entry point of the group. It is used to look up and dissolve
+			 * the sessions, which works for all entry points of the group.
+			 */
+			Rpc_entrypoint * const _ep;
+
+			/*
+			 * Group of entry points serving the sessions, or 0
+			 *
+			 * If a group is specified, an entry point of the group is
+			 * selected for each new session.
 			 */
-			Rpc_entrypoint *_ep;
+			Rpc_entrypoint_group * const _ep_group;
 
 			/*
 			 * Allocator for allocating session objects.
@@ -124,11 +137,23 @@ namespace Genode {
 			 * affinity, it suffices to override the overload without the
 			 * affinity argument.
 			 *
+			 * The entry-point argument refers to the entry point that will
+			 * manage the session. A session served by an entry-point group
+			 * should manage its further RPC objects at this entry point
+			 * to serialize all requests of the session.
+			 *
 			 * \throw Allocator::Out_of_memory  typically caused by the
 			 *                                  meta-data allocator
 			 * \throw Root::Invalid_args        typically caused by the
 			 *                                  session-component constructor
 			 */
+			virtual SESSION_TYPE *_create_session(const char *args,
+			                                      Affinity const &affinity,
+			                                      Rpc_entrypoint &)
+			{
+				return _create_session(args, affinity);
+			}
+
 			virtual SESSION_TYPE *_create_session(const char *args,
 			                                      Affinity const &)
 			{
@@ -181,7 +206,21 @@ namespace Genode {
 			 *                     of session objects and session data
 			 */
 			Root_component(Rpc_entrypoint *ep, Allocator *metadata_alloc)
-			: _ep(ep), _md_alloc(metadata_alloc) { }
+			: _ep(ep), _ep_group(0), _md_alloc(metadata_alloc) { }
+
+			/**
+			 * Constructor
+			 *
+			 * \param ep_group     group of entry points that serve the
+			 *                     sessions of this root interface
+			 * \param ram_session  provider of dataspaces for the backing store
+			 *                     of session objects and session data
+			 *
+			 * Each session is served by one entry point of the group. The
+			 * entry point is passed to '_create_session'.
+			 */
+			Root_component(Rpc_entrypoint_group *ep_group, Allocator *metadata_alloc)
+			: _ep(&ep_group->ep(0)), _ep_group(ep_group), _md_alloc(metadata_alloc) { }
 
 
 			/********************
@@ -226,11 +265,18 @@ namespace Genode {
 				Arg_string::set_arg(adjusted_args, sizeof(adjusted_args),
 				                    "ram_quota", ram_quota_buf);
 
+				/*
+				 * The entry points of a group share one object pool. Hence,
+				 * '_ep' can be used to look up or dissolve the session later
+				 * on, regardless of the entry point that manages it.
+				 */
+				Rpc_entrypoint &ep = _ep_group ? _ep_group->select() : *_ep;
+
 				SESSION_TYPE *s = 0;
-				try { s = _create_session(adjusted_args, affinity); }
+				try { s = _create_session(adjusted_args, affinity, ep); }
 				catch (Allocator::Out_of_memory) { throw Root::Quota_exceeded(); }
 
-				return _ep->manage(s);
+				return ep.manage(s);
 			}
 
 			void upgrade(Session_capability session, Root::Upgrade_args const &args)
@@ -99,6 +99,103 @@ void Allocator_avl_base::Block::recompute()
  ** Allocator_avl implementation **
  **********************************/
 
+/**
+ * Return log2 size class of a free block of 'size' bytes (size > 0)
+ */
+static inline unsigned size_class(size_t size)
+{
+	return 8*sizeof(unsigned long) - 1 - __builtin_clzl(size);
+}
+
+
+void Allocator_avl_base::_enqueue_free(Block *b)
+{
+	unsigned const c = size_class(b->size());
+
+	b->_free_prev = 0;
+	b->_free_next = _free_lists[c];
+
+	if (_free_lists[c])
+		_free_lists[c]->_free_prev = b;
+
+	_free_lists[c]  = b;
+	_free_classes  |= 1UL << c;
+}
+
+
+void Allocator_avl_base::_dequeue_free(Block *b)
+{
+	unsigned const c = size_class(b->size());
+
+	if (b->_free_prev)
+		b->_free_prev->_free_next = b->_free_next;
+	else
+		_free_lists[c] = b->_free_next;
+
+	if (b->_free_next)
+		b->_free_next->_free_prev = b->_free_prev;
+
+	b->_free_prev = b->_free_next = 0;
+
+	if (!_free_lists[c])
+		_free_classes &= ~(1UL << c);
+}
+
+
+Allocator_avl_base::Block *
+Allocator_avl_base::_find_free(size_t size, unsigned align)
+{
+	/* leave corner cases to the exhaustive search */
+	if (!size || align >= 8*sizeof(size_t)) {
+		Block *b = _addr_tree.first();
+		return b ? b->find_best_fit(size, align) : 0;
+	}
+
+	/*
+	 * Any block of at least 'guaranteed' bytes can hold the block
+	 * regardless of its alignment.
+	 */
+	size_t const padding    = (1UL << align) - 1;
+	size_t const guaranteed = size + padding;
+	bool   const overflow   = guaranteed < size;
+
+	unsigned const first = size_class(size);
+	unsigned const guaranteed_class = overflow ? NUM_SIZE_CLASSES
+	                                           : size_class(guaranteed) + 1;
+
+	/*
+	 * Look for the best fit among the smaller classes. Their blocks may
+	 * be too small or may not satisfy the alignment. Prefer blocks of the
+	 * lowest class and limit the number of inspected blocks per class.
+	 */
+	for (unsigned c = first; c < guaranteed_class && c < NUM_SIZE_CLASSES; c++) {
+
+		if (!(_free_classes & (1UL << c)))
+			continue;
+
+		Block   *best = 0;
+		unsigned scanned = 0;
+		for (Block *b = _free_lists[c]; b && scanned < MAX_BEST_FIT_SCAN;
+		     b = b->_free_next, scanned++)
+			if (b->fits(size, align) && (!best || b->size() < best->size()))
+				best = b;
+
+		if (best)
+			return best;
+	}
+
+	/* take any block of the lowest class that fits in any case */
+	if (guaranteed_class < NUM_SIZE_CLASSES) {
+		unsigned long const candidates = _free_classes & (~0UL << guaranteed_class);
+		if (candidates)
+			return _free_lists[__builtin_ctzl(candidates)];
+	}
+
+	/* exhaustive search for blocks missed by the limited scan */
+	Block *b = _addr_tree.first();
+	return b ? b->find_best_fit(size, align) : 0;
+}
+
 Allocator_avl_base::Block *Allocator_avl_base::_alloc_block_metadata()
 {
 	void *b = 0;
@@ -135,6 +232,9 @@ int Allocator_avl_base::_add_block(Block *block_metadata,
 	/* insert block into avl tree */
 	_addr_tree.insert(block_metadata);
 
+	if (!used)
+		_enqueue_free(block_metadata);
+
 	return 0;
 }
 
@@ -143,6 +243,9 @@ void Allocator_avl_base::_destroy_block(Block *b)
 {
 	if (!b) return;
 
+	if (!b->used())
+		_dequeue_free(b);
+
 	/* remove block from both avl trees */
 	_addr_tree.remove(b);
 	_md_alloc->free(b, _md_entry_size);
@@ -254,8 +357,7 @@ Range_allocator::Alloc_return Allocator_avl_base::alloc_aligned(size_t size, voi
 		return Alloc_return(Alloc_return::OUT_OF_METADATA);
 
 	/* find best fitting block */
-	Block *b = _addr_tree.first();
-	b = b ? b->find_best_fit(size, align) : 0;
+	Block *b = _find_free(size, align);
 
 	if (!b) {
 		_md_alloc->free(dst1, sizeof(Block));
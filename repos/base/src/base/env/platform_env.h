@@ -45,14 +45,15 @@ struct Genode::Expanding_rm_session_client
 
 	Local_addr attach(Dataspace_capability ds, size_t size, off_t offset,
 	                  bool use_local_addr, Local_addr local_addr,
-	                  bool executable)
+	                  bool executable, bool writeable)
 	{
 		return retry<Rm_session::Out_of_metadata>(
 			[&] () {
 				return Rm_session_client::attach(ds, size, offset,
 				                                 use_local_addr,
 				                                 local_addr,
-				                                 executable); },
+				                                 executable,
+				                                 writeable); },
 			[&] () { upgrade_ram(8*1024); });
 	}
 
@@ -16,6 +16,8 @@
 #include <rm_session/rm_session.h>
 #include <base/heap.h>
 #include <base/lock.h>
+#include <base/trace/events.h>
+#include <cpu/atomic.h>
 
 using namespace Genode;
 
@@ -74,6 +76,56 @@ int Heap::Dataspace_pool::expand(size_t size, Range_allocator *alloc)
 }
 
 
+class Heap::Lock_guard
+{
+	private:
+
+		Heap &_heap;
+
+		bool          _contended;
+		unsigned long _acquisitions;
+		unsigned long _contentions;
+		size_t        _quota_used;
+
+		static int _atomic_add(int volatile *value, int amount)
+		{
+			for (;;) {
+				int const old = *value;
+				if (cmpxchg(value, old, old + amount))
+					return old;
+			}
+		}
+
+	public:
+
+		Lock_guard(Heap &heap)
+		:
+			_heap(heap), _contended(_atomic_add(&heap._users, 1) > 0)
+		{
+			_heap._lock.lock();
+
+			_heap._acquisitions++;
+			if (_contended)
+				_heap._contentions++;
+
+			_acquisitions = _heap._acquisitions;
+			_contentions  = _heap._contentions;
+			_quota_used   = _heap._quota_used;
+		}
+
+		~Lock_guard()
+		{
+			_atomic_add(&_heap._users, -1);
+			_heap._lock.unlock();
+
+			/* report contention without holding the lock */
+			if (_contended)
+				Trace::Heap_stats trace_event(_acquisitions, _contentions,
+				                              _quota_used);
+		}
+};
+
+
 int Heap::quota_limit(size_t new_quota_limit)
 {
 	if (new_quota_limit < _quota_used) return -1;
@@ -92,11 +144,8 @@ bool Heap::_try_local_alloc(size_t size, void **out_addr)
 }
 
 
-bool Heap::alloc(size_t size, void **out_addr)
+bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 {
-	/* serialize access of heap functions */
-	Lock::Guard lock_guard(_lock);
-
 	/* check requested allocation against quota limit */
 	if (size + _quota_used > _quota_limit)
 		return false;
@@ -132,10 +181,43 @@ bool Heap::alloc(size_t size, void **out_addr)
 }
 
 
+bool Heap::alloc(size_t size, void **out_addr)
+{
+	/* serialize access of heap functions */
+	Lock_guard lock_guard(*this);
+
+	return _unsynchronized_alloc(size, out_addr);
+}
+
+
+size_t Heap::alloc_batch(size_t size, void **out, size_t count)
+{
+	Lock_guard lock_guard(*this);
+
+	size_t i = 0;
+	for (; i < count; i++)
+		if (!_unsynchronized_alloc(size, &out[i]))
+			break;
+
+	return i;
+}
+
+
+void Heap::free_batch(void * const *addrs, size_t size, size_t count)
+{
+	Lock_guard lock_guard(*this);
+
+	for (size_t i = 0; i < count; i++)
+		_alloc.free(addrs[i], size);
+
+	_quota_used -= size*count;
+}
+
+
 void Heap::free(void *addr, size_t size)
 {
 	/* serialize access of heap functions */
-	Lock::Guard lock_guard(_lock);
+	Lock_guard lock_guard(*this);
 
 	/* forward request to our local allocator */
 	_alloc.free(addr, size);
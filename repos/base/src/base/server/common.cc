@@ -12,6 +12,7 @@
  */
 
 #include <base/rpc_server.h>
+#include <base/rpc_entrypoint_group.h>
 #include <base/rpc_client.h>
 #include <base/blocking.h>
 #include <base/env.h>
@@ -30,7 +31,7 @@ void Rpc_entrypoint::_dissolve(Rpc_object_base *obj)
 	 * no longer used. Therefore, we to need cancel an eventually blocking
 	 * operation and let the activation leave the context of the object.
 	 */
-	_leave_server_object(obj);
+	_leave_server_object_in_group(obj);
 
 	/* wait until nobody is inside dispatch */
 	obj->acquire();
@@ -100,10 +101,12 @@ bool Rpc_entrypoint::is_myself() const
 
 Rpc_entrypoint::Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
                                char const *name, bool start_on_construction,
-                               Affinity::Location location)
+                               Affinity::Location location,
+                               Rpc_entrypoint_group *group)
 :
 	Thread_base(name, stack_size),
 	_cap(Untyped_capability()),
+	_group(group), _pool(_init_pool(group)),
 	_curr_obj(0), _cap_valid(Lock::LOCKED), _delay_start(Lock::LOCKED),
 	_delay_exit(Lock::LOCKED),
 	_cap_session(cap_session)
@@ -124,8 +127,6 @@ Rpc_entrypoint::Rpc_entrypoint(Cap_session *cap_session, size_t stack_size,
 
 Rpc_entrypoint::~Rpc_entrypoint()
 {
-	typedef Object_pool<Rpc_object_base> Pool;
-
 	/*
 	 * We have to make sure the server loop is running which is only the case
 	 * if the Rpc_entrypoint was actived before we execute the RPC call.
@@ -137,14 +138,17 @@ Rpc_entrypoint::~Rpc_entrypoint()
 
 	dissolve(&_exit_handler);
 
-	if (Pool::first()) {
+	/* the objects of a shared pool are dissolved by the group */
+	if (!_group && first()) {
 		PWRN("Object pool not empty in %s", __func__);
 
 		/* dissolve all objects - objects are not destroyed! */
-		while (Rpc_object_base *obj = Pool::first())
+		while (Rpc_object_base *obj = first())
 			_dissolve(obj);
 	}
 
+	_deinit_pool();
+
 	/*
 	 * Now that we finished the 'dissolve' steps above (which need a working
 	 * 'Ipc_server' in the context of the entrypoint thread), we can allow the
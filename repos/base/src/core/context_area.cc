@@ -52,7 +52,7 @@ class Context_area_rm_session : public Rm_session
 		Local_addr attach(Dataspace_capability ds_cap,
 		                  size_t size, off_t offset,
 		                  bool use_local_addr, Local_addr local_addr,
-		                  bool executable)
+		                  bool executable, bool)
 		{
 			Dataspace_component *ds =
 				dynamic_cast<Dataspace_component*>(Dataspace_capability::deref(ds_cap));
@@ -316,13 +316,17 @@ namespace Genode {
 			/**
 			 * Reversely lookup dataspace and offset matching the specified address
 			 *
+			 * \param writeable  set to false if the matching region is
+			 *                   attached read-only
+			 *
 			 * \return true  lookup succeeded
 			 */
 			bool reverse_lookup(addr_t                 dst_base,
 			                    Fault_area            *dst_fault_region,
 			                    Dataspace_component  **src_dataspace,
 			                    Fault_area            *src_fault_region,
-			                    Rm_session_component **sub_rm_session);
+			                    Rm_session_component **sub_rm_session,
+			                    bool                  *writeable);
 
 			/**
 			 * Register fault
@@ -359,7 +363,7 @@ namespace Genode {
 			 ** Region manager session interface **
 			 **************************************/
 
-			Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool);
+			Local_addr       attach        (Dataspace_capability, size_t, off_t, bool, Local_addr, bool, bool);
 			void             detach        (Local_addr);
 			Pager_capability add_client    (Thread_capability);
 			void             remove_client (Pager_capability);
@@ -181,6 +181,9 @@ int Rm_client::pager(Ipc_pager &pager)
 	Rm_session_component::Fault_area dst_fault_area(pf_addr);
 	bool lookup;
 
+	/* false if any region along the lookup path is attached read-only */
+	bool writeable = true;
+
 	unsigned level;
 	enum { MAX_NESTING_LEVELS = 5 };
 
@@ -204,11 +207,14 @@ int Rm_client::pager(Ipc_pager &pager)
 
 	/* traverse potentially nested dataspaces until we hit a leaf dataspace */
 	for (level = 0; level < MAX_NESTING_LEVELS; level++) {
+		bool region_writeable = true;
 		lookup = curr_rm_session->reverse_lookup(curr_rm_base,
 		                                        &dst_fault_area,
 		                                        &src_dataspace,
 		                                        &src_fault_area,
-		                                        &sub_rm_session);
+		                                        &sub_rm_session,
+		                                        &region_writeable);
+		writeable = writeable && region_writeable;
 		/* check if we need to traverse into a nested dataspace */
 		if (!sub_rm_session)
 			break;
@@ -278,12 +284,25 @@ int Rm_client::pager(Ipc_pager &pager)
 		return 2;
 	}
 
+	/*
+	 * Reflect write accesses to regions attached read-only to the
+	 * region-manager session that hosts the leaf dataspace. The fault
+	 * handler of this session may resolve the fault by attaching a
+	 * writeable dataspace at the fault address, e.g., to implement
+	 * copy-on-write.
+	 */
+	if (pf_type == Rm_session::WRITE_FAULT && !writeable) {
+		curr_rm_session->fault(this, dst_fault_area.fault_addr() - curr_rm_base,
+		                       pf_type);
+		return 2;
+	}
+
 	Mapping mapping(dst_fault_area.base(),
 	                src_fault_area.base(),
 	                src_dataspace->cacheability(),
 	                src_dataspace->is_io_mem(),
 	                map_size_log2,
-	                src_dataspace->writable());
+	                src_dataspace->writable() && writeable);
 
 	/*
 	 * On kernels with a mapping database, the 'dsc' dataspace is a leaf
@@ -348,7 +367,7 @@ Rm_session::Local_addr
 Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
                              off_t offset, bool use_local_addr,
                              Rm_session::Local_addr local_addr,
-                             bool executable)
+                             bool executable, bool writeable)
 {
 	/* serialize access */
 	Lock::Guard lock_guard(_lock);
@@ -423,7 +442,7 @@ Rm_session_component::attach(Dataspace_capability ds_cap, size_t size,
 	}
 
 	/* store attachment info in meta data */
-	_map.metadata(r, Rm_region((addr_t)r, size, true, dsc, offset, this));
+	_map.metadata(r, Rm_region((addr_t)r, size, writeable, dsc, offset, this));
 	Rm_region *region = _map.metadata(r);
 
 	/* also update region list */
@@ -679,7 +698,8 @@ bool Rm_session_component::reverse_lookup(addr_t                dst_base,
                                           Fault_area           *dst_fault_area,
                                           Dataspace_component **src_dataspace,
                                           Fault_area           *src_fault_area,
-                                          Rm_session_component **sub_rm_session)
+                                          Rm_session_component **sub_rm_session,
+                                          bool                  *writeable)
 {
 	/* serialize access */
 	Lock::Guard lock_guard(_lock);
@@ -692,6 +712,8 @@ bool Rm_session_component::reverse_lookup(addr_t                dst_base,
 	if (!region)
 		return false;
 
+	*writeable = region->write();
+
 	/* request dataspace  backing the region */
 	*src_dataspace = region->dataspace();
 	if (!*src_dataspace)
@@ -0,0 +1,188 @@
+/*
+ * \brief  Fragmentation and latency test of the AVL-based range allocator
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test manages a virtual address range, i.e., the allocated blocks are
+ * never accessed. It first checks the consistency of randomly sized and
+ * aligned allocations. It then fragments the range with free blocks that
+ * cannot satisfy page-aligned allocations and measures the latency of
+ * page-aligned allocations in this situation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/env.h>
+#include <base/printf.h>
+#include <trace/timestamp.h>
+
+using namespace Genode;
+
+
+enum {
+	RANGE_BASE = 0x10000000,
+	RANGE_SIZE = 256*1024*1024,
+	NUM_BLOCKS = 1024,
+	NUM_ROUNDS = 64*1024,
+	NUM_FRAGMENTS = 8*1024,
+};
+
+
+static unsigned random_value()
+{
+	static unsigned long seed = 1;
+	seed = seed*1103515245 + 12345;
+	return (unsigned)(seed >> 16);
+}
+
+
+struct Block { addr_t addr; size_t size; };
+
+
+/**
+ * Check that the live blocks are aligned and do not overlap
+ */
+static bool blocks_valid(Block const *blocks, unsigned num)
+{
+	for (unsigned i = 0; i < num; i++) {
+
+		if (!blocks[i].size) continue;
+
+		if (blocks[i].addr < RANGE_BASE
+		 || blocks[i].addr + blocks[i].size > RANGE_BASE + RANGE_SIZE)
+			return false;
+
+		for (unsigned j = i + 1; j < num; j++)
+			if (blocks[j].size
+			 && blocks[i].addr < blocks[j].addr + blocks[j].size
+			 && blocks[j].addr < blocks[i].addr + blocks[i].size)
+				return false;
+	}
+	return true;
+}
+
+
+static bool test_consistency(Allocator_avl &alloc)
+{
+	static Block blocks[NUM_BLOCKS];
+
+	size_t const initial_avail = alloc.avail();
+
+	for (unsigned r = 0; r < NUM_ROUNDS; r++) {
+
+		Block &b = blocks[random_value() % NUM_BLOCKS];
+
+		if (b.size) {
+			alloc.free((void *)b.addr);
+			b.size = 0;
+			continue;
+		}
+
+		size_t const size  = 1 + random_value() % (64*1024);
+		int    const align = random_value() % 16;
+
+		void *addr = 0;
+		if (alloc.alloc_aligned(size, &addr, align).is_error()) {
+			PERR("allocation of %zd bytes (align %d) failed", size, align);
+			return false;
+		}
+
+		if ((addr_t)addr & ((1UL << align) - 1)) {
+			PERR("block %p violates alignment %d", addr, align);
+			return false;
+		}
+
+		b.addr = (addr_t)addr;
+		b.size = size;
+
+		if ((r % 4096) == 0 && !blocks_valid(blocks, NUM_BLOCKS)) {
+			PERR("overlapping blocks detected");
+			return false;
+		}
+	}
+
+	for (unsigned i = 0; i < NUM_BLOCKS; i++)
+		if (blocks[i].size) {
+			alloc.free((void *)blocks[i].addr);
+			blocks[i].size = 0;
+		}
+
+	if (alloc.avail() != initial_avail) {
+		PERR("leaked %zd bytes", initial_avail - alloc.avail());
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Measure page-aligned allocations within a fragmented range
+ *
+ * The free fragments are larger than one page but are not page aligned
+ * such that most of them cannot hold a page-aligned page.
+ */
+static bool test_fragmented_latency(Allocator_avl &alloc)
+{
+	static void *fragments[NUM_FRAGMENTS];
+
+	for (unsigned i = 0; i < NUM_FRAGMENTS; i++) {
+		void *separator = 0;
+		if (alloc.alloc_aligned(128, &separator, 0).is_error()
+		 || alloc.alloc_aligned(4096 + 512, &fragments[i], 0).is_error()) {
+			PERR("fragmentation of range failed");
+			return false;
+		}
+	}
+
+	for (unsigned i = 0; i < NUM_FRAGMENTS; i++)
+		alloc.free(fragments[i]);
+
+	Trace::Timestamp total = 0, worst = 0;
+
+	for (unsigned i = 0; i < NUM_ROUNDS; i++) {
+
+		void *addr = 0;
+
+		Trace::Timestamp const start = Trace::timestamp();
+		bool const ok = alloc.alloc_aligned(4096, &addr, 12).is_ok();
+		Trace::Timestamp const duration = Trace::timestamp() - start;
+
+		if (!ok) {
+			PERR("page-aligned allocation failed");
+			return false;
+		}
+		alloc.free(addr);
+
+		total += duration;
+		worst  = max(worst, duration);
+	}
+
+	printf("fragmented range: %u free fragments, avail=%zd\n",
+	       NUM_FRAGMENTS, alloc.avail());
+	printf("page-aligned alloc: avg %llu, worst %llu cycles\n",
+	       (unsigned long long)(total / NUM_ROUNDS),
+	       (unsigned long long)worst);
+	return true;
+}
+
+
+int main(int, char **)
+{
+	printf("--- allocator-avl test started ---\n");
+
+	static Allocator_avl alloc(env()->heap());
+	alloc.add_range(RANGE_BASE, RANGE_SIZE);
+
+	if (!test_consistency(alloc) || !test_fragmented_latency(alloc))
+		return -1;
+
+	printf("--- allocator-avl test finished ---\n");
+	return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * \brief  Test of the heap front end with per-thread caches
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Several threads allocate, check, and free small blocks concurrently. The
+ * test checks that the blocks do not overlap, that the heap lock is taken
+ * once per batch rather than once per block, and that the blocks cached by
+ * a thread return to the heap when its cache is released, either by the
+ * thread itself or on its behalf after it exited. Finally, it checks that
+ * released caches are reused by later threads.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/cached_heap.h>
+#include <base/env.h>
+#include <base/printf.h>
+#include <base/thread.h>
+
+using namespace Genode;
+
+
+enum { NUM_WORKERS = 4, NUM_BLOCKS = 64, NUM_ROUNDS = 1000 };
+
+
+static Heap &heap()
+{
+	static Heap inst(env()->ram_session(), env()->rm_session());
+	return inst;
+}
+
+
+static Cached_heap &cached_heap()
+{
+	static Cached_heap inst(heap());
+	return inst;
+}
+
+
+struct Worker : Thread<0x4000>
+{
+	unsigned const id;
+	unsigned const rounds;
+	bool     const release_itself;
+	bool           ok;
+	unsigned long  hits;
+
+	Worker(unsigned id, unsigned rounds, bool release_itself)
+	:
+		Thread<0x4000>("worker"), id(id), rounds(rounds),
+		release_itself(release_itself), ok(false), hits(0)
+	{ }
+
+	static size_t block_size(unsigned i) { return 8 + (i*37) % 1024; }
+
+	bool _round(unsigned round)
+	{
+		static_assert(NUM_BLOCKS <= 256, "block index must fit in a byte");
+
+		unsigned char *blocks[NUM_BLOCKS];
+
+		for (unsigned i = 0; i < NUM_BLOCKS; i++) {
+			if (!cached_heap().alloc(block_size(i + round), (void **)&blocks[i])) {
+				PERR("worker %u: allocation failed", id);
+				return false;
+			}
+			memset(blocks[i], (id << 6) ^ i, block_size(i + round));
+		}
+
+		/* a block overlapping with another one got overwritten */
+		for (unsigned i = 0; i < NUM_BLOCKS; i++)
+			for (size_t j = 0; j < block_size(i + round); j++)
+				if (blocks[i][j] != (unsigned char)((id << 6) ^ i)) {
+					PERR("worker %u: block %u corrupted", id, i);
+					return false;
+				}
+
+		for (unsigned i = 0; i < NUM_BLOCKS; i++)
+			cached_heap().free(blocks[i], block_size(i + round));
+
+		return true;
+	}
+
+	void entry()
+	{
+		for (unsigned r = 0; r < rounds; r++)
+			if (!_round(r))
+				return;
+
+		hits = cached_heap().hits();
+
+		if (release_itself)
+			cached_heap().release();
+
+		ok = true;
+	}
+};
+
+
+static bool test_concurrent()
+{
+	size_t      const consumed = heap().consumed();
+	Heap::Stats const before   = heap().stats();
+
+	static Worker *workers[NUM_WORKERS];
+
+	for (unsigned i = 0; i < NUM_WORKERS; i++)
+		workers[i] = new (env()->heap()) Worker(i, NUM_ROUNDS, i % 2 == 0);
+
+	for (unsigned i = 0; i < NUM_WORKERS; i++) workers[i]->start();
+	for (unsigned i = 0; i < NUM_WORKERS; i++) workers[i]->join();
+
+	bool ok = true;
+	for (unsigned i = 0; i < NUM_WORKERS; i++) {
+		ok &= workers[i]->ok;
+
+		if (!workers[i]->hits) {
+			PERR("worker %u: no allocation served by the cache", i);
+			ok = false;
+		}
+
+		/* release the caches of the workers that did not do it */
+		if (!workers[i]->release_itself)
+			cached_heap().release(workers[i]);
+	}
+
+	Heap::Stats const after = heap().stats();
+
+	unsigned long const ops = 2UL*NUM_WORKERS*NUM_ROUNDS*NUM_BLOCKS;
+	unsigned long const acquisitions = after.acquisitions - before.acquisitions;
+
+	printf("%lu allocations and frees, %lu heap-lock acquisitions, "
+	       "%lu contended\n", ops, acquisitions,
+	       after.contentions - before.contentions);
+
+	if (acquisitions*4 > ops) {
+		PERR("heap lock not taken per batch");
+		ok = false;
+	}
+
+	if (heap().consumed() != consumed) {
+		PERR("released caches still hold %zd bytes",
+		     heap().consumed() - consumed);
+		ok = false;
+	}
+
+	for (unsigned i = 0; i < NUM_WORKERS; i++)
+		destroy(env()->heap(), workers[i]);
+
+	return ok;
+}
+
+
+/**
+ * Run more short-lived threads than there are caches
+ */
+static bool test_reuse()
+{
+	enum { NUM_THREADS = 2*Cached_heap::MAX_THREADS };
+
+	for (unsigned i = 0; i < NUM_THREADS; i++) {
+
+		Worker worker(i, 2, true);
+		worker.start();
+		worker.join();
+
+		if (!worker.ok || !worker.hits) {
+			PERR("thread %u got no cache", i);
+			return false;
+		}
+	}
+
+	printf("%u threads used released caches\n", (unsigned)NUM_THREADS);
+	return true;
+}
+
+
+int main(int, char **)
+{
+	printf("--- cached-heap test started ---\n");
+
+	if (!test_concurrent() || !test_reuse())
+		return -1;
+
+	printf("--- cached-heap test finished ---\n");
+	return 0;
+}
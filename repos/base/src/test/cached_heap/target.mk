@@ -0,0 +1,3 @@
+TARGET = test-cached_heap
+SRC_CC = main.cc
+LIBS   = base
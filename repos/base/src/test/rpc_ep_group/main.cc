@@ -0,0 +1,111 @@
+/*
+ * \brief  Test for serving RPC objects by a group of entrypoints
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Two objects are managed by different entrypoints of a group. A call of
+ * the first object blocks until the second object is called. With a single
+ * entrypoint, this scenario would dead-lock.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/thread.h>
+#include <base/env.h>
+#include <base/rpc_client.h>
+#include <base/rpc_entrypoint_group.h>
+#include <cap_session/connection.h>
+
+namespace Test {
+
+	struct Session
+	{
+		GENODE_RPC(Rpc_block, void, block);
+		GENODE_RPC(Rpc_wake, void, wake);
+		GENODE_RPC_INTERFACE(Rpc_block, Rpc_wake);
+	};
+
+	struct Client : Genode::Rpc_client<Session>
+	{
+		Client(Genode::Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+		void block() { call<Rpc_block>(); }
+		void wake()  { call<Rpc_wake>(); }
+	};
+
+	struct Component : Genode::Rpc_object<Session, Component>
+	{
+		Genode::Lock &barrier;
+
+		Component(Genode::Lock &barrier) : barrier(barrier) { }
+
+		void block() { barrier.lock(); }
+		void wake()  { barrier.unlock(); }
+	};
+
+	struct Blocking_caller : Genode::Thread<8192>
+	{
+		Genode::Capability<Session> cap;
+
+		Blocking_caller(Genode::Capability<Session> cap)
+		: Genode::Thread<8192>("blocking_caller"), cap(cap) { start(); }
+
+		void entry() { Client(cap).block(); }
+	};
+}
+
+
+int main(int argc, char **argv)
+{
+	using namespace Genode;
+
+	printf("--- test-rpc_ep_group started ---\n");
+
+	enum { STACK_SIZE = 8192 };
+
+	static Cap_connection cap;
+	static Rpc_entrypoint_group group(&cap, STACK_SIZE, "rpc_ep_group", 2);
+
+	Lock barrier(Lock::LOCKED);
+
+	Test::Component blocking(barrier), waking(barrier);
+
+	/* the group distributes both objects over its two entrypoints */
+	Capability<Test::Session> blocking_cap = group.manage(&blocking);
+	Capability<Test::Session> waking_cap   = group.manage(&waking);
+
+	/* each entrypoint of the group finds the objects of the other one */
+	for (unsigned i = 0; i < group.count(); i++) {
+		Object_pool<Rpc_object_base>::Guard
+			obj(group.ep(i).lookup_and_lock(blocking_cap));
+
+		if (obj.object() != &blocking) {
+			PERR("entrypoint %u failed to look up object", i);
+			return -1;
+		}
+	}
+
+	{
+		Test::Blocking_caller caller(blocking_cap);
+
+		/* served by the second entrypoint while the first one blocks */
+		Test::Client(waking_cap).wake();
+
+		caller.join();
+	}
+	printf("blocking call returned\n");
+
+	/* dissolve objects, using the entrypoint that did not manage them */
+	group.ep(1).dissolve(&blocking);
+	group.ep(0).dissolve(&waking);
+
+	printf("--- test-rpc_ep_group finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-rpc_ep_group
+SRC_CC = main.cc
+LIBS   = base
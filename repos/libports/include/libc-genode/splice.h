@@ -0,0 +1,37 @@
+/*
+ * \brief  Linux-style 'splice' function
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The function is provided by the libc plugin of Noux only.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LIBC__INCLUDE__SPLICE_H_
+#define _LIBC__INCLUDE__SPLICE_H_
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+
+__BEGIN_DECLS
+
+/**
+ * Move data between two file descriptors without copying it to the process
+ *
+ * 'off_in' and 'off_out' must be NULL. 'flags' is ignored.
+ *
+ * \return number of transferred bytes, 0 at the end of the input, or -1
+ *         on error
+ */
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out,
+               size_t len, unsigned int flags);
+
+__END_DECLS
+
+#endif /* _LIBC__INCLUDE__SPLICE_H_ */
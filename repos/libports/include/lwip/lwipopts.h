@@ -88,6 +88,9 @@
 
 #define PBUF_POOL_SIZE             96
 
+/* the NIC backend hands out received TCP segments as custom pbufs */
+#define LWIP_SUPPORT_CUSTOM_PBUF    1
+
 /*
  * We reduce the maximum segment lifetime from one minute to one second to
  * avoid queuing up PCBs in TIME-WAIT state. This is the state, PCBs end up
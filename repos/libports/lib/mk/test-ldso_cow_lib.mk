@@ -0,0 +1,5 @@
+SRC_C      = lib.c
+SHARED_LIB = yes
+INC_DIR   += $(REP_DIR)/src/test/ldso_cow/include
+
+vpath % $(REP_DIR)/src/test/ldso_cow
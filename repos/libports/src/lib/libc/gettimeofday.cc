@@ -30,11 +30,11 @@ int gettimeofday(struct timeval *tv, struct timezone *tz)
 		read_rtc = true;
 	}
 
-	Genode::Alarm::Time time = Genode::Timeout_thread::alarm_timer()->time();
+	Genode::uint64_t time = Genode::Timeout_thread::alarm_timer()->time_us();
 
 	if (tv) {
-		tv->tv_sec = rtc + time / 1000;
-		tv->tv_usec = (time % 1000) * 1000;
+		tv->tv_sec = rtc + time / (1000*1000);
+		tv->tv_usec = time % (1000*1000);
 	}
 
 	return 0;
@@ -52,43 +52,120 @@ namespace Genode {
 
 /**
  * Allocator that uses slabs for small objects sizes
+ *
+ * Blocks of up to 'FINE_MAX' bytes are served by slabs with a granularity
+ * of 'FINE_STEP' bytes, which keeps the internal fragmentation of the
+ * frequent small allocations low. Larger blocks of up to '1 << SLAB_STOP'
+ * bytes are served by slabs with power-of-two sizes. Each slab is protected
+ * by a lock of its own. Blocks that do not fit into any slab are allocated
+ * at the backing store, and blocks of at least 'DATASPACE_MIN' bytes are
+ * backed by a dedicated dataspace each.
  */
 class Malloc : public Genode::Allocator
 {
 	private:
 
 		enum {
-			SLAB_START = 2,  /* 4 Byte (log2) */
-			SLAB_STOP  = 11, /* 2048 Byte (log2) */
-			NUM_SLABS = (SLAB_STOP - SLAB_START) + 1
+			FINE_STEP      = 16,
+			FINE_MAX_LOG2  = 8,  /* 256 Byte */
+			FINE_MAX       = 1 << FINE_MAX_LOG2,
+			NUM_FINE_SLABS = FINE_MAX / FINE_STEP,
+			SLAB_STOP      = 11, /* 2048 Byte (log2) */
+			NUM_SLABS      = NUM_FINE_SLABS + (SLAB_STOP - FINE_MAX_LOG2),
+			DATASPACE_MIN  = 64*1024,
+		};
+
+		/**
+		 * Meta data of a block backed by a dedicated dataspace
+		 *
+		 * The meta data is located at the beginning of the dataspace,
+		 * followed by the block header and the block content.
+		 */
+		struct Dataspace_block
+		{
+			Genode::Ram_dataspace_capability cap;
+
+			Dataspace_block(Genode::Ram_dataspace_capability cap) : cap(cap) { }
+		};
+
+		enum { DATASPACE_HEADER = 64 - sizeof(Block_header) };
+
+		struct Size_class
+		{
+			Genode::Slab_alloc *slab;
+			Genode::Lock        lock;
 		};
 
-		Genode::Allocator  *_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+		Genode::Allocator *_backing_store; /* back-end allocator */
+		Size_class         _classes[NUM_SLABS];
 
-		unsigned long _slab_log2(unsigned long size)
+		/**
+		 * Return index of the slab for blocks of 'real_size' bytes
+		 */
+		static unsigned _slab_index(unsigned long real_size)
 		{
-			unsigned msb = Genode::log2(size);
+			if (real_size <= FINE_MAX)
+				return (real_size - 1) / FINE_STEP;
+
+			unsigned msb = Genode::log2(real_size);
 			/* size is greater than msb */
-			if (size > (1U << msb))
+			if (real_size > (1UL << msb))
 				msb++;
 
-			/* use smallest slab */
-			if (size < (1U << SLAB_START))
-				msb = SLAB_START;
+			return NUM_FINE_SLABS + msb - FINE_MAX_LOG2 - 1;
+		}
+
+		/**
+		 * Return object size of slab with the specified index
+		 */
+		static unsigned long _slab_size(unsigned index)
+		{
+			if (index < NUM_FINE_SLABS)
+				return (index + 1)*FINE_STEP;
+
+			return 1UL << (index - NUM_FINE_SLABS + FINE_MAX_LOG2 + 1);
+		}
+
+		void *_alloc_dataspace(unsigned long real_size)
+		{
+			using namespace Genode;
+
+			size_t const ds_size = align_addr(real_size + DATASPACE_HEADER, 12);
+
+			Ram_dataspace_capability cap;
+			void *addr = 0;
+			try {
+				cap  = env()->ram_session()->alloc(ds_size);
+				addr = env()->rm_session()->attach(cap);
+			} catch (Ram_session::Alloc_failed) {
+				return 0;
+			} catch (Rm_session::Attach_failed) {
+				env()->ram_session()->free(cap);
+				return 0;
+			}
 
-			return msb;
+			construct_at<Dataspace_block>(addr, cap);
+			return (char *)addr + DATASPACE_HEADER;
+		}
+
+		void _free_dataspace(void *addr)
+		{
+			using namespace Genode;
+
+			void *ds_addr = (char *)addr - DATASPACE_HEADER;
+			Ram_dataspace_capability cap = ((Dataspace_block *)ds_addr)->cap;
+
+			env()->rm_session()->detach(ds_addr);
+			env()->ram_session()->free(cap);
 		}
 
 	public:
 
 		Malloc(Genode::Allocator *backing_store) : _backing_store(backing_store)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] = new (backing_store)
-				                                 Genode::Slab_alloc(1U << i, backing_store);
-			}
+			for (unsigned i = 0; i < NUM_SLABS; i++)
+				_classes[i].slab = new (backing_store)
+				                   Genode::Slab_alloc(_slab_size(i), backing_store);
 		}
 
 		~Malloc() { PDBG("CALLED"); }
@@ -99,8 +176,6 @@ class Malloc : public Genode::Allocator
 
 		bool alloc(size_t size, void **out_addr)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			/* enforce size to be a multiple of 4 bytes */
 			size = (size + 3) & ~3;
 
@@ -111,18 +186,27 @@ class Malloc : public Genode::Allocator
 			 * the size information when freeing the block.
 			 */
 			unsigned long real_size = size + sizeof(Block_header);
-			unsigned long msb = _slab_log2(real_size);
 			void *addr = 0;
 
+			if (real_size >= DATASPACE_MIN) {
+
+				if (!(addr = _alloc_dataspace(real_size)))
+					return false;
+			}
+
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP) {
+			else if (real_size > (1U << SLAB_STOP)) {
 
 				if (!(_backing_store->alloc(real_size, &addr)))
 					return false;
 			}
-			else
-				if (!(addr = _allocator[msb - SLAB_START]->alloc()))
+			else {
+				Size_class &size_class = _classes[_slab_index(real_size)];
+
+				Genode::Lock::Guard lock_guard(size_class.lock);
+				if (!(addr = size_class.slab->alloc()))
 					return false;
+			}
 
 			*(Block_header *)addr = real_size;
 			*out_addr = (Block_header *)addr + 1;
@@ -131,16 +215,18 @@ class Malloc : public Genode::Allocator
 
 		void free(void *ptr, size_t /* size */)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			unsigned long *addr = ((unsigned long *)ptr) - 1;
 			unsigned long  real_size = *addr;
 
-			if (real_size > (1U << SLAB_STOP))
+			if (real_size >= DATASPACE_MIN)
+				_free_dataspace(addr);
+			else if (real_size > (1U << SLAB_STOP))
 				_backing_store->free(addr, real_size);
 			else {
-				unsigned long msb = _slab_log2(real_size);
-				_allocator[msb - SLAB_START]->free(addr);
+				Size_class &size_class = _classes[_slab_index(real_size)];
+
+				Genode::Lock::Guard lock_guard(size_class.lock);
+				size_class.slab->free(addr);
 			}
 		}
 
@@ -148,10 +234,13 @@ class Malloc : public Genode::Allocator
 		{
 			size += sizeof(Block_header);
 
+			if (size >= DATASPACE_MIN)
+				return Genode::align_addr(size + DATASPACE_HEADER, 12) - size;
+
 			if (size > (1U << SLAB_STOP))
 				return _backing_store->overhead(size);
 
-			return _allocator[_slab_log2(size) - SLAB_START]->overhead(size);
+			return _classes[_slab_index(size)].slab->overhead(size);
 		}
 
 		bool need_size_for_free() const override { return false; }
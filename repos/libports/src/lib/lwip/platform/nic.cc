@@ -28,6 +28,7 @@ extern "C" {
 
 /* Genode includes */
 #include <base/thread.h>
+#include <base/lock.h>
 #include <base/printf.h>
 #include <nic/packet_allocator.h>
 #include <nic_session/connection.h>
@@ -38,12 +39,40 @@ extern "C" {
  */
 class Nic_receiver_thread : public Genode::Thread<8192>
 {
+	public:
+
+		/*
+		 * Pbuf that refers to a packet within the receive buffer of the
+		 * nic session. The packet is acknowledged not before lwIP frees
+		 * the pbuf.
+		 */
+		struct Rx_pbuf
+		{
+			struct pbuf_custom   custom;  /* must be the first member */
+			Packet_descriptor    packet;
+			Nic_receiver_thread *thread;
+			Rx_pbuf             *next_free;
+		};
+
 	private:
 
+		enum { MAX_RX_PBUFS = 128 };
+
 		Nic::Connection  *_nic;       /* nic-session */
 		Packet_descriptor _rx_packet; /* actual packet received */
 		struct netif     *_netif;     /* LwIP network interface structure */
 
+		Rx_pbuf               _rx_pbufs[MAX_RX_PBUFS];
+		Rx_pbuf              *_free_rx_pbufs;
+		Genode::size_t const  _rx_budget; /* max. bytes of packets held by lwIP */
+		Genode::size_t        _rx_held;
+
+		/*
+		 * Rx pbufs are freed by any thread that uses lwIP, so the
+		 * acknowledgements are serialized by this lock
+		 */
+		Genode::Lock _rx_lock;
+
 		void _tx_ack(bool block = false)
 		{
 			/* check for acknowledgements */
@@ -54,15 +83,85 @@ class Nic_receiver_thread : public Genode::Thread<8192>
 			}
 		}
 
+		static void _free_rx_pbuf(struct pbuf *p)
+		{
+			Rx_pbuf *rx = reinterpret_cast<Rx_pbuf *>(p);
+			rx->thread->free_rx_pbuf(rx);
+		}
+
 	public:
 
-		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif)
-		: Genode::Thread<8192>("nic-recv"), _nic(nic), _netif(netif) {}
+		/**
+		 * Constructor
+		 *
+		 * \param rx_buf_size  size of the nic session's receive buffer
+		 *
+		 * Received packets are handed out to lwIP without copying as long
+		 * as lwIP holds less than half of the receive buffer. Beyond that,
+		 * they are copied to keep the nic server able to deliver packets
+		 * while lwIP queues data not consumed by the application yet.
+		 */
+		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif,
+		                    Genode::size_t rx_buf_size)
+		:
+			Genode::Thread<8192>("nic-recv"), _nic(nic), _netif(netif),
+			_free_rx_pbufs(0), _rx_budget(rx_buf_size / 2), _rx_held(0)
+		{
+			for (unsigned i = 0; i < MAX_RX_PBUFS; i++) {
+				Rx_pbuf &rx = _rx_pbufs[i];
+				rx.custom.custom_free_function = _free_rx_pbuf;
+				rx.thread    = this;
+				rx.next_free = _free_rx_pbufs;
+				_free_rx_pbufs = &rx;
+			}
+		}
 
 		void entry();
 		Nic::Connection  *nic() { return _nic; };
 		Packet_descriptor rx_packet() { return _rx_packet; };
 
+		/**
+		 * Allocate pbuf that refers to the actual received packet
+		 *
+		 * \return  0 if lwIP holds too many received packets already, in
+		 *          which case the packet must be copied
+		 */
+		Rx_pbuf *alloc_rx_pbuf()
+		{
+			Genode::Lock::Guard lock_guard(_rx_lock);
+
+			if (!_free_rx_pbufs || _rx_held + _rx_packet.size() > _rx_budget)
+				return 0;
+
+			Rx_pbuf *rx    = _free_rx_pbufs;
+			_free_rx_pbufs = rx->next_free;
+			rx->packet     = _rx_packet;
+			_rx_held      += _rx_packet.size();
+			return rx;
+		}
+
+		/**
+		 * Acknowledge packet of freed pbuf
+		 */
+		void free_rx_pbuf(Rx_pbuf *rx)
+		{
+			Genode::Lock::Guard lock_guard(_rx_lock);
+
+			nic()->rx()->acknowledge_packet(rx->packet);
+			_rx_held      -= rx->packet.size();
+			rx->next_free  = _free_rx_pbufs;
+			_free_rx_pbufs = rx;
+		}
+
+		/**
+		 * Acknowledge received packet that got copied
+		 */
+		void ack_rx_packet(Packet_descriptor packet)
+		{
+			Genode::Lock::Guard lock_guard(_rx_lock);
+			nic()->rx()->acknowledge_packet(packet);
+		}
+
 		Packet_descriptor alloc_tx_packet(Genode::size_t size)
 		{
 			while (true) {
@@ -123,12 +222,12 @@ extern "C" {
 		char *tx_content            = th->content(tx_packet);
 
 		/*
-		 * Iterate through all pbufs and
-		 * copy payload into packet's payload
+		 * The nic session transfers each frame as one contiguous packet.
+		 * Hence, gather the payloads of all pbufs of the chain into the
+		 * packet's payload, which is the only copy on the transmit path.
 		 */
 		for(struct pbuf *q = p; q != NULL; q = q->next) {
-			char *src = (char*) q->payload;
-			Genode::memcpy(tx_content, src, q->len);
+			Genode::memcpy(tx_content, q->payload, q->len);
 			tx_content += q->len;
 		}
 
@@ -143,10 +242,50 @@ extern "C" {
 	}
 
 
+#if !ETH_PAD_SIZE
+	/**
+	 * Return true if the frame may be handed to lwIP without copying
+	 *
+	 * A PBUF_REF pbuf refers to the frame within the receive buffer. Once
+	 * lwIP hid a header of such a pbuf via 'pbuf_header', the header
+	 * cannot be exposed again. However, several input paths move the
+	 * payload pointer back to the IP header: 'udp_input' to respond with
+	 * ICMP port unreachable, 'icmp_input' to answer echo requests, and
+	 * 'icmp_dest_unreach' in general. IP reassembly and ARP reuse the
+	 * received pbufs in place. The TCP input path, in contrast, only hides
+	 * headers. Hence, only unfragmented TCP segments over IPv4 are handed
+	 * out without copying.
+	 */
+	static bool zero_copy_frame(unsigned char const *frame, u16_t len)
+	{
+		/* the names of lwIP's macros are avoided deliberately */
+		enum {
+			ETH_HDR_LEN = 14, IPV4_HDR_LEN = 20,
+			TYPE_IPV4 = 0x0800, PROTO_TCP = 6, MF_AND_OFFSET = 0x3fff,
+		};
+
+		if (len < ETH_HDR_LEN + IPV4_HDR_LEN)
+			return false;
+
+		unsigned char const *ip = frame + ETH_HDR_LEN;
+
+		unsigned const type = (frame[12] << 8) | frame[13];
+		unsigned const frag = (ip[6] << 8) | ip[7];
+
+		return type == TYPE_IPV4 && (ip[0] >> 4) == 4
+		    && ip[9] == PROTO_TCP && !(frag & MF_AND_OFFSET);
+	}
+#endif
+
+
 	/**
 	 * Should allocate a pbuf and transfer the bytes of the incoming
 	 * packet from the interface into the pbuf.
 	 *
+	 * If possible, the pbuf refers to the packet within the receive
+	 * buffer of the nic session instead of copying it, see
+	 * 'zero_copy_frame'.
+	 *
 	 * @param netif the lwip network interface structure for this genode_netif
 	 * @return a pbuf filled with the received packet (including MAC header)
 	 *         NULL on memory error
@@ -160,7 +299,22 @@ extern "C" {
 		char *rx_content        = nic->rx()->packet_content(rx_packet);
 		u16_t len               = rx_packet.size();
 
-#if ETH_PAD_SIZE
+		/*
+		 * Hand out the packet without copying. With Ethernet padding, the
+		 * padding word cannot be prepended in place, so the packet is
+		 * always copied.
+		 */
+#if !ETH_PAD_SIZE
+		Nic_receiver_thread::Rx_pbuf *rx =
+			zero_copy_frame((unsigned char const *)rx_content, len)
+			? th->alloc_rx_pbuf() : 0;
+
+		if (rx) {
+			LINK_STATS_INC(link.recv);
+			return pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &rx->custom,
+			                           rx_content, len);
+		}
+#else
 		len += ETH_PAD_SIZE; /* allow room for Ethernet padding */
 #endif
 
@@ -191,7 +345,7 @@ extern "C" {
 		}
 
 		/* Acknowledge the packet */
-		nic->rx()->acknowledge_packet(rx_packet);
+		th->ack_rx_packet(rx_packet);
 		return p;
 	}
 
@@ -260,7 +414,7 @@ extern "C" {
 
 		/* Setup receiver thread */
 		Nic_receiver_thread *th = new (env()->heap())
-			Nic_receiver_thread(nic, netif);
+			Nic_receiver_thread(nic, netif, nbs->rx_buf_size);
 
 		/* Store receiver thread address in user-defined netif struct part */
 		netif->state      = (void*) th;
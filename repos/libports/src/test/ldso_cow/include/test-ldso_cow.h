@@ -0,0 +1,46 @@
+/*
+ * \brief  Shared library with a large copy-on-write data segment
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _TEST_LDSO_COW_H_
+#define _TEST_LDSO_COW_H_
+
+enum {
+	LDSO_COW_PAGE_WORDS = 4096 / sizeof(unsigned),
+
+	/* pages of initialized data not touched by any relocation */
+	LDSO_COW_PAGES   = 64,
+	LDSO_COW_WORDS   = LDSO_COW_PAGES*LDSO_COW_PAGE_WORDS,
+	LDSO_COW_PATTERN = 0x5a5a5a5a,
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initialized data, populated from the ROM module on demand
+ */
+extern unsigned ldso_cow_data[LDSO_COW_WORDS];
+
+/**
+ * Pointers to the first and last word of 'ldso_cow_data'
+ *
+ * The pointers are relocated at load time and, hence, are copied eagerly.
+ */
+extern unsigned *ldso_cow_ptrs[2];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _TEST_LDSO_COW_H_ */
@@ -0,0 +1,20 @@
+/*
+ * \brief  Shared library with a large copy-on-write data segment
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include "test-ldso_cow.h"
+
+unsigned ldso_cow_data[LDSO_COW_WORDS] = {
+	[0 ... LDSO_COW_WORDS - 1] = LDSO_COW_PATTERN };
+
+unsigned *ldso_cow_ptrs[2] = {
+	&ldso_cow_data[0], &ldso_cow_data[LDSO_COW_WORDS - 1] };
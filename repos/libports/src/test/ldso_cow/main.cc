@@ -0,0 +1,98 @@
+/*
+ * \brief  Test and benchmark for copy-on-write data segments of shared libs
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test loads a library with a large data segment, checks its content,
+ * and writes to each page that is not written at load time. It reports the
+ * load time, the time per write fault, and the RAM consumed by the library.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/printf.h>
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <dlfcn.h>
+
+#include "test-ldso_cow.h"
+
+using namespace Genode;
+
+
+static size_t ram_used_kib() { return env()->ram_session()->used() / 1024; }
+
+
+int main(int, char **)
+{
+	printf("--- ldso copy-on-write test started ---\n");
+
+	static Timer::Connection timer;
+
+	size_t const used_before = ram_used_kib();
+	uint64_t     start       = timer.elapsed_us();
+
+	void *handle = dlopen("test-ldso_cow_lib.lib.so", RTLD_NOW);
+	if (!handle) {
+		PERR("could not load library");
+		return -1;
+	}
+
+	printf("load: %llu us, RAM: %zu KiB\n",
+	       (unsigned long long)(timer.elapsed_us() - start),
+	       ram_used_kib() - used_before);
+
+	unsigned  *data = (unsigned *) dlsym(handle, "ldso_cow_data");
+	unsigned **ptrs = (unsigned **)dlsym(handle, "ldso_cow_ptrs");
+	if (!data || !ptrs) {
+		PERR("could not look up symbols");
+		return -1;
+	}
+
+	/* relocated pointers */
+	if (ptrs[0] != &data[0] || ptrs[1] != &data[LDSO_COW_WORDS - 1]) {
+		PERR("relocated pointers invalid");
+		return -1;
+	}
+
+	/* read faults are served from the ROM module */
+	for (unsigned i = 0; i < LDSO_COW_WORDS; i++)
+		if (data[i] != LDSO_COW_PATTERN) {
+			PERR("unexpected initial value 0x%x at word %u", data[i], i);
+			return -1;
+		}
+
+	/* write to each page to trigger the copy on write */
+	start = timer.elapsed_us();
+
+	for (unsigned i = 0; i < LDSO_COW_WORDS; i += LDSO_COW_PAGE_WORDS)
+		data[i] = i;
+
+	uint64_t const duration = timer.elapsed_us() - start;
+
+	for (unsigned i = 0; i < LDSO_COW_WORDS; i++) {
+		unsigned const expected = (i % LDSO_COW_PAGE_WORDS) ? LDSO_COW_PATTERN : i;
+		if (data[i] != expected) {
+			PERR("unexpected value 0x%x at word %u after write", data[i], i);
+			return -1;
+		}
+	}
+
+	printf("write: %u pages, %llu us per page, RAM: %zu KiB\n",
+	       (unsigned)LDSO_COW_PAGES,
+	       (unsigned long long)(duration / LDSO_COW_PAGES),
+	       ram_used_kib() - used_before);
+
+	dlclose(handle);
+
+	printf("--- ldso copy-on-write test finished ---\n");
+	return 0;
+}
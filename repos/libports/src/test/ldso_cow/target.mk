@@ -0,0 +1,4 @@
+TARGET   = test-ldso_cow
+SRC_CC   = main.cc
+LIBS     = libc
+INC_DIR += $(REP_DIR)/src/test/ldso_cow/include
@@ -0,0 +1,157 @@
+/*
+ * \brief  Microbenchmark of malloc and free
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+enum {
+	WINDOW     = 1024,     /* number of blocks allocated at a time */
+	ROUNDS     = 1000,
+	SLOTS      = 4096,     /* number of slots of the random workload */
+	RANDOM_OPS = 1000*1000,
+	LARGE_OPS  = 256,
+};
+
+
+/**
+ * Linear congruential generator for a reproducible workload
+ */
+static unsigned random_value()
+{
+	static unsigned long seed = 1;
+	seed = seed*1103515245 + 12345;
+	return (unsigned)(seed >> 16);
+}
+
+
+/**
+ * Return random block size between 'min' and 'max' bytes
+ */
+static size_t random_size(size_t min, size_t max)
+{
+	return min + random_value() % (max - min + 1);
+}
+
+
+static void print_result(char const *name, unsigned long ops, unsigned long ms)
+{
+	printf("%-28s %8lu ops in %6lu ms (%lu ops/ms)\n",
+	       name, ops, ms, ms ? ops/ms : ops);
+}
+
+
+/**
+ * Allocate a window of small blocks and free them in reverse order
+ */
+static void bench_small_lifo(Timer::Connection &timer)
+{
+	static void *blocks[WINDOW];
+
+	unsigned long const start = timer.elapsed_ms();
+
+	for (unsigned r = 0; r < ROUNDS; r++) {
+		for (unsigned i = 0; i < WINDOW; i++)
+			blocks[i] = malloc(random_size(16, 256));
+
+		for (unsigned i = WINDOW; i > 0; i--)
+			free(blocks[i - 1]);
+	}
+
+	print_result("small LIFO (16-256 bytes)", 2UL*ROUNDS*WINDOW,
+	             timer.elapsed_ms() - start);
+}
+
+
+/**
+ * Replace randomly selected blocks of a working set
+ */
+static void bench_small_random(Timer::Connection &timer)
+{
+	static void *slots[SLOTS];
+
+	unsigned long const start = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < RANDOM_OPS; i++) {
+		void *&slot = slots[random_value() % SLOTS];
+		free(slot);
+		slot = malloc(random_size(16, 256));
+
+		/* touch the block to account for cache effects of its placement */
+		*(char *)slot = 0;
+	}
+
+	unsigned long const ms = timer.elapsed_ms() - start;
+
+	for (unsigned i = 0; i < SLOTS; i++)
+		free(slots[i]);
+
+	print_result("small random (16-256 bytes)", 2UL*RANDOM_OPS, ms);
+}
+
+
+/**
+ * Grow blocks via realloc as done by string buffers
+ */
+static void bench_realloc(Timer::Connection &timer)
+{
+	unsigned long const start = timer.elapsed_ms();
+	unsigned long ops = 0;
+
+	for (unsigned r = 0; r < ROUNDS; r++) {
+		char *buf = 0;
+		for (size_t size = 16; size <= 4096; size += 16, ops++)
+			buf = (char *)realloc(buf, size);
+		free(buf);
+	}
+
+	print_result("realloc (16-4096 bytes)", ops, timer.elapsed_ms() - start);
+}
+
+
+/**
+ * Allocate and free large blocks
+ */
+static void bench_large(Timer::Connection &timer)
+{
+	unsigned long const start = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < LARGE_OPS; i++) {
+		void *block = malloc(256*1024);
+		memset(block, 0, 4096);
+		free(block);
+	}
+
+	print_result("large (256 KiB)", 2UL*LARGE_OPS, timer.elapsed_ms() - start);
+}
+
+
+int main(int argc, char **argv)
+{
+	printf("--- malloc benchmark started ---\n");
+
+	static Timer::Connection timer;
+
+	bench_small_lifo(timer);
+	bench_small_random(timer);
+	bench_realloc(timer);
+	bench_large(timer);
+
+	printf("--- malloc benchmark finished ---\n");
+	return 0;
+}
@@ -31,4 +31,82 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+/**
+ * Pixel formats supported by 'blit_convert' and 'blit_alpha'
+ *
+ * :BLIT_RGB565:   16 bit per pixel, 5 bits red in the most significant bits
+ * :BLIT_RGB888:   24 bit per pixel, stored as blue, green, red bytes
+ * :BLIT_RGBA8888: 32 bit per pixel, 0xAARRGGBB as little-endian word
+ */
+enum Blit_format { BLIT_RGB565, BLIT_RGB888, BLIT_RGBA8888 };
+
+
+/**
+ * Convert pixels from one format to another
+ *
+ * \param src      address of source buffer
+ * \param src_w    line length of source buffer in bytes
+ * \param src_fmt  pixel format of source buffer
+ * \param dst      address of destination buffer
+ * \param dst_w    line length of destination buffer in bytes
+ * \param dst_fmt  pixel format of destination buffer
+ * \param w        number of pixels per line to convert
+ * \param h        number of lines to convert
+ *
+ * The alpha channel of RGBA8888 pixels converted from another format is set
+ * to 255. Converting between equal formats is the same as 'blit'.
+ */
+extern "C" void blit_convert(void const *src, unsigned src_w,
+                             enum Blit_format src_fmt,
+                             void *dst, unsigned dst_w,
+                             enum Blit_format dst_fmt, int w, int h);
+
+
+/**
+ * Composite RGBA8888 pixels over destination buffer
+ *
+ * \param src      address of source buffer with non-premultiplied alpha
+ * \param src_w    line length of source buffer in bytes
+ * \param dst      address of destination buffer
+ * \param dst_w    line length of destination buffer in bytes
+ * \param dst_fmt  pixel format of destination buffer, BLIT_RGB565 or
+ *                 BLIT_RGBA8888
+ * \param w        number of pixels per line
+ * \param h        number of lines
+ *
+ * Each destination pixel becomes 'src*a + dst*(255 - a)' with 'a' being the
+ * alpha value of the source pixel. The alpha channel of RGBA8888
+ * destination pixels is left unchanged.
+ */
+extern "C" void blit_alpha(void const *src, unsigned src_w,
+                           void *dst, unsigned dst_w,
+                           enum Blit_format dst_fmt, int w, int h);
+
+
+/**
+ * Sets of blitting kernels
+ *
+ * By default, the fastest set supported by the CPU is used. The set is
+ * determined on the first use of the library.
+ */
+enum Blit_kernels {
+	BLIT_KERNELS_AUTO, BLIT_KERNELS_GENERIC, BLIT_KERNELS_SSE2,
+	BLIT_KERNELS_AVX2, BLIT_KERNELS_NEON
+};
+
+
+/**
+ * Select set of blitting kernels, e.g., for benchmarking
+ *
+ * \return  0 on success, -1 if the set is not supported by the CPU
+ */
+extern "C" int blit_select_kernels(enum Blit_kernels kernels);
+
+
+/**
+ * Return name of the selected set of kernels
+ */
+extern "C" char const *blit_kernels_name(void);
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
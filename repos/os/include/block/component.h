@@ -75,18 +75,49 @@ class Block::Session_component : public Block::Session_component_base,
 		Packet_descriptor                    _p_to_handle;
 		unsigned                             _p_in_fly;
 
+		/*
+		 * Acknowledgements produced while processing submitted packets are
+		 * collected and handed to the client as one batch
+		 */
+		enum { ACK_BATCH_SIZE = 32 };
+		Packet_descriptor                    _ack_batch[ACK_BATCH_SIZE];
+		unsigned                             _ack_batch_cnt;
+		bool                                 _batch_acks;
+
+		/**
+		 * Pass collected acknowledgements to the client
+		 */
+		void _flush_acks()
+		{
+			if (!_ack_batch_cnt)
+				return;
+
+			tx_sink()->acknowledge_packets(_ack_batch, _ack_batch_cnt);
+			_ack_batch_cnt = 0;
+		}
+
 		/**
 		 * Acknowledge a packet already handled
 		 */
 		inline void _ack_packet(Packet_descriptor &packet)
 		{
-			if (!tx_sink()->ready_to_ack())
+			if (tx_sink()->ack_slots_free() <= _ack_batch_cnt)
 				PERR("Not ready to ack!");
 
-			tx_sink()->acknowledge_packet(packet);
+			_ack_batch[_ack_batch_cnt++] = packet;
 			_p_in_fly--;
+
+			if (!_batch_acks || _ack_batch_cnt == ACK_BATCH_SIZE)
+				_flush_acks();
 		}
 
+		/**
+		 * Return true if the ack queue cannot take the acknowledgements of
+		 * all packets in flight
+		 */
+		bool _ack_queue_exhausted() {
+			return _p_in_fly + _ack_batch_cnt >= tx_sink()->ack_slots_free(); }
+
 		/**
 		 * Range check packet request
 		 */
@@ -152,16 +183,24 @@ class Block::Session_component : public Block::Session_component_base,
 		 */
 		void _packet_avail(unsigned)
 		{
+			bool const batch_acks = _batch_acks;
+			_batch_acks = true;
+
 			/*
 			 * as long as more packets are available, and we're able to ack
 			 * them, and the driver's request queue isn't full,
 			 * direct the packet request to the driver backend
 			 */
-			for (_ack_queue_full = (_p_in_fly >= tx_sink()->ack_slots_free());
+			for (_ack_queue_full = _ack_queue_exhausted();
 			     !_req_queue_full && !_ack_queue_full
 			     && tx_sink()->packet_avail();
-				 _ack_queue_full = (++_p_in_fly >= tx_sink()->ack_slots_free()))
+				 _ack_queue_full = (++_p_in_fly, _ack_queue_exhausted()))
 				_handle_packet(tx_sink()->get_packet());
+
+			_batch_acks = batch_acks;
+
+			if (!_batch_acks)
+				_flush_acks();
 		}
 
 		/**
@@ -178,16 +217,20 @@ class Block::Session_component : public Block::Session_component_base,
 		 * \param driver          block driver backend
 		 * \param driver_factory  factory to create and destroy driver objects
 		 * \param ep              entrypoint handling this session component
+		 * \param queue_size      number of slots of the packet queues
 		 */
 		Session_component(Driver_factory           &driver_factory,
-		                  Server::Entrypoint       &ep, size_t buf_size)
+		                  Server::Entrypoint       &ep, size_t buf_size,
+		                  unsigned                  queue_size = TX_QUEUE_SIZE)
 		: Session_component_base(driver_factory, buf_size),
-		  Driver_session(_rq_ds, ep.rpc_ep()),
+		  Driver_session(_rq_ds, ep.rpc_ep(), queue_size),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
 		  _sink_ack(ep, *this, &Session_component::_ready_to_ack),
 		  _sink_submit(ep, *this, &Session_component::_packet_avail),
 		  _req_queue_full(false),
-		  _p_in_fly(0)
+		  _p_in_fly(0),
+		  _ack_batch_cnt(0),
+		  _batch_acks(false)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
@@ -265,6 +308,9 @@ class Block::Root : public Genode::Root_component<Block::Session_component,
 				Arg_string::find_arg(args, "ram_quota"  ).ulong_value(0);
 			size_t tx_buf_size =
 				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
+			unsigned tx_queue_size =
+				Arg_string::find_arg(args, "tx_queue_size")
+				.ulong_value(Block::Session::TX_QUEUE_SIZE);
 
 			/* delete ram quota by the memory needed for the session */
 			size_t session_size = max((size_t)4096,
@@ -284,8 +330,20 @@ class Block::Root : public Genode::Root_component<Block::Session_component,
 				throw Root::Quota_exceeded();
 			}
 
+			/*
+			 * The packet queues are located within the communication
+			 * buffer. Reject queue depths that leave no room for payload.
+			 */
+			if (Block::Session::Tx_policy::queues_size(tx_queue_size, tx_queue_size)
+			    >= tx_buf_size) {
+				PERR("'tx_buf_size' of %zd too small for 'tx_queue_size' %u",
+				     tx_buf_size, tx_queue_size);
+				throw Root::Quota_exceeded();
+			}
+
 			return new (md_alloc()) Session_component(_driver_factory,
-			                                          _ep, tx_buf_size);
+			                                          _ep, tx_buf_size,
+			                                          tx_queue_size);
 		}
 
 	public:
@@ -40,10 +40,12 @@ class Block::Driver_session : public Block::Session_rpc_object
 		 * \param tx_ds  dataspace used as communication buffer
 		 *               for the tx packet stream
 		 * \param ep     entry point used for packet-stream channel
+		 * \param tx_queue_size  number of slots of the packet queues
 		 */
 		Driver_session(Genode::Dataspace_capability tx_ds,
-		               Genode::Rpc_entrypoint &ep)
-		: Session_rpc_object(tx_ds, ep) { }
+		               Genode::Rpc_entrypoint &ep,
+		               unsigned tx_queue_size = TX_QUEUE_SIZE)
+		: Session_rpc_object(tx_ds, ep, tx_queue_size) { }
 
 		/**
 		 * Acknowledges a packet processed by the driver to the client
@@ -28,14 +28,23 @@ namespace Block {
 		 * \param tx_buffer_alloc  allocator used for managing the
 		 *                         transmission buffer
 		 * \param tx_buf_size      size of transmission buffer in bytes
+		 * \param tx_queue_size    number of requests that can be in flight
+		 *
+		 * The packet queues are located within the transmission buffer.
+		 * Hence, a larger 'tx_queue_size' reduces the space available for
+		 * payload. The server rejects the session if the queues do not fit.
+		 * A server may ignore the requested 'tx_queue_size'. The queue size
+		 * in effect is published by the server within the transmission
+		 * buffer and available via 'tx()->submit_queue_size()'.
 		 */
 		Connection(Genode::Range_allocator *tx_block_alloc,
 		           Genode::size_t           tx_buf_size = 128*1024,
-		           const char              *label = "")
+		           const char              *label = "",
+		           unsigned                 tx_queue_size = TX_QUEUE_SIZE)
 		:
 			Genode::Connection<Session>(
-				session("ram_quota=%zd, tx_buf_size=%zd, label=\"%s\"",
-				        3*4096 + tx_buf_size, tx_buf_size, label)),
+				session("ram_quota=%zd, tx_buf_size=%zd, tx_queue_size=%u, label=\"%s\"",
+				        3*4096 + tx_buf_size, tx_buf_size, tx_queue_size, label)),
 			Session_client(cap(), tx_block_alloc) { }
 	};
 }
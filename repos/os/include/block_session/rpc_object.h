@@ -34,10 +34,12 @@ namespace Block {
 			 * \param tx_ds  dataspace used as communication buffer
 			 *               for the tx packet stream
 			 * \param ep     entry point used for packet-stream channel
+			 * \param tx_queue_size  number of slots of the packet queues
 			 */
 			Session_rpc_object(Genode::Dataspace_capability tx_ds,
-			                   Genode::Rpc_entrypoint &ep)
-			: _tx(tx_ds, ep) { }
+			                   Genode::Rpc_entrypoint &ep,
+			                   unsigned tx_queue_size = TX_QUEUE_SIZE)
+			: _tx(tx_ds, ep, tx_queue_size) { }
 
 			/**
 			 * Return capability to packet-stream channel
@@ -19,6 +19,14 @@
 namespace Genode {
 	void set_parent_cap_arch(void *ptr);
 	int binary_name(Dataspace_capability ds_cap, char *buf, size_t buf_size);
+
+	/**
+	 * Return true if data segments can be populated copy-on-write
+	 *
+	 * This requires write faults on read-only regions of a managed
+	 * dataspace to be reflected to the fault handler of the RM session.
+	 */
+	bool cow_data_arch();
 }
 
 #endif //_LDSO_ARCH_H_
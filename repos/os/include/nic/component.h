@@ -59,22 +59,23 @@ namespace Nic {
 					{
 						using namespace Genode;
 
+						enum { BATCH_SIZE = 32 };
+						Packet_descriptor packets[BATCH_SIZE];
+
 						while (true) {
 
-							/* block for packet from client */
-							Packet_descriptor packet = _tx_sink->get_packet();
-							if (!packet.valid()) {
-								PWRN("received invalid packet");
-								continue;
-							}
+							/* block for packets from client */
+							unsigned const num =
+								_tx_sink->get_packets(packets, BATCH_SIZE);
 
-							_driver.tx(_tx_sink->packet_content(packet),
-							           packet.size());
+							for (unsigned i = 0; i < num; i++)
+								_driver.tx(_tx_sink->packet_content(packets[i]),
+								           packets[i].size());
 
-							/* acknowledge packet to the client */
-							if (!_tx_sink->ready_to_ack())
+							/* acknowledge packets to the client */
+							if (_tx_sink->ack_slots_free() < num)
 								PDBG("need to wait until ready-for-ack");
-							_tx_sink->acknowledge_packet(packet);
+							_tx_sink->acknowledge_packets(packets, num);
 						}
 					}
 			} _tx_thread;
@@ -142,11 +143,16 @@ namespace Nic {
 			void submit()
 			{
 				/* check for acknowledgements from the client */
+				enum { ACK_BATCH_SIZE = 32 };
+				Packet_descriptor acked[ACK_BATCH_SIZE];
+
 				while (_rx.source()->ack_avail()) {
-					Packet_descriptor packet = _rx.source()->get_acked_packet();
+					unsigned const num =
+						_rx.source()->get_acked_packets(acked, ACK_BATCH_SIZE);
 
-					/* free packet buffer */
-					_rx.source()->release_packet(packet);
+					/* free packet buffers */
+					for (unsigned i = 0; i < num; i++)
+						_rx.source()->release_packet(acked[i]);
 				}
 
 				dump();
@@ -34,14 +34,16 @@ namespace Genode {
 			Time             _deadline;       /* next deadline                */
 			Time             _period;         /* duration between alarms      */
 			int              _active;         /* set to one when active       */
-			Alarm           *_next;           /* next alarm in alarm list     */
+			Alarm           *_child;          /* first child in alarm heap    */
+			Alarm           *_sibling;        /* next sibling in alarm heap   */
+			Alarm           *_prev;           /* parent or previous sibling   */
 			Alarm_scheduler *_scheduler;      /* currently assigned scheduler */
 
 			void _assign(Time period, Time deadline, Alarm_scheduler *scheduler) {
 				_period = period, _deadline = deadline, _scheduler = scheduler; }
 
 			void _reset() {
-				_assign(0, 0, 0), _active = 0, _next = 0; }
+				_assign(0, 0, 0), _active = 0, _child = _sibling = _prev = 0; }
 
 		protected:
 
@@ -62,14 +64,43 @@ namespace Genode {
 	};
 
 
+	/**
+	 * Scheduler of alarms
+	 *
+	 * The alarms are kept in a pairing heap ordered by their deadlines.
+	 * Scheduling an alarm takes constant time, discarding an alarm and
+	 * removing the alarm with the earliest deadline take logarithmic time
+	 * (amortized). The heap is linked via the alarm objects and needs no
+	 * memory allocation.
+	 */
 	class Alarm_scheduler
 	{
 		private:
 
-			Lock         _lock;   /* protect alarm list                       */
-			Alarm       *_head;   /* head of alarm list                       */
+			Lock         _lock;   /* protect alarm heap                       */
+			Alarm       *_head;   /* root of alarm heap, earliest deadline    */
 			Alarm::Time  _now;    /* recent time (updated by handle function) */
 
+			/**
+			 * Return true if deadline 'a' precedes deadline 'b'
+			 *
+			 * The comparison is robust against the wrap-around of the time.
+			 */
+			static bool _before(Alarm::Time a, Alarm::Time b) {
+				return (long)(a - b) < 0; }
+
+			/**
+			 * Meld two heaps
+			 *
+			 * \return  root of the resulting heap
+			 */
+			static Alarm *_meld(Alarm *a, Alarm *b);
+
+			/**
+			 * Meld list of sibling heaps into one heap
+			 */
+			static Alarm *_merge_pairs(Alarm *first);
+
 			/**
 			 * Enqueue alarm into alarm queue
 			 *
@@ -83,7 +114,7 @@ namespace Genode {
 			void _unsynchronized_dequeue(Alarm *alarm);
 
 			/**
-			 * Dequeue next pending alarm from alarm list
+			 * Dequeue next pending alarm from alarm heap
 			 *
 			 * \return  dequeued pending alarm
 			 * \retval  0  no alarm pending
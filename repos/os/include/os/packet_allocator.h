@@ -17,6 +17,7 @@
 
 #include <base/allocator.h>
 #include <util/bit_array.h>
+#include <util/misc_math.h>
 
 namespace Genode {
 	class Packet_allocator;
@@ -26,19 +27,52 @@ namespace Genode {
 /**
  * This allocator is designed to be used as packet allocator for the
  * packet stream interface. It uses a minimal block size, which is the
- * granularity packets will be allocated with. As backend, it uses a
- * simple bit array to manage free, and allocated blocks.
+ * granularity packets will be allocated with.
+ *
+ * Free blocks are managed by a binary buddy scheme. Each free chunk
+ * consists of a power-of-two number of blocks and is naturally aligned
+ * to its size. For each chunk size, there is a list of free chunks.
+ * An allocation takes the smallest chunk that fits and hands back the
+ * unused tail, a free merges the freed blocks with free buddies. Both
+ * operations are bounded by the number of chunk sizes instead of the
+ * number of blocks.
+ *
+ * A bit array records the allocated blocks to detect invalid frees.
+ * All meta data is kept apart from the managed range because the bulk
+ * buffer of a packet stream is shared with the peer.
  */
 class Genode::Packet_allocator : public Genode::Range_allocator
 {
 	private:
 
+		enum {
+			NONE      = ~0U,
+			MAX_ORDER = 8*sizeof(unsigned) - 1
+		};
+
+		/**
+		 * Meta data of a block
+		 *
+		 * Only the first block of a free chunk has a valid 'order', for all
+		 * other blocks it is 'NONE'. The list pointers are valid for the
+		 * first block of a free chunk only.
+		 */
+		struct Block
+		{
+			unsigned order; /* log2 of block count of free chunk */
+			unsigned prev;  /* previous chunk in free list       */
+			unsigned next;  /* next chunk in free list           */
+		};
+
 		Allocator      *_md_alloc;   /* meta-data allocator                 */
 		size_t          _block_size; /* granularity of packet allocations   */
 		void           *_bits;       /* memory chunk containing the bits    */
-		Bit_array_base *_array;      /* bit array managing available blocks */
+		Bit_array_base *_array;      /* bit array managing allocated blocks */
 		addr_t          _base;       /* allocation base                     */
-		addr_t          _next;       /* next free bit index                 */
+		unsigned        _cnt;        /* number of managed blocks            */
+		unsigned        _free_cnt;   /* number of free blocks               */
+		Block          *_blocks;     /* meta data of all blocks             */
+		unsigned        _free[MAX_ORDER + 1]; /* free lists per order       */
 
 		/*
 		 * Returns the count of blocks fitting the given size
@@ -52,6 +86,87 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 			return bytes - (bytes % (sizeof(addr_t)*8));
 		}
 
+		/**
+		 * Return number of blocks occupied by a packet of 'size' bytes
+		 */
+		size_t _packet_blocks(size_t size) const
+		{
+			size_t const cnt = (size % _block_size) ? size / _block_size + 1
+			                                        : size / _block_size;
+			return cnt ? cnt : 1;
+		}
+
+		/**
+		 * Return order of the smallest chunk holding 'cnt' blocks
+		 */
+		static unsigned _order(unsigned cnt)
+		{
+			unsigned const order = log2(cnt);
+			return (1U << order) < cnt ? order + 1 : order;
+		}
+
+		void _enqueue(unsigned i, unsigned order)
+		{
+			Block &b = _blocks[i];
+			b.order = order;
+			b.prev  = NONE;
+			b.next  = _free[order];
+
+			if (b.next != NONE)
+				_blocks[b.next].prev = i;
+
+			_free[order] = i;
+		}
+
+		void _dequeue(unsigned i)
+		{
+			Block &b = _blocks[i];
+
+			if (b.prev != NONE)
+				_blocks[b.prev].next = b.next;
+			else
+				_free[b.order] = b.next;
+
+			if (b.next != NONE)
+				_blocks[b.next].prev = b.prev;
+
+			b.order = NONE;
+		}
+
+		/**
+		 * Put free chunk into free lists, merging it with free buddies
+		 */
+		void _release_chunk(unsigned i, unsigned order)
+		{
+			for (; order < MAX_ORDER; order++) {
+				unsigned const buddy = i ^ (1U << order);
+
+				if (buddy >= _cnt || _blocks[buddy].order != order)
+					break;
+
+				_dequeue(buddy);
+				i &= ~(1U << order);
+			}
+			_enqueue(i, order);
+		}
+
+		/**
+		 * Put range of free blocks into free lists
+		 *
+		 * The range is split into the largest naturally aligned chunks.
+		 */
+		void _release_range(unsigned i, unsigned cnt)
+		{
+			while (cnt) {
+				unsigned const align = i ? log2(i & -i) : (unsigned)MAX_ORDER;
+				unsigned const order = min(align, log2(cnt));
+
+				_release_chunk(i, order);
+				i   += 1U << order;
+				cnt -= 1U << order;
+			}
+		}
+
 	public:
 
 		/**
@@ -62,7 +177,12 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		 */
 		Packet_allocator(Allocator *md_alloc, size_t block_size)
 		: _md_alloc(md_alloc), _block_size(block_size), _bits(0),
-		  _array(nullptr), _base(0) {}
+		  _array(nullptr), _base(0), _cnt(0), _free_cnt(0),
+		  _blocks(nullptr)
+		{
+			for (unsigned o = 0; o <= MAX_ORDER; o++)
+				_free[o] = NONE;
+		}
 
 
 		/*******************************
@@ -74,10 +194,17 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 			if (_base || _array) return -1;
 
 			_base  = base;
-			_bits  = _md_alloc->alloc(_block_cnt(size)/8);
-			_array = new (_md_alloc) Bit_array_base(_block_cnt(size),
-			                                        (addr_t*)_bits,
+			_cnt   = _block_cnt(size);
+			_bits  = _md_alloc->alloc(_cnt/8);
+			_array = new (_md_alloc) Bit_array_base(_cnt, (addr_t*)_bits,
 			                                        true);
+
+			_blocks = (Block *)_md_alloc->alloc(_cnt*sizeof(Block));
+			for (unsigned i = 0; i < _cnt; i++)
+				_blocks[i].order = NONE;
+
+			_release_range(0, _cnt);
+			_free_cnt = _cnt;
 			return 0;
 		}
 
@@ -85,8 +212,20 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		{
 			if (_base != base) return -1;
 
-			if (_array) destroy(_md_alloc, _array);
-			if (_bits)  _md_alloc->free(_bits, _block_cnt(size)/8);
+			if (_array)  destroy(_md_alloc, _array);
+			if (_bits)   _md_alloc->free(_bits, _cnt/8);
+			if (_blocks) _md_alloc->free(_blocks, _cnt*sizeof(Block));
+
+			_array  = nullptr;
+			_bits   = nullptr;
+			_blocks = nullptr;
+			_base     = 0;
+			_cnt      = 0;
+			_free_cnt = 0;
+
+			for (unsigned o = 0; o <= MAX_ORDER; o++)
+				_free[o] = NONE;
+
 			return 0;
 		}
 
@@ -96,42 +235,47 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 
 		bool alloc(size_t size, void **out_addr)
 		{
-			addr_t const cnt = (size % _block_size) ? size / _block_size + 1
-			                                        : size / _block_size;
-			addr_t max = ~0UL;
+			if (!_blocks) return false;
+
+			size_t const blocks = _packet_blocks(size);
+			if (blocks > _free_cnt) return false;
+
+			/* fits in 'unsigned' because '_free_cnt' does */
+			unsigned const cnt = blocks;
+
+			/* look up smallest free chunk that fits */
+			unsigned order = _order(cnt);
+			for (; order <= MAX_ORDER && _free[order] == NONE; order++);
 
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(cnt - 1); i < max; i += cnt) {
-						if (_array->get(i, cnt))
-							continue;
+			if (order > MAX_ORDER) return false;
 
-						_array->set(i, cnt);
-						_next = i + cnt;
-						*out_addr = reinterpret_cast<void *>(i * _block_size
-						                                     + _base);
-						return true;
-					}
-				} catch (typename Bit_array_base::Invalid_index_access) { }
+			unsigned const i = _free[order];
+			_dequeue(i);
 
-				max = _next;
-				_next = 0;
+			/* hand back the unused tail of the chunk */
+			_release_range(i + cnt, (1U << order) - cnt);
 
-			} while (max != 0);
+			_array->set(i, cnt);
+			_free_cnt -= cnt;
 
-			return false;
+			*out_addr = reinterpret_cast<void *>(i * _block_size + _base);
+			return true;
 		}
 
 		void free(void *addr, size_t size)
 		{
-			addr_t i   = (((addr_t)addr) - _base) / _block_size;
-			size_t cnt = (size % _block_size) ? size / _block_size + 1
-			                                  : size / _block_size;
+			addr_t const i   = (((addr_t)addr) - _base) / _block_size;
+			size_t const cnt = _packet_blocks(size);
+
+			/* throws exception if the blocks are not allocated */
 			_array->clear(i, cnt);
-			_next = i;
+
+			_release_range(i, cnt);
+			_free_cnt += cnt;
 		}
 
+		size_t avail() { return _free_cnt*_block_size; }
+
 
 		/*********************
 		 ** Dummy functions **
@@ -140,7 +284,6 @@ class Genode::Packet_allocator : public Genode::Range_allocator
 		bool need_size_for_free() const override { return false; }
 		void free(void *addr) { }
 		size_t overhead(size_t) {  return 0;}
-		size_t avail() { return 0; }
 		bool valid_addr(addr_t) { return 0; }
 		Alloc_return alloc_addr(size_t, addr_t) {
 			return Alloc_return(Alloc_return::OUT_OF_METADATA); }
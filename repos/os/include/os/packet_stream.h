@@ -61,8 +61,20 @@
  * acknowledge buffers using the functions 'packet_avail',
  * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
  *
+ * Packets can be exchanged in batches using 'submit_packets', 'get_packets',
+ * 'acknowledge_packets', and 'get_acked_packets'. The descriptors of a batch
+ * are published to the other side at once. The 'packet_avail' and
+ * 'ack_avail' signals are delivered only if a batch is placed into an empty
+ * queue, and the 'ready_to_submit' and 'ready_to_ack' signals only if a
+ * batch is taken from a full queue. Hence, a batch costs at most one signal.
+ *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
+ *
+ * The submit and acknowledgement queues are lock-free single-producer/
+ * single-consumer rings. Each side of a packet stream must therefore be
+ * operated by only one thread at a time. Components that access one side of
+ * a packet stream from multiple threads must serialize those accesses.
  */
 
 /*
@@ -80,6 +92,7 @@
 #include <base/signal.h>
 #include <dataspace/client.h>
 #include <util/string.h>
+#include <util/misc_math.h>
 
 
 /**
@@ -124,16 +137,64 @@ class Packet_descriptor
 /**
  * Ring buffer shared between source and sink, containing packet descriptors
  *
+ * The queue is a single-producer/single-consumer ring. The producer solely
+ * writes the head index and the consumer solely writes the tail index. Both
+ * indices are free-running counters, which are reduced to slot positions
+ * by masking. Hence, the queue size must be a power of two. Each index
+ * resides in a cache line of its own to prevent producer and consumer from
+ * contending for the same cache line.
+ *
+ * The queue content is published with release semantics and observed with
+ * acquire semantics. Therefore, no lock is needed as long as each side of the
+ * queue is operated by only one thread at a time.
+ *
+ * The number of queue slots is determined at construction time. Because
+ * the shared memory is accessible by the other side, the queue size is kept
+ * in the local 'Packet_descriptor_queue' object only. Both sides must
+ * construct their queue objects with the same size, which is ensured by
+ * the header of the communication buffer (see 'Packet_stream_base').
+ *
  * This class is private to the packet-stream interface.
  */
 template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
 class Packet_descriptor_queue
 {
+	public:
+
+		enum {
+			DEFAULT_SIZE    = QUEUE_SIZE,
+			MIN_SIZE        = 2,
+			MAX_SIZE        = 1 << 16,
+			CACHE_LINE_SIZE = 64
+		};
+
+		static_assert(QUEUE_SIZE >= MIN_SIZE && QUEUE_SIZE <= MAX_SIZE
+		              && (QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0,
+		              "packet-descriptor queue size must be a power of two");
+
 	private:
 
-		unsigned          _head;
-		unsigned          _tail;
-		PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
+		/**
+		 * Layout of the queue within the shared memory
+		 */
+		struct Shared
+		{
+			unsigned head __attribute__((aligned(CACHE_LINE_SIZE)));
+			unsigned tail __attribute__((aligned(CACHE_LINE_SIZE)));
+
+			/* the descriptor array follows in the next cache line */
+		} __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		Shared            * const _shared;
+		PACKET_DESCRIPTOR * const _queue;
+		unsigned            const _size;
+		unsigned            const _mask;
+
+		static unsigned _load_acquire(unsigned const &index) {
+			return __atomic_load_n(&index, __ATOMIC_ACQUIRE); }
+
+		static void _store_release(unsigned &index, unsigned value) {
+			__atomic_store_n(&index, value, __ATOMIC_RELEASE); }
 
 	public:
 
@@ -141,83 +202,169 @@ class Packet_descriptor_queue
 
 		enum Role { PRODUCER, CONSUMER };
 
+		/**
+		 * Return supported queue size for the requested number of slots
+		 *
+		 * The size is rounded down to a power of two and clamped to the
+		 * range of 'MIN_SIZE' to 'MAX_SIZE'. Both sides of a packet stream
+		 * apply this function to the same requested size and thereby arrive
+		 * at the same effective size.
+		 */
+		static unsigned size(unsigned requested)
+		{
+			if (requested <= MIN_SIZE) return MIN_SIZE;
+			if (requested >= MAX_SIZE) return MAX_SIZE;
+
+			return 1U << Genode::log2(requested);
+		}
+
+		/**
+		 * Return size of shared memory needed for a queue of 'size' slots
+		 */
+		static Genode::size_t bytes(unsigned size)
+		{
+			return Genode::align_addr(sizeof(Shared)
+			                          + size*sizeof(PACKET_DESCRIPTOR),
+			                          Genode::log2((unsigned)CACHE_LINE_SIZE));
+		}
+
 		/**
 		 * Constructor
 		 *
+		 * \param base  local address of the queue within the shared memory
+		 * \param size  number of queue slots, normalized via 'size()'
+		 * \param role  role of the local side
+		 *
 		 * Because the 'Packet_descriptor_queue' is constructed twice (at the
-		 * source and at the sink) inside a shared-memory block, the
+		 * source and at the sink) for the same shared-memory block, the
 		 * constructor must know the role of the instance to initialize only
 		 * those members that are driven by the respective role.
 		 */
-		Packet_descriptor_queue(Role role)
+		Packet_descriptor_queue(void *base, unsigned size, Role role)
+		:
+			_shared((Shared *)base),
+			_queue((PACKET_DESCRIPTOR *)((Genode::addr_t)base + sizeof(Shared))),
+			_size(size), _mask(size - 1)
 		{
 			if (role == PRODUCER) {
-				_head = 0;
-				Genode::memset(_queue, 0, sizeof(_queue));
+				_shared->head = 0;
+				Genode::memset(_queue, 0, _size*sizeof(PACKET_DESCRIPTOR));
 			} else
-				_tail = 0;
+				_shared->tail = 0;
 		}
 
+		/**
+		 * Return number of queue slots
+		 */
+		unsigned size() const { return _size; }
+
 		/**
 		 * Place packet descriptor into queue
 		 *
 		 * \return true on success, or
 		 *         false if queue is full
+		 *
+		 * Must be called by the producer only.
+		 */
+		bool add(PACKET_DESCRIPTOR packet) { return add(&packet, 1) == 1; }
+
+		/**
+		 * Place up to 'n' packet descriptors into queue
+		 *
+		 * \return  number of added packet descriptors
+		 *
+		 * All added descriptors are published to the consumer at once. Must
+		 * be called by the producer only.
 		 */
-		bool add(PACKET_DESCRIPTOR packet)
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned n)
 		{
-			if (full()) return false;
+			unsigned const count = Genode::min(n, slots_free());
+			unsigned const head  = _shared->head;
 
-			_queue[_head%QUEUE_SIZE] = packet;
-			_head = (_head + 1)%QUEUE_SIZE;
-			return true;
+			for (unsigned i = 0; i < count; i++)
+				_queue[(head + i) & _mask] = packets[i];
+
+			_store_release(_shared->head, head + count);
+			return count;
 		}
 
 		/**
 		 * Take packet descriptor from queue
 		 *
 		 * \return  packet descriptor
+		 *
+		 * Must be called by the consumer only and only if the queue is not
+		 * empty.
 		 */
 		PACKET_DESCRIPTOR get()
 		{
-			PACKET_DESCRIPTOR packet = _queue[_tail%QUEUE_SIZE];
-			_tail = (_tail + 1)%QUEUE_SIZE;
+			PACKET_DESCRIPTOR packet;
+			get(&packet, 1);
 			return packet;
 		}
 
 		/**
-		 * Return true if packet-descriptor queue is empty
+		 * Take up to 'max' packet descriptors from queue
+		 *
+		 * \return  number of packet descriptors taken
+		 *
+		 * Must be called by the consumer only.
 		 */
-		bool empty() { return _tail == _head; }
+		unsigned get(PACKET_DESCRIPTOR *packets, unsigned max)
+		{
+			unsigned const count = Genode::min(max, slots_used());
+			unsigned const tail  = _shared->tail;
+
+			for (unsigned i = 0; i < count; i++)
+				packets[i] = _queue[(tail + i) & _mask];
+
+			_store_release(_shared->tail, tail + count);
+			return count;
+		}
 
 		/**
-		 * Return true if packet-descriptor queue is full
+		 * Order preceding index updates before subsequent index reads
+		 *
+		 * After updating its own index, a side must issue this barrier before
+		 * inspecting the queue state to decide whether the other side must be
+		 * woken up. Otherwise, both sides may miss each other's update and
+		 * block forever.
 		 */
-		bool full() { return (_head + 1)%QUEUE_SIZE == _tail; }
+		static void sync() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
 
 		/**
-		 * Return true if a single element is stored in the queue
+		 * Return number of queued elements
 		 */
-		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
+		unsigned slots_used() {
+			return _load_acquire(_shared->head) - _load_acquire(_shared->tail); }
 
+		/**
+		 * Return true if packet-descriptor queue is empty
+		 */
+		bool empty() { return slots_used() == 0; }
 
 		/**
-		 * Return true if a single slot is left to be put into the queue
+		 * Return true if packet-descriptor queue is full
 		 */
-		bool single_slot_free() { return (_head + 2)%QUEUE_SIZE == _tail; }
+		bool full() { return slots_used() >= _size; }
 
 		/**
 		 * Return number of slots left to be put into the queue
 		 */
-		unsigned slots_free() {
-			return ((_tail > _head) ? _tail - _head
-			                        : QUEUE_SIZE - _head + _tail) - 1; }
+		unsigned slots_free()
+		{
+			unsigned const used = slots_used();
+			return used >= _size ? 0 : _size - used;
+		}
 };
 
 
 /**
  * Transmit packet descriptors with data-flow control
  *
+ * The transmitter takes no lock. The caller must ensure that only one thread
+ * at a time transmits via the same transmitter.
+ *
  * This class is private to the packet-stream interface.
  */
 template <typename TX_QUEUE>
@@ -233,8 +380,7 @@ class Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Genode::Signal_transmitter         _rx_ready;
 
-		Genode::Lock _tx_queue_lock;
-		TX_QUEUE    *_tx_queue;
+		TX_QUEUE *_tx_queue;
 
 	public:
 
@@ -272,15 +418,21 @@ class Packet_descriptor_transmitter
 
 		bool ready_for_tx()
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
 			return !_tx_queue->full();
 		}
 
-		void tx(typename TX_QUEUE::Packet_descriptor packet)
+		/**
+		 * Transmit 'n' packet descriptors
+		 *
+		 * The function blocks until all descriptors are placed into the
+		 * queue. The receiver gets signalled only if descriptors are placed
+		 * into the empty queue, i.e., at most once per portion of
+		 * descriptors that fits into the queue.
+		 */
+		void tx(typename TX_QUEUE::Packet_descriptor const *packets, unsigned n)
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			while (n > 0) {
 
-			do {
 				/* block for signal if tx queue is full */
 				if (_tx_queue->full())
 					_tx_ready.wait_for_signal();
@@ -290,13 +442,23 @@ class Packet_descriptor_transmitter
 				 * current queue situation. Therefore, we need to double check
 				 * if the queue insertion succeeds and retry if needed.
 				 */
+				unsigned const added = _tx_queue->add(packets, n);
+				if (!added)
+					continue;
 
-			} while (_tx_queue->add(packet) == false);
+				TX_QUEUE::sync();
 
-			if (_tx_queue->single_element())
-				_rx_ready.submit();
+				/* the queue was empty if no other element is present */
+				if (_tx_queue->slots_used() == added)
+					_rx_ready.submit();
+
+				packets += added;
+				n       -= added;
+			}
 		}
 
+		void tx(typename TX_QUEUE::Packet_descriptor packet) { tx(&packet, 1); }
+
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
@@ -307,6 +469,9 @@ class Packet_descriptor_transmitter
 /**
  * Receive packet descriptors with data-flow control
  *
+ * The receiver takes no lock. The caller must ensure that only one thread
+ * at a time receives via the same receiver.
+ *
  * This class is private to the packet-stream interface.
  */
 template <typename RX_QUEUE>
@@ -322,8 +487,7 @@ class Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Genode::Signal_transmitter         _tx_ready;
 
-		Genode::Lock _rx_queue_lock;
-		RX_QUEUE    *_rx_queue;
+		RX_QUEUE *_rx_queue;
 
 	public:
 
@@ -361,22 +525,39 @@ class Packet_descriptor_receiver
 
 		bool ready_for_rx()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
 			return !_rx_queue->empty();
 		}
 
-		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
+		/**
+		 * Receive up to 'max' packet descriptors
+		 *
+		 * \return  number of received descriptors
+		 *
+		 * The function blocks until at least one descriptor is available.
+		 * The transmitter gets signalled only if the descriptors are taken
+		 * from the full queue.
+		 */
+		unsigned rx(typename RX_QUEUE::Packet_descriptor *out_packets, unsigned max)
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			if (max == 0)
+				return 0;
 
 			while (_rx_queue->empty())
 				_rx_ready.wait_for_signal();
 
-			*out_packet = _rx_queue->get();
+			unsigned const taken = _rx_queue->get(out_packets, max);
+
+			RX_QUEUE::sync();
 
-			if (_rx_queue->single_slot_free())
+			/* the queue was full if no other slot is free */
+			if (_rx_queue->slots_free() == taken)
 				_tx_ready.submit();
+
+			return taken;
 		}
+
+		void rx(typename RX_QUEUE::Packet_descriptor *out_packet) {
+			rx(out_packet, 1); }
 };
 
 
@@ -395,10 +576,34 @@ class Packet_stream_base
 		 */
 		class Transport_dataspace_too_small { };
 
+		/**
+		 * Queue size that denotes the use of the published queue sizes
+		 */
+		enum { PUBLISHED_QUEUE_SIZE = 0 };
+
+		/**
+		 * Header at the start of the communication buffer
+		 *
+		 * The server creates the communication buffer and constructs its
+		 * side of the packet stream before handing out the buffer. It
+		 * publishes the queue sizes it uses in the header. The client lays
+		 * out the buffer according to the published sizes. Hence, both
+		 * sides agree on the layout even if the server does not honor the
+		 * queue size requested by the client. The server never reads the
+		 * header back.
+		 */
+		struct Layout
+		{
+			unsigned submit_queue_size;
+			unsigned ack_queue_size;
+
+		} __attribute__((aligned(64)));
+
 	protected:
 
 		Genode::Dataspace_capability _ds_cap;
 		void                        *_ds_local_base;
+		Genode::size_t               _ds_size;
 
 		Genode::off_t  _submit_queue_offset;
 		Genode::off_t  _ack_queue_offset;
@@ -407,29 +612,66 @@ class Packet_stream_base
 
 		/**
 		 * Constructor
-		 *
-		 * \param submit_queue_size  submit queue size in bytes
-		 * \param ack_queue_size     acknowledgement queue size in bytes
-		 * \throw                    'Transport_dataspace_too_small'
 		 */
-		Packet_stream_base(Genode::Dataspace_capability transport_ds,
-		                   Genode::size_t submit_queue_size,
-		                   Genode::size_t ack_queue_size)
+		Packet_stream_base(Genode::Dataspace_capability transport_ds)
 		:
 			_ds_cap(transport_ds),
 
 			/* map dataspace locally */
 			_ds_local_base(Genode::env()->rm_session()->attach(_ds_cap)),
-			_submit_queue_offset(0),
-			_ack_queue_offset(_submit_queue_offset + submit_queue_size),
-			_bulk_buffer_offset(_ack_queue_offset + ack_queue_size)
+			_ds_size(Genode::Dataspace_client(_ds_cap).size()),
+			_submit_queue_offset(0), _ack_queue_offset(0),
+			_bulk_buffer_offset(0), _bulk_buffer_size(0)
+		{ }
+
+		/**
+		 * Lay out communication buffer
+		 *
+		 * \param submit_queue_size  requested number of submit-queue slots,
+		 *                           or 'PUBLISHED_QUEUE_SIZE'
+		 * \param ack_queue_size     requested number of ack-queue slots,
+		 *                           or 'PUBLISHED_QUEUE_SIZE'
+		 * \return                   effective queue sizes
+		 * \throw                    'Transport_dataspace_too_small'
+		 *
+		 * If both sizes are given, they are published in the header.
+		 * Otherwise, the published sizes are used.
+		 */
+		template <typename SUBMIT_QUEUE, typename ACK_QUEUE>
+		Layout _lay_out(unsigned submit_queue_size, unsigned ack_queue_size)
 		{
-			Genode::size_t ds_size = Genode::Dataspace_client(_ds_cap).size();
+			if (_ds_size < sizeof(Layout))
+				throw Transport_dataspace_too_small();
+
+			Layout volatile * const header = (Layout volatile *)_ds_local_base;
 
-			if ((Genode::size_t)_bulk_buffer_offset >= ds_size)
+			bool const publish = submit_queue_size != PUBLISHED_QUEUE_SIZE
+			                  && ack_queue_size    != PUBLISHED_QUEUE_SIZE;
+			if (!publish) {
+				submit_queue_size = header->submit_queue_size;
+				ack_queue_size    = header->ack_queue_size;
+			}
+
+			Layout layout;
+			layout.submit_queue_size = SUBMIT_QUEUE::size(submit_queue_size);
+			layout.ack_queue_size    = ACK_QUEUE::size(ack_queue_size);
+
+			if (publish) {
+				header->submit_queue_size = layout.submit_queue_size;
+				header->ack_queue_size    = layout.ack_queue_size;
+			}
+
+			_submit_queue_offset = sizeof(Layout);
+			_ack_queue_offset    = _submit_queue_offset
+			                     + SUBMIT_QUEUE::bytes(layout.submit_queue_size);
+			_bulk_buffer_offset  = _ack_queue_offset
+			                     + ACK_QUEUE::bytes(layout.ack_queue_size);
+
+			if ((Genode::size_t)_bulk_buffer_offset >= _ds_size)
 				throw Transport_dataspace_too_small();
 
-			_bulk_buffer_size = ds_size - _bulk_buffer_offset;
+			_bulk_buffer_size = _ds_size - _bulk_buffer_offset;
+			return layout;
 		}
 
 		/**
@@ -486,6 +728,23 @@ struct Packet_stream_policy
 
 	typedef Packet_descriptor_queue<PACKET_DESCRIPTOR, ACK_QUEUE_SIZE>
 	        Ack_queue;
+
+	/**
+	 * Return size of the communication buffer occupied by the queues and
+	 * the header
+	 *
+	 * \param submit_queue_size  requested number of submit-queue slots
+	 * \param ack_queue_size     requested number of ack-queue slots
+	 *
+	 * The remainder of the communication buffer is used as bulk buffer.
+	 */
+	static Genode::size_t queues_size(unsigned submit_queue_size = SUBMIT_QUEUE_SIZE,
+	                                  unsigned ack_queue_size    = ACK_QUEUE_SIZE)
+	{
+		return sizeof(Packet_stream_base::Layout)
+		     + Submit_queue::bytes(Submit_queue::size(submit_queue_size))
+		     + Ack_queue::bytes(Ack_queue::size(ack_queue_size));
+	}
 };
 
 
@@ -496,17 +755,6 @@ typedef Packet_stream_policy<Packet_descriptor, 64, 64, char>
         Default_packet_stream_policy;
 
 
-/**
- * Placement new operator for constructing packet-descriptor queues
- *
- * The third argument is only there to let the compiler choose this overloaded
- * new operator rather than Genode's new operator.
- *
- * This operator should not be used outside the packet-stream interface.
- */
-inline void *operator new(Genode::size_t size, void *addr, Packet_stream_base *) { return addr; }
-
-
 /**
  * Originator of a packet stream
  */
@@ -516,15 +764,19 @@ class Packet_stream_source : private Packet_stream_base
 	public:
 
 		typedef typename POLICY::Packet_descriptor Packet_descriptor;
+		typedef typename POLICY::Submit_queue      Submit_queue;
+		typedef typename POLICY::Ack_queue         Ack_queue;
 
 	private:
 
-		typedef typename POLICY::Submit_queue Submit_queue;
-		typedef typename POLICY::Ack_queue    Ack_queue;
 		typedef typename POLICY::Content_type Content_type;
 
 		Genode::Range_allocator *_packet_alloc;
 
+		Layout const _layout;
+		Submit_queue _submit_queue;
+		Ack_queue    _ack_queue;
+
 		Packet_descriptor_transmitter<Submit_queue> _submit_transmitter;
 		Packet_descriptor_receiver<Ack_queue>       _ack_receiver;
 
@@ -538,28 +790,40 @@ class Packet_stream_source : private Packet_stream_base
 		/**
 		 * Constructor
 		 *
-		 * \param transport_ds  dataspace used for communication buffer shared
-		 *                      between source and sink
-		 * \param packet_alloc  allocator for managing packet allocation within
-		 *                      the shared communication buffer
+		 * \param transport_ds       dataspace used for communication buffer
+		 *                           shared between source and sink
+		 * \param packet_alloc       allocator for managing packet allocation
+		 *                           within the shared communication buffer
+		 * \param submit_queue_size  number of submit-queue slots
+		 * \param ack_queue_size     number of ack-queue slots
 		 *
 		 * The 'packet_alloc' must not be pre-initialized. It will be
 		 * initialized by the constructor using dataspace-relative offsets
 		 * rather than pointers.
+		 *
+		 * The side that creates the communication buffer specifies the
+		 * queue sizes. The other side passes 'PUBLISHED_QUEUE_SIZE' to
+		 * adopt them.
 		 */
 		Packet_stream_source(Genode::Range_allocator      *packet_alloc,
-		                     Genode::Dataspace_capability  transport_ds_cap)
+		                     Genode::Dataspace_capability  transport_ds_cap,
+		                     unsigned submit_queue_size = Submit_queue::DEFAULT_SIZE,
+		                     unsigned ack_queue_size    = Ack_queue::DEFAULT_SIZE)
 		:
-			Packet_stream_base(transport_ds_cap,
-			                   sizeof(Submit_queue),
-			                   sizeof(Ack_queue)),
+			Packet_stream_base(transport_ds_cap),
 			_packet_alloc(packet_alloc),
+			_layout(_lay_out<Submit_queue, Ack_queue>(submit_queue_size,
+			                                          ack_queue_size)),
 
 			/* construct packet-descriptor queues */
-			_submit_transmitter(new (_submit_queue_local_base(), this)
-			                    Submit_queue(Submit_queue::PRODUCER)),
-			_ack_receiver(new (_ack_queue_local_base(), this)
-			              Ack_queue(Ack_queue::CONSUMER))
+			_submit_queue(_submit_queue_local_base(),
+			              _layout.submit_queue_size,
+			              Submit_queue::PRODUCER),
+			_ack_queue(_ack_queue_local_base(),
+			           _layout.ack_queue_size,
+			           Ack_queue::CONSUMER),
+			_submit_transmitter(&_submit_queue),
+			_ack_receiver(&_ack_queue)
 		{
 			/* initialize packet allocator */
 			_packet_alloc->add_range(_bulk_buffer_offset,
@@ -577,6 +841,16 @@ class Packet_stream_source : private Packet_stream_base
 		 */
 		Genode::size_t bulk_buffer_size() { return _bulk_buffer_size; }
 
+		/**
+		 * Return number of submit-queue slots
+		 */
+		unsigned submit_queue_size() const { return _submit_queue.size(); }
+
+		/**
+		 * Return number of ack-queue slots
+		 */
+		unsigned ack_queue_size() const { return _ack_queue.size(); }
+
 		/**
 		 * Register signal handler for receiving the signal that new packets
 		 * are available in the submit queue.
@@ -652,6 +926,12 @@ class Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.ready_for_tx();
 		}
 
+		/**
+		 * Returns number of slots left in the submit queue
+		 */
+		unsigned submit_slots_free() {
+			return _submit_transmitter.tx_slots_free(); }
+
 		/**
 		 * Tell sink about a packet to process
 		 */
@@ -660,6 +940,17 @@ class Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about a batch of packets to process
+		 *
+		 * This function blocks until all packets are placed into the submit
+		 * queue. The sink gets signalled at most once per batch.
+		 */
+		void submit_packets(Packet_descriptor const *packets, unsigned num)
+		{
+			_submit_transmitter.tx(packets, num);
+		}
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -675,6 +966,18 @@ class Packet_stream_source : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max' acknowledged packets
+		 *
+		 * \return  number of packets stored in 'packets'
+		 *
+		 * This function blocks if no acknowledgements are available.
+		 */
+		unsigned get_acked_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _ack_receiver.rx(packets, max);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -706,6 +1009,10 @@ class Packet_stream_sink : private Packet_stream_base
 
 	private:
 
+		Layout const _layout;
+		Submit_queue _submit_queue;
+		Ack_queue    _ack_queue;
+
 		Packet_descriptor_receiver<Submit_queue> _submit_receiver;
 		Packet_descriptor_transmitter<Ack_queue> _ack_transmitter;
 
@@ -714,20 +1021,44 @@ class Packet_stream_sink : private Packet_stream_base
 		/**
 		 * Constructor
 		 *
-		 * \param transport_ds  dataspace used for communication buffer shared between
-		 *                      source and sink
+		 * \param transport_ds       dataspace used for communication buffer
+		 *                           shared between source and sink
+		 * \param submit_queue_size  number of submit-queue slots
+		 * \param ack_queue_size     number of ack-queue slots
+		 *
+		 * The side that creates the communication buffer specifies the
+		 * queue sizes. The other side passes 'PUBLISHED_QUEUE_SIZE' to
+		 * adopt them.
 		 */
-		Packet_stream_sink(Genode::Dataspace_capability transport_ds)
+		Packet_stream_sink(Genode::Dataspace_capability transport_ds,
+		                   unsigned submit_queue_size = Submit_queue::DEFAULT_SIZE,
+		                   unsigned ack_queue_size    = Ack_queue::DEFAULT_SIZE)
 		:
-			Packet_stream_base(transport_ds, sizeof(Submit_queue), sizeof(Ack_queue)),
+			Packet_stream_base(transport_ds),
+			_layout(_lay_out<Submit_queue, Ack_queue>(submit_queue_size,
+			                                          ack_queue_size)),
 
 			/* construct packet-descriptor queues */
-			_submit_receiver(new (_submit_queue_local_base(), this)
-			                  Submit_queue(Submit_queue::CONSUMER)),
-			_ack_transmitter(new (_ack_queue_local_base(), this)
-			                 Ack_queue(Ack_queue::PRODUCER))
+			_submit_queue(_submit_queue_local_base(),
+			              _layout.submit_queue_size,
+			              Submit_queue::CONSUMER),
+			_ack_queue(_ack_queue_local_base(),
+			           _layout.ack_queue_size,
+			           Ack_queue::PRODUCER),
+			_submit_receiver(&_submit_queue),
+			_ack_transmitter(&_ack_queue)
 		{ }
 
+		/**
+		 * Return number of submit-queue slots
+		 */
+		unsigned submit_queue_size() const { return _submit_queue.size(); }
+
+		/**
+		 * Return number of ack-queue slots
+		 */
+		unsigned ack_queue_size() const { return _ack_queue.size(); }
+
 		/**
 		 * Register signal handler to notify that new acknowledgements
 		 * are available in the ack queue.
@@ -792,6 +1123,32 @@ class Packet_stream_sink : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max' packets from source
+		 *
+		 * \return  number of packets stored in 'packets'
+		 *
+		 * This function blocks if no packets are available. Packets that
+		 * do not refer to the bulk buffer are dropped.
+		 */
+		unsigned get_packets(Packet_descriptor *packets, unsigned max)
+		{
+			if (max == 0)
+				return 0;
+
+			for (;;) {
+				unsigned const num = _submit_receiver.rx(packets, max);
+
+				unsigned num_valid = 0;
+				for (unsigned i = 0; i < num; i++)
+					if (packet_valid(packets[i]))
+						packets[num_valid++] = packets[i];
+
+				if (num_valid)
+					return num_valid;
+			}
+		}
+
 		/**
 		 * Get pointer to the content of the specified packet
 		 *
@@ -826,6 +1183,19 @@ class Packet_stream_sink : private Packet_stream_base
 			_ack_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell the source that the processing of a batch of packets is
+		 * completed
+		 *
+		 * This function blocks until all acknowledgements are placed into the
+		 * acknowledgement queue. The source gets signalled at most once per
+		 * batch.
+		 */
+		void acknowledge_packets(Packet_descriptor const *packets, unsigned num)
+		{
+			_ack_transmitter.tx(packets, num);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -0,0 +1,400 @@
+/*
+ * \brief  Hash index of the paths of a read-only file-system tree
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__OS__PATH_INDEX_H_
+#define _INCLUDE__OS__PATH_INDEX_H_
+
+#include <base/allocator.h>
+#include <os/path.h>
+#include <util/construct_at.h>
+#include <util/string.h>
+
+namespace Genode { template <typename> class Path_index; }
+
+
+/**
+ * Index of all paths of a file-system tree, e.g., the content of a TAR archive
+ *
+ * \param T  type of the objects associated with the paths
+ *
+ * Each path of the tree is represented by an entry that is found by hashing
+ * the full path. Entries are created for all inserted paths and, implicitly,
+ * for all directories leading to them. The value of an implicitly created
+ * entry is 0 until the path gets inserted explicitly. The entry of the root
+ * directory always exists and is denoted by an empty path or "/".
+ *
+ * Paths are canonicalized before being hashed. So "./a//b/" and "/a/b"
+ * refer to the same entry.
+ *
+ * The entries and path strings are stored in an arena that grows in large
+ * chunks and is released as a whole when the index is destructed. The index
+ * is meant to be populated once, followed by a call of 'finalize', which
+ * turns the child lists of the directories into arrays. Thereafter, the
+ * N-th child of a directory is determined in constant time.
+ */
+template <typename T>
+class Genode::Path_index
+{
+	public:
+
+		enum { MAX_PATH_LEN = 512 };
+
+		class Entry
+		{
+			private:
+
+				friend class Path_index;
+
+				char const *_path;
+				char const *_name;
+				size_t      _path_len;
+				unsigned    _hash;
+				Entry      *_parent;
+				Entry      *_hash_next;
+				Entry      *_first_child;
+				Entry      *_last_child;
+				Entry      *_next_sibling;
+				Entry     **_children;
+				unsigned    _num_children;
+
+			public:
+
+				/**
+				 * Object associated with the path, 0 for implicit entries
+				 */
+				T *value;
+
+				Entry(char const *path, size_t path_len, unsigned hash,
+				      Entry *parent)
+				:
+					_path(path), _name(path), _path_len(path_len), _hash(hash),
+					_parent(parent), _hash_next(0), _first_child(0),
+					_last_child(0), _next_sibling(0), _children(0),
+					_num_children(0), value(0)
+				{
+					for (size_t i = 0; i < path_len; i++)
+						if (path[i] == '/')
+							_name = path + i + 1;
+				}
+
+				/**
+				 * Return canonical path without trailing slash
+				 *
+				 * The path of the root directory is the empty string.
+				 */
+				char const *path() const { return _path; }
+
+				/**
+				 * Return last path element
+				 */
+				char const *name() const { return _name; }
+
+				Entry *parent() const { return _parent; }
+
+				unsigned num_children() const { return _num_children; }
+
+				/**
+				 * Return child with the specified index
+				 *
+				 * The children are ordered by their insertion.
+				 *
+				 * \return  0 if the index is out of range
+				 */
+				Entry *child(unsigned index) const
+				{
+					if (index >= _num_children)
+						return 0;
+
+					if (_children)
+						return _children[index];
+
+					/* index not finalized yet */
+					Entry *e = _first_child;
+					for (; index; index--)
+						e = e->_next_sibling;
+					return e;
+				}
+		};
+
+	private:
+
+		enum {
+			CHUNK_SIZE      = 64*1024,
+			INITIAL_BUCKETS = 256,
+		};
+
+		struct Chunk
+		{
+			Chunk  *next;
+			size_t  size;
+			size_t  used;
+		};
+
+		Allocator &_alloc;
+
+		Chunk    *_chunks;
+		Entry   **_buckets;
+		unsigned  _num_buckets;
+		unsigned  _num_entries;
+		Entry     _root;
+
+		typedef Path<MAX_PATH_LEN> Canonical_path;
+
+		/**
+		 * Allocate memory from arena
+		 */
+		void *_arena_alloc(size_t size)
+		{
+			size = align_addr(size, log2(sizeof(addr_t)));
+
+			if (!_chunks || _chunks->used + size > _chunks->size) {
+
+				size_t const header     = align_addr(sizeof(Chunk), log2(sizeof(addr_t)));
+				size_t const chunk_size = max((size_t)CHUNK_SIZE, header + size);
+
+				Chunk *chunk = 0;
+				if (!_alloc.alloc(chunk_size, &chunk))
+					throw Allocator::Out_of_memory();
+
+				chunk->next = _chunks;
+				chunk->size = chunk_size;
+				chunk->used = header;
+				_chunks     = chunk;
+			}
+
+			void *ptr = (char *)_chunks + _chunks->used;
+			_chunks->used += size;
+			return ptr;
+		}
+
+		/**
+		 * FNV-1a hash of path string
+		 */
+		static unsigned _hash(char const *path, size_t len)
+		{
+			unsigned h = 2166136261U;
+			for (size_t i = 0; i < len; i++) {
+				h ^= (unsigned char)path[i];
+				h *= 16777619U;
+			}
+			return h;
+		}
+
+		void _resize(unsigned num_buckets)
+		{
+			Entry **buckets = 0;
+			if (!_alloc.alloc(num_buckets*sizeof(Entry *), &buckets))
+				throw Allocator::Out_of_memory();
+
+			memset(buckets, 0, num_buckets*sizeof(Entry *));
+
+			for (unsigned i = 0; i < _num_buckets; i++) {
+				while (Entry *e = _buckets[i]) {
+					_buckets[i] = e->_hash_next;
+
+					Entry *&head = buckets[e->_hash % num_buckets];
+					e->_hash_next = head;
+					head = e;
+				}
+			}
+
+			if (_buckets)
+				_alloc.free(_buckets, _num_buckets*sizeof(Entry *));
+
+			_buckets     = buckets;
+			_num_buckets = num_buckets;
+		}
+
+		Entry *_lookup(char const *path, size_t len, unsigned hash) const
+		{
+			if (len == 0)
+				return const_cast<Entry *>(&_root);
+
+			for (Entry *e = _buckets[hash % _num_buckets]; e; e = e->_hash_next)
+				if (e->_hash == hash && e->_path_len == len
+				 && memcmp(e->_path, path, len) == 0)
+					return e;
+
+			return 0;
+		}
+
+		/**
+		 * Return entry of canonical path, create it if needed
+		 *
+		 * \param path  canonical path, not null-terminated at 'len'
+		 */
+		Entry &_entry(char const *path, size_t len)
+		{
+			unsigned const hash = _hash(path, len);
+
+			if (Entry *e = _lookup(path, len, hash))
+				return *e;
+
+			/* create parent directory first */
+			size_t parent_len = len;
+			while (parent_len && path[parent_len - 1] != '/')
+				parent_len--;
+
+			Entry &parent = _entry(path, parent_len ? parent_len - 1 : 0);
+
+			char *path_copy = (char *)_arena_alloc(len + 1);
+			memcpy(path_copy, path, len);
+			path_copy[len] = 0;
+
+			Entry *e = construct_at<Entry>(_arena_alloc(sizeof(Entry)),
+			                               path_copy, len, hash, &parent);
+
+			/* append to children of parent, invalidate finalized array */
+			if (parent._last_child)
+				parent._last_child->_next_sibling = e;
+			else
+				parent._first_child = e;
+			parent._last_child = e;
+			parent._num_children++;
+			parent._children = 0;
+
+			Entry *&head = _buckets[hash % _num_buckets];
+			e->_hash_next = head;
+			head = e;
+
+			if (++_num_entries > _num_buckets)
+				_resize(_num_buckets*2);
+
+			return *e;
+		}
+
+		/**
+		 * Canonicalize path
+		 *
+		 * \return  length of canonical path, 0 for the root directory
+		 */
+		static size_t _canonicalize(char const *path, Canonical_path &out)
+		{
+			out.import(path);
+			out.remove_trailing('/');
+
+			/* the root is represented by the empty string */
+			char const *s = out.base();
+			return (s[0] == '/' && s[1] == 0) ? 0 : strlen(s);
+		}
+
+	public:
+
+		class Path_too_long : public Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  backing store of the arena and the hash table
+		 */
+		Path_index(Allocator &alloc)
+		:
+			_alloc(alloc), _chunks(0), _buckets(0), _num_buckets(0),
+			_num_entries(0), _root("", 0, 0, 0)
+		{
+			_resize(INITIAL_BUCKETS);
+		}
+
+		~Path_index()
+		{
+			while (Chunk *chunk = _chunks) {
+				_chunks = chunk->next;
+				_alloc.free(chunk, chunk->size);
+			}
+			_alloc.free(_buckets, _num_buckets*sizeof(Entry *));
+		}
+
+		/**
+		 * Insert path into index
+		 *
+		 * If the path is already present, its value is replaced.
+		 *
+		 * \throw Path_too_long
+		 * \throw Allocator::Out_of_memory
+		 */
+		Entry &insert(char const *path, T *value)
+		{
+			if (strlen(path) >= MAX_PATH_LEN - 1)
+				throw Path_too_long();
+
+			Canonical_path canonical("");
+			size_t const len = _canonicalize(path, canonical);
+
+			Entry &e = _entry(canonical.base(), len);
+			e.value = value;
+			return e;
+		}
+
+		/**
+		 * Look up entry of path
+		 *
+		 * \return  0 if the path is not present
+		 */
+		Entry *lookup(char const *path) const
+		{
+			if (strlen(path) >= MAX_PATH_LEN - 1)
+				return 0;
+
+			Canonical_path canonical("");
+			size_t const len = _canonicalize(path, canonical);
+
+			return _lookup(canonical.base(), len, _hash(canonical.base(), len));
+		}
+
+		Entry &root() { return _root; }
+
+		/**
+		 * Return number of entries, excluding the root
+		 */
+		unsigned num_entries() const { return _num_entries; }
+
+		/**
+		 * Apply functor to each entry, excluding the root
+		 */
+		template <typename FUNC>
+		void for_each(FUNC const &fn)
+		{
+			for (unsigned i = 0; i < _num_buckets; i++)
+				for (Entry *e = _buckets[i]; e; e = e->_hash_next)
+					fn(*e);
+		}
+
+		/**
+		 * Store the children of each directory in an array
+		 *
+		 * Should be called once the index is fully populated. Directories
+		 * modified by a subsequent 'insert' fall back to walking their list
+		 * of children.
+		 */
+		void finalize()
+		{
+			auto fill = [&] (Entry &dir) {
+				if (!dir._num_children || dir._children)
+					return;
+
+				Entry **children = (Entry **)
+					_arena_alloc(dir._num_children*sizeof(Entry *));
+
+				unsigned i = 0;
+				for (Entry *e = dir._first_child; e; e = e->_next_sibling)
+					children[i++] = e;
+
+				dir._children = children;
+			};
+
+			fill(_root);
+			for_each(fill);
+		}
+};
+
+#endif /* _INCLUDE__OS__PATH_INDEX_H_ */
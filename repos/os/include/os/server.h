@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__SERVER_H_
 
 #include <os/signal_rpc_dispatcher.h>
+#include <base/rpc_entrypoint_group.h>
 
 namespace Server {
 
@@ -63,6 +64,20 @@ namespace Server {
 			 * Return RPC entrypoint
 			 */
 			Rpc_entrypoint &rpc_ep() { return _rpc_ep; }
+
+			/**
+			 * Return group of RPC entrypoints for serving sessions in parallel
+			 *
+			 * By calling this function, a server opts in for serving its
+			 * sessions by multiple threads, one per CPU of the component's
+			 * affinity space. The group is created at the first call and
+			 * is typically passed to the 'Root_component'.
+			 *
+			 * Signals are still dispatched at the main entrypoint. Hence,
+			 * the server must synchronize its signal handlers with the RPC
+			 * functions of its sessions by itself.
+			 */
+			Rpc_entrypoint_group &rpc_ep_group();
 	};
 
 	void wait_and_dispatch_one_signal();
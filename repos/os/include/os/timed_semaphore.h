@@ -27,32 +27,77 @@
 namespace Genode {
 
 	/**
-	 * Alarm thread, which counts jiffies and triggers timeout events.
+	 * Alarm thread, which triggers timeout events
+	 *
+	 * Instead of counting periodic jiffies, the thread programs a one-shot
+	 * timeout for the earliest pending deadline. Hence, it does not wake up
+	 * as long as no timeout is pending.
 	 */
 	class Timeout_thread : public Thread<4096>,
 	                       public Alarm_scheduler
 	{
 		private:
 
-			enum { JIFFIES_STEP_MS = 10 };
+			/*
+			 * Upper bound of a programmed timeout, which keeps the value
+			 * passed to 'trigger_once' within its range. A later deadline
+			 * is approached in several steps.
+			 */
+			enum { MAX_TIMEOUT_MS = 1000*1000 };
 
 			Timer::Connection   _timer;    /* timer session   */
 			Signal_context      _context;
 			Signal_receiver     _receiver;
-			Genode::Alarm::Time _time;     /* current time    */
+
+			Lock                _program_lock;
+			bool                _programmed;   /* timeout is pending */
+			Genode::Alarm::Time _deadline;     /* deadline of pending timeout */
 
 			void entry(void);
 
+			/**
+			 * Program timeout unless one for an earlier deadline is pending
+			 */
+			void _program(Genode::Alarm::Time deadline);
+
 		public:
 
-			Timeout_thread() : Thread<4096>("alarm-timer"), _time(0)
+			Timeout_thread()
+			:
+				Thread<4096>("alarm-timer"), _programmed(false), _deadline(0)
 			{
 				_timer.sigh(_receiver.manage(&_context));
-				_timer.trigger_periodic(JIFFIES_STEP_MS*1000);
 				start();
 			}
 
-			Genode::Alarm::Time time(void) { return _time; }
+			/**
+			 * Return current time in milliseconds
+			 */
+			Genode::Alarm::Time time(void) { return _timer.elapsed_ms(); }
+
+			/**
+			 * Return current time in microseconds
+			 */
+			Genode::uint64_t time_us(void) { return _timer.elapsed_us(); }
+
+			/*
+			 * The following functions wrap those of 'Alarm_scheduler' to
+			 * reprogram the timer if the new deadline is the earliest one.
+			 */
+
+			void schedule_absolute(Alarm *alarm, Alarm::Time timeout)
+			{
+				Alarm_scheduler::schedule_absolute(alarm, timeout);
+				_program(timeout);
+			}
+
+			void schedule(Alarm *alarm, Alarm::Time period)
+			{
+				Alarm_scheduler::schedule(alarm, period);
+
+				/* the first deadline is overdue */
+				_program(time());
+			}
 
 			/*
 			 * Returns the singleton timeout-thread used for all timeouts.
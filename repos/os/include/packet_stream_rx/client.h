@@ -40,10 +40,14 @@ namespace Packet_stream_rx {
 
 			/**
 			 * Constructor
+			 *
+			 * The queue sizes are those published by the server.
 			 */
 			Client(Genode::Capability<CHANNEL> channel_cap) :
 				Genode::Rpc_client<CHANNEL>(channel_cap),
-				_sink(Base::template call<Rpc_dataspace>())
+				_sink(Base::template call<Rpc_dataspace>(),
+				      Packet_stream_base::PUBLISHED_QUEUE_SIZE,
+				      Packet_stream_base::PUBLISHED_QUEUE_SIZE)
 			{
 				/* wire data-flow signals for the packet receiver */
 				_sink.register_sigh_ack_avail(Base::template call<Rpc_ack_avail>());
@@ -42,11 +42,14 @@ namespace Packet_stream_rx {
 			 *                      buffer of the receive packet stream
 			 * \param ep            entry point used for serving the channel's RPC
 			 *                      interface
+			 * \param queue_size    number of slots of the submit and
+			 *                      acknowledgement queues
 			 */
 			Rpc_object(Genode::Dataspace_capability  ds,
 			           Genode::Range_allocator      *buffer_alloc,
-			           Genode::Rpc_entrypoint       &ep)
-			: _ep(ep), _cap(_ep.manage(this)), _source(buffer_alloc, ds),
+			           Genode::Rpc_entrypoint       &ep,
+			           unsigned queue_size = CHANNEL::Source::Submit_queue::DEFAULT_SIZE)
+			: _ep(ep), _cap(_ep.manage(this)), _source(buffer_alloc, ds, queue_size, queue_size),
 
 			  /* init signal handlers with default handlers of source */
 			  _sigh_ready_to_submit(_source.sigh_ready_to_submit()),
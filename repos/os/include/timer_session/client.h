@@ -33,6 +33,10 @@ namespace Timer {
 		void sigh(Signal_context_capability sigh) { call<Rpc_sigh>(sigh); }
 
 		unsigned long elapsed_ms() const { return call<Rpc_elapsed_ms>(); }
+
+		Genode::uint64_t elapsed_us() const { return call<Rpc_elapsed_us>(); }
+
+		Dataspace_capability time_page() { return call<Rpc_time_page>(); }
 	};
 }
 
@@ -15,7 +15,9 @@
 #define _INCLUDE__TIMER_SESSION__CONNECTION_H_
 
 #include <timer_session/client.h>
+#include <timer_session/time_page.h>
 #include <base/connection.h>
+#include <base/env.h>
 
 namespace Timer {
 
@@ -29,19 +31,69 @@ namespace Timer {
 			Signal_context_capability _default_sigh_cap;
 			Signal_context_capability _custom_sigh_cap;
 
+			Time_page const                   *_time_page;
+			mutable Genode::uint64_t volatile  _last_us;  /* latest time returned */
+
+			static Time_page const *_attach(Dataspace_capability ds)
+			{
+				if (!ds.valid())
+					return 0;
+
+				try {
+					return Genode::env()->rm_session()->attach(ds, 0, 0, false,
+					                                           (void *)0, false,
+					                                           false);
+				} catch (...) { return 0; }
+			}
+
 		public:
 
 			Connection()
 			:
-				Genode::Connection<Session>(session("ram_quota=8K")),
+				Genode::Connection<Session>(session("ram_quota=16K")),
 				Session_client(cap()),
-				_default_sigh_cap(_sig_rec.manage(&_default_sigh_ctx))
+				_default_sigh_cap(_sig_rec.manage(&_default_sigh_ctx)),
+				_time_page(_attach(Session_client::time_page())),
+				_last_us(0)
 			{
 				/* register default signal handler */
 				Session_client::sigh(_default_sigh_cap);
 			}
 
-			~Connection() { _sig_rec.dissolve(&_default_sigh_ctx); }
+			~Connection()
+			{
+				if (_time_page)
+					Genode::env()->rm_session()->detach(_time_page);
+
+				_sig_rec.dissolve(&_default_sigh_ctx);
+			}
+
+			/*
+			 * Read the elapsed time from the time page if possible, which
+			 * saves the RPC to the timer driver
+			 */
+
+			Genode::uint64_t elapsed_us() const
+			{
+				Genode::uint64_t us;
+				if (!_time_page || !_time_page->elapsed_us(us))
+					us = Session_client::elapsed_us();
+
+				/*
+				 * The extrapolated time may be slightly ahead of the time of
+				 * the next update of the page. Never return an earlier time
+				 * than before.
+				 */
+				for (;;) {
+					Genode::uint64_t const last = _last_us;
+					if (us <= last)
+						return last;
+					if (__sync_bool_compare_and_swap(&_last_us, last, us))
+						return us;
+				}
+			}
+
+			unsigned long elapsed_ms() const { return elapsed_us() / 1000; }
 
 			/*
 			 * Intercept 'sigh' to keep track of customized signal handlers
@@ -0,0 +1,128 @@
+/*
+ * \brief  Time page shared by the timer driver with a client
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__TIMER_SESSION__TIME_PAGE_H_
+#define _INCLUDE__TIMER_SESSION__TIME_PAGE_H_
+
+#include <base/stdint.h>
+
+namespace Timer { struct Time_page; }
+
+
+/**
+ * Relation of the elapsed time of a session to the timestamp counter
+ *
+ * The page enables a client to compute the elapsed time of its session
+ * without any RPC by extrapolating the time of the last update with the
+ * timestamp counter of the CPU. The timer driver updates the page from time
+ * to time. The sequence counter is odd during an update and changes with
+ * each update, which lets a reader detect and retry a torn read.
+ */
+struct Timer::Time_page
+{
+	typedef Genode::uint32_t uint32_t;
+	typedef Genode::uint64_t uint64_t;
+
+	enum {
+		SHIFT     = 32,  /* fixed-point shift of 'us_per_ts' */
+		MAX_DELTA = ~0U, /* timestamps after which the page is stale */
+	};
+
+	uint32_t volatile seq;
+	uint32_t volatile valid;      /* counter is calibrated */
+	uint64_t volatile base_us;    /* elapsed microseconds at 'base_ts' */
+	uint64_t volatile base_ts;    /* timestamp at 'base_us' */
+	uint64_t volatile us_per_ts;  /* microseconds per timestamp << SHIFT */
+
+	/**
+	 * Return true if the timestamp counter can be used for the time page
+	 *
+	 * The counter must be readable at user level and must not wrap within
+	 * seconds, which holds for the time-stamp counter of x86 CPUs only.
+	 */
+	static bool supported()
+	{
+#if defined(__i386__) || defined(__x86_64__)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * Read timestamp counter
+	 */
+	static uint64_t timestamp()
+	{
+#if defined(__i386__) || defined(__x86_64__)
+		uint32_t lo, hi;
+		asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+		return (uint64_t)hi << 32 | lo;
+#else
+		return 0;
+#endif
+	}
+
+	/**
+	 * Compute elapsed time of the session
+	 *
+	 * \return  false if the page is not calibrated or was not updated for
+	 *          too long, in which case the time must be requested by RPC
+	 */
+	bool elapsed_us(uint64_t &us) const
+	{
+		for (;;) {
+			uint32_t const s = seq;
+			__sync_synchronize();
+
+			bool     const v   = valid;
+			uint64_t const bus = base_us;
+			uint64_t const bts = base_ts;
+			uint64_t const mul = us_per_ts;
+			uint64_t const ts  = timestamp();
+
+			__sync_synchronize();
+			if ((s & 1) || s != seq)
+				continue;
+
+			if (!v)
+				return false;
+
+			uint64_t const delta = ts > bts ? ts - bts : 0;
+			if (delta > MAX_DELTA)
+				return false;
+
+			us = bus + ((delta*mul) >> SHIFT);
+			return true;
+		}
+	}
+
+	/**
+	 * Update page, executed by the timer driver
+	 */
+	void update(uint64_t us, uint64_t ts, uint64_t mul)
+	{
+		seq++;
+		__sync_synchronize();
+
+		base_us   = us;
+		base_ts   = ts;
+		us_per_ts = mul;
+		valid     = 1;
+
+		__sync_synchronize();
+		seq++;
+	}
+};
+
+#endif /* _INCLUDE__TIMER_SESSION__TIME_PAGE_H_ */
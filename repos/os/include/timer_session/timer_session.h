@@ -17,6 +17,7 @@
 #define _INCLUDE__TIMER_SESSION__TIMER_SESSION_H_
 
 #include <base/signal.h>
+#include <dataspace/capability.h>
 #include <session/session.h>
 
 namespace Timer {
@@ -52,6 +53,19 @@ namespace Timer {
 		 */
 		virtual unsigned long elapsed_ms() const = 0;
 
+		/**
+		 * Return number of elapsed microseconds since session creation
+		 */
+		virtual Genode::uint64_t elapsed_us() const = 0;
+
+		/**
+		 * Request time page of the session
+		 *
+		 * \return  dataspace containing a 'Timer::Time_page', or an invalid
+		 *          capability if the platform does not support the page
+		 */
+		virtual Dataspace_capability time_page() = 0;
+
 		/**
 		 * Client-side convenience function for sleeping the specified number
 		 * of milliseconds
@@ -73,9 +87,12 @@ namespace Timer {
 		GENODE_RPC(Rpc_trigger_periodic, void, trigger_periodic, unsigned);
 		GENODE_RPC(Rpc_sigh, void, sigh, Genode::Signal_context_capability);
 		GENODE_RPC(Rpc_elapsed_ms, unsigned long, elapsed_ms);
+		GENODE_RPC(Rpc_elapsed_us, Genode::uint64_t, elapsed_us);
+		GENODE_RPC(Rpc_time_page, Dataspace_capability, time_page);
 
 		GENODE_RPC_INTERFACE(Rpc_trigger_once, Rpc_trigger_periodic,
-		                     Rpc_sigh, Rpc_elapsed_ms);
+		                     Rpc_sigh, Rpc_elapsed_ms, Rpc_elapsed_us,
+		                     Rpc_time_page);
 	};
 }
 
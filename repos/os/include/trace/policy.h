@@ -28,3 +28,6 @@ extern "C" size_t rpc_dispatch   (char *dst, char const *rpc_name);
 extern "C" size_t rpc_reply      (char *dst, char const *rpc_name);
 extern "C" size_t signal_submit  (char *dst, unsigned const);
 extern "C" size_t signal_receive (char *dst, Genode::Signal_context const &, unsigned);
+extern "C" size_t heap_stats     (char *dst, unsigned long acquisitions,
+                                  unsigned long contentions,
+                                  unsigned long quota_used);
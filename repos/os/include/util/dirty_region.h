@@ -0,0 +1,247 @@
+/*
+ * \brief  Utility for tracking dirty areas as a set of disjoint rectangles
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _INCLUDE__UTIL__DIRTY_REGION_H_
+#define _INCLUDE__UTIL__DIRTY_REGION_H_
+
+#include <base/stdint.h>
+
+namespace Genode { template <typename, unsigned> class Dirty_region; }
+
+
+/**
+ * Dirty-region tracker
+ *
+ * \param RECT       rectangle type (as defined in 'util/geometry.h')
+ * \param MAX_RECTS  maximum number of rectangles used to represent the
+ *                   dirty area
+ *
+ * In contrast to 'Dirty_rect', which expands a few rectangles to the
+ * compound of all areas marked as dirty, the region keeps the dirty areas
+ * as disjoint rectangles. An area that overlaps already dirty areas is
+ * split such that no pixel is covered twice. Only if the number of
+ * rectangles would exceed 'MAX_RECTS', the two rectangles whose compound
+ * adds the fewest pixels are merged. Hence, small changes in distant
+ * parts of the screen do not result in redrawing everything in between.
+ */
+template <typename RECT, unsigned MAX_RECTS>
+class Genode::Dirty_region
+{
+	private:
+
+		typedef RECT Rect;
+		typedef Genode::size_t size_t;
+
+		/*
+		 * Maximum number of pieces when splitting a new rectangle at the
+		 * existing ones. If exceeded, the new rectangle is merged with
+		 * the overlapping ones instead.
+		 */
+		enum { MAX_PIECES = 2*MAX_RECTS + 4 };
+
+		Rect     _rects[MAX_RECTS];
+		unsigned _count = 0;
+
+		void _remove(unsigned i) { _rects[i] = _rects[--_count]; }
+
+		/**
+		 * Return number of pixels added by replacing 'r1' and 'r2' with
+		 * their compound
+		 */
+		static size_t _waste(Rect const &r1, Rect const &r2)
+		{
+			size_t const compound = Rect::compound(r1, r2).area().count();
+			size_t const sum      = r1.area().count() + r2.area().count();
+
+			return compound > sum ? compound - sum : 0;
+		}
+
+		/**
+		 * Return true if 'r1' and 'r2' share an edge of the same length
+		 */
+		static bool _adjacent(Rect const &r1, Rect const &r2)
+		{
+			if (r1.x1() == r2.x1() && r1.x2() == r2.x2())
+				return r1.y2() + 1 == r2.y1() || r2.y2() + 1 == r1.y1();
+
+			if (r1.y1() == r2.y1() && r1.y2() == r2.y2())
+				return r1.x2() + 1 == r2.x1() || r2.x2() + 1 == r1.x1();
+
+			return false;
+		}
+
+		/**
+		 * Add rectangle, merging it with all rectangles it overlaps
+		 */
+		void _insert(Rect r)
+		{
+			for (unsigned i = 0; i < _count; )
+				if (Rect::intersect(r, _rects[i]).valid()) {
+					r = Rect::compound(r, _rects[i]);
+					_remove(i);
+					i = 0;
+				} else {
+					i++;
+				}
+
+			if (_count < MAX_RECTS) {
+				_rects[_count++] = r;
+				return;
+			}
+
+			/*
+			 * Find the pair of rectangles, including 'r', whose compound
+			 * adds the fewest pixels. The compound may overlap other
+			 * rectangles, which are absorbed by the recursive call. Each
+			 * recursion frees at least one slot.
+			 */
+			unsigned best_i = 0, best_j = MAX_RECTS;
+			size_t   lowest = ~(size_t)0;
+
+			for (unsigned i = 0; i < _count; i++) {
+
+				size_t const w = _waste(_rects[i], r);
+				if (w < lowest) { lowest = w; best_i = i; best_j = MAX_RECTS; }
+
+				for (unsigned j = i + 1; j < _count; j++) {
+					size_t const w = _waste(_rects[i], _rects[j]);
+					if (w < lowest) { lowest = w; best_i = i; best_j = j; }
+				}
+			}
+
+			if (best_j == MAX_RECTS) {
+				Rect const compound = Rect::compound(_rects[best_i], r);
+				_remove(best_i);
+				_insert(compound);
+				return;
+			}
+
+			Rect const compound = Rect::compound(_rects[best_i], _rects[best_j]);
+			_rects[best_j] = r;
+			_remove(best_i);
+			_insert(compound);
+		}
+
+	public:
+
+		/**
+		 * Return number of rectangles
+		 */
+		unsigned count() const { return _count; }
+
+		/**
+		 * Return number of dirty pixels
+		 */
+		size_t pixels() const
+		{
+			size_t sum = 0;
+			for (unsigned i = 0; i < _count; i++)
+				sum += _rects[i].area().count();
+			return sum;
+		}
+
+		/**
+		 * Call functor for each dirty rectangle without resetting them
+		 */
+		template <typename FN>
+		void for_each(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _count; i++)
+				fn(_rects[i]);
+		}
+
+		/**
+		 * Call functor for each dirty area
+		 *
+		 * The functor 'fn' takes a 'Rect const &' as argument.
+		 * This function resets the dirty region.
+		 */
+		template <typename FN>
+		void flush(FN const &fn)
+		{
+			/*
+			 * Join rectangles that share a whole edge, which reduces the
+			 * number of rectangles without adding any pixel.
+			 */
+			for (bool joined = true; joined; ) {
+				joined = false;
+				for (unsigned i = 0; i < _count; i++)
+					for (unsigned j = i + 1; j < _count; j++)
+						if (_adjacent(_rects[i], _rects[j])) {
+							_rects[i] = Rect::compound(_rects[i], _rects[j]);
+							_remove(j);
+							joined = true;
+						}
+			}
+
+			for (unsigned i = 0; i < _count; i++)
+				fn(_rects[i]);
+
+			_count = 0;
+		}
+
+		void mark_as_dirty(Rect added)
+		{
+			if (!added.valid())
+				return;
+
+			/*
+			 * Split the added rectangle into pieces that do not overlap
+			 * any dirty rectangle.
+			 */
+			Rect     pieces[MAX_PIECES];
+			unsigned num_pieces = 0;
+
+			pieces[num_pieces++] = added;
+
+			for (unsigned i = 0; i < _count && num_pieces; i++) {
+
+				Rect     remaining[MAX_PIECES];
+				unsigned num_remaining = 0;
+
+				for (unsigned j = 0; j < num_pieces; j++) {
+
+					Rect const &p = pieces[j];
+
+					if (!Rect::intersect(p, _rects[i]).valid()) {
+						remaining[num_remaining++] = p;
+						continue;
+					}
+
+					Rect cut[4];
+					p.cut(_rects[i], &cut[0], &cut[1], &cut[2], &cut[3]);
+
+					for (unsigned k = 0; k < 4; k++) {
+						if (!cut[k].valid())
+							continue;
+
+						/* too fragmented, merge instead */
+						if (num_remaining == MAX_PIECES) {
+							_insert(added);
+							return;
+						}
+						remaining[num_remaining++] = cut[k];
+					}
+				}
+
+				for (unsigned j = 0; j < num_remaining; j++)
+					pieces[j] = remaining[j];
+				num_pieces = num_remaining;
+			}
+
+			for (unsigned i = 0; i < num_pieces; i++)
+				_insert(pieces[i]);
+		}
+};
+
+#endif /* _INCLUDE__UTIL__DIRTY_REGION_H_ */
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator_avl.h>
+#include <base/semaphore.h>
 #include <file_system_session/connection.h>
 
 namespace Vfs { class Fs_file_system; }
@@ -27,12 +28,16 @@ class Vfs::Fs_file_system : public File_system
 
 	private:
 
+		enum {
+			READ_AHEAD_SLOTS = 2,         /* read-ahead packets per handle  */
+			READ_AHEAD_SIZE  = 16*1024,   /* size of one read-ahead packet  */
+			WRITE_BEHIND_SLOTS = 4,       /* outstanding writes per handle  */
+			MAX_PENDING        = 64,      /* requests awaiting their ack    */
+		};
+
 		/*
 		 * Lock used to serialize the interaction with the packet stream of the
 		 * file-system session.
-		 *
-		 * XXX Once, we change the VFS file-system interface to use
-		 *     asynchronous read/write operations, we can possibly remove it.
 		 */
 		Lock _lock;
 
@@ -53,7 +58,32 @@ class Vfs::Fs_file_system : public File_system
 
 		::File_system::Connection _fs;
 
-		class Fs_vfs_handle : public Vfs_handle
+		typedef ::File_system::Session::Tx::Source Source;
+		typedef ::File_system::Packet_descriptor   Packet_descriptor;
+
+		/**
+		 * Packet submitted to the file-system server
+		 *
+		 * The index of the request within '_pending' is passed as
+		 * 'Packet_ref' along with the packet. This way, each
+		 * acknowledgement is matched to its request, regardless of the
+		 * thread that receives the acknowledgement and of the order of
+		 * completion.
+		 */
+		struct Request
+		{
+			Packet_descriptor packet;
+			bool              submitted;
+			bool              acked;
+			bool              failed;  /* operation failed or write was short */
+			bool             *error;   /* flag raised on failure, or 0 */
+
+			Request(bool *error = 0)
+			: submitted(false), acked(false), failed(false), error(error) { }
+		};
+
+		class Fs_vfs_handle : public Vfs_handle,
+		                      public List<Fs_vfs_handle>::Element
 		{
 			private:
 
@@ -61,20 +91,43 @@ class Vfs::Fs_file_system : public File_system
 
 			public:
 
+				/*
+				 * State of asynchronous operations, protected by the
+				 * '_lock' of the file system
+				 */
+				Request  read_ahead[READ_AHEAD_SLOTS];
+				size_t   read_ahead_end;   /* end of requested read-ahead   */
+				bool     read_ahead_eof;   /* end of file seen by read-ahead */
+				size_t   next_seek;        /* offset of a sequential read   */
+				Request  writes[WRITE_BEHIND_SLOTS];
+				unsigned next_write;
+				bool     write_failed;     /* not yet reported write error  */
+
 				Fs_vfs_handle(File_system &fs, int status_flags,
 				              ::File_system::File_handle handle)
-				: Vfs_handle(fs, fs, status_flags), _handle(handle)
-				{ }
+				:
+					Vfs_handle(fs, fs, status_flags), _handle(handle),
+					read_ahead_end(0), read_ahead_eof(false), next_seek(0),
+					next_write(0), write_failed(false)
+				{
+					for (unsigned i = 0; i < WRITE_BEHIND_SLOTS; i++)
+						writes[i].error = &write_failed;
+				}
 
 				~Fs_vfs_handle()
 				{
 					Fs_file_system &fs = static_cast<Fs_file_system &>(ds());
-					fs._fs.close(_handle);
+					fs._close(*this);
 				}
 
 				::File_system::File_handle file_handle() const { return _handle; }
 		};
 
+		/*
+		 * Handles with potentially outstanding asynchronous operations
+		 */
+		List<Fs_vfs_handle> _handles;
+
 		/**
 		 * Helper for managing the lifetime of temporary open node handles
 		 */
@@ -90,39 +143,318 @@ class Vfs::Fs_file_system : public File_system
 			~Fs_handle_guard() { _fs.close(_handle); }
 		};
 
-		size_t _read(::File_system::Node_handle node_handle, void *buf,
-		             size_t const count, size_t const seek_offset)
+		/*
+		 * Requests awaiting their acknowledgement, indexed by the tag
+		 * passed along with their packets
+		 */
+		Request *_pending[MAX_PENDING];
+
+		/*
+		 * State of the reception of acknowledgements
+		 */
+		bool              _collecting;   /* a thread blocks for acks        */
+		unsigned          _ack_waiters;  /* threads blocking at '_ack_sem'  */
+		Genode::Semaphore _ack_sem;
+
+		static ::File_system::Packet_ref *_tag(unsigned index) {
+			return reinterpret_cast< ::File_system::Packet_ref *>((Genode::addr_t)index); }
+
+		/*
+		 * The following functions must be called with '_lock' held. Functions
+		 * that wait for acknowledgements release the lock while blocking.
+		 */
+
+		/**
+		 * Hand acknowledgement to its request
+		 *
+		 * The tag of the acknowledgement is provided by the server. Hence,
+		 * it is checked against the pending requests before being used.
+		 * Only the outcome of the operation is taken from the
+		 * acknowledgement, not the location of the packet.
+		 */
+		void _dispatch_ack(Packet_descriptor const &ack)
 		{
-			::File_system::Session::Tx::Source &source = *_fs.tx();
+			Genode::addr_t const tag = (Genode::addr_t)ack.ref();
 
-			size_t const max_packet_size = source.bulk_buffer_size() / 2;
-			size_t const clipped_count = min(max_packet_size, count);
+			Request * const request = tag < MAX_PENDING ? _pending[tag] : 0;
 
-			::File_system::Packet_descriptor const
-				packet_in(source.alloc_packet(clipped_count),
-				          0,
-				          node_handle,
-				          ::File_system::Packet_descriptor::READ,
-				          clipped_count,
-				          seek_offset);
+			if (!request || request->packet.offset() != ack.offset()) {
+				PERR("ignoring acknowledgement with invalid tag");
+				return;
+			}
 
-			/* pass packet to server side */
-			source.submit_packet(packet_in);
+			_pending[tag] = 0;
 
-			/* obtain result packet descriptor with updated status info */
-			::File_system::Packet_descriptor const
-				packet_out = source.get_acked_packet();
+			Packet_descriptor &packet = request->packet;
 
-			size_t const read_num_bytes = min(packet_out.length(), count);
+			size_t const length = min(ack.length(), packet.length());
 
-			memcpy(buf, source.packet_content(packet_out), read_num_bytes);
+			request->failed = !ack.succeeded()
+			               || (packet.operation() == Packet_descriptor::WRITE
+			                && length < packet.length());
 
-			/*
-			 * XXX check if acked packet belongs to request,
-			 *     needed for thread safety
-			 */
+			packet.length(length);
+			packet.succeeded(ack.succeeded());
+			request->acked = true;
+		}
+
+		/**
+		 * Block until acknowledgements arrived
+		 *
+		 * Only one thread at a time receives acknowledgements from the
+		 * packet stream. It releases '_lock' while blocking. Other threads
+		 * block at '_ack_sem' until the received acknowledgements are
+		 * handed to their requests. The caller must re-evaluate its
+		 * condition afterwards because '_lock' was released meanwhile.
+		 */
+		void _await_ack()
+		{
+			if (_collecting) {
+				_ack_waiters++;
+				_lock.unlock();
+				_ack_sem.down();
+				_lock.lock();
+				return;
+			}
+
+			_collecting = true;
+			_lock.unlock();
+
+			enum { MAX_ACKS = 16 };
+			Packet_descriptor acks[MAX_ACKS];
+			unsigned const num_acks = _fs.tx()->get_acked_packets(acks, MAX_ACKS);
+
+			_lock.lock();
+			_collecting = false;
+
+			for (unsigned i = 0; i < num_acks; i++)
+				_dispatch_ack(acks[i]);
+
+			for (; _ack_waiters; _ack_waiters--)
+				_ack_sem.up();
+		}
+
+		/**
+		 * Submit request
+		 *
+		 * \param packet  packet to submit, its 'Packet_ref' is assigned
+		 *                by this function
+		 */
+		void _submit(Request &request, Packet_descriptor const &packet)
+		{
+			unsigned tag = 0;
 
-			source.release_packet(packet_out);
+			for (;;) {
+
+				/* the request may have been reused by another thread */
+				if (request.submitted) {
+					_finish(request);
+					continue;
+				}
+
+				for (tag = 0; tag < MAX_PENDING && _pending[tag]; tag++);
+
+				if (tag < MAX_PENDING && _fs.tx()->ready_to_submit())
+					break;
+
+				_await_ack();
+			}
+
+			_pending[tag] = &request;
+
+			request.packet    = Packet_descriptor(packet, _tag(tag),
+			                                      packet.handle(),
+			                                      packet.operation(),
+			                                      packet.length(),
+			                                      packet.position());
+			request.submitted = true;
+			request.acked     = false;
+			request.failed    = false;
+
+			_fs.tx()->submit_packet(request.packet);
+		}
+
+		void _wait(Request &request)
+		{
+			while (request.submitted && !request.acked)
+				_await_ack();
+		}
+
+		/**
+		 * Wait for the completion of a request and release its packet
+		 *
+		 * \return  false if the operation of the request failed
+		 */
+		bool _finish(Request &request)
+		{
+			_wait(request);
+
+			/* finished by another thread meanwhile */
+			if (!request.submitted)
+				return true;
+
+			bool const ok = !request.failed;
+
+			if (!ok && request.error)
+				*request.error = true;
+
+			_fs.tx()->release_packet(request.packet);
+			request.submitted = request.acked = request.failed = false;
+
+			return ok;
+		}
+
+		void _drop_read_ahead(Fs_vfs_handle &handle)
+		{
+			for (unsigned i = 0; i < READ_AHEAD_SLOTS; i++)
+				_finish(handle.read_ahead[i]);
+
+			handle.read_ahead_eof = false;
+		}
+
+		void _flush_writes(Fs_vfs_handle &handle)
+		{
+			/* complete the writes in the order of their submission */
+			for (unsigned i = 0; i < WRITE_BEHIND_SLOTS; i++)
+				_finish(handle.writes[(handle.next_write + i) % WRITE_BEHIND_SLOTS]);
+		}
+
+		/**
+		 * Finish the oldest outstanding request of the handle
+		 *
+		 * \param writes_only  leave the read-ahead requests untouched
+		 * \return             false if no request was outstanding
+		 */
+		bool _finish_oldest(Fs_vfs_handle &handle, bool writes_only)
+		{
+			for (unsigned i = 0; i < WRITE_BEHIND_SLOTS; i++) {
+				Request &request = handle.writes[(handle.next_write + i) % WRITE_BEHIND_SLOTS];
+				if (request.submitted) {
+					_finish(request);
+					return true;
+				}
+			}
+
+			for (unsigned i = 0; i < READ_AHEAD_SLOTS && !writes_only; i++) {
+				Request &request = handle.read_ahead[i];
+				if (request.submitted) {
+					_finish(request);
+					handle.read_ahead_eof = false;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Finish the outstanding requests of all handles
+		 *
+		 * Finishing a request may release '_lock', which allows other
+		 * threads to close handles. Hence, the list of handles is
+		 * traversed anew after each finished request.
+		 */
+		void _flush_all(bool writes_only = false)
+		{
+			for (bool finished = true; finished; ) {
+				finished = false;
+				for (Fs_vfs_handle *h = _handles.first(); h && !finished; h = h->next())
+					finished = _finish_oldest(*h, writes_only);
+			}
+		}
+
+		void _close(Fs_vfs_handle &handle)
+		{
+			Lock::Guard guard(_lock);
+
+			_flush_writes(handle);
+			_drop_read_ahead(handle);
+			_handles.remove(&handle);
+			_fs.close(handle.file_handle());
+
+			/* there is no caller left to report the error to */
+			if (handle.write_failed)
+				PERR("write-behind failed for closed file");
+		}
+
+		/**
+		 * Allocate packet, reclaiming the bulk buffer used for asynchronous
+		 * operations if needed
+		 *
+		 * \throw Source::Packet_alloc_failed
+		 */
+		Packet_descriptor _alloc_packet(size_t size)
+		{
+			try { return _fs.tx()->alloc_packet(size); }
+			catch (Source::Packet_alloc_failed) { }
+
+			_flush_all();
+			return _fs.tx()->alloc_packet(size);
+		}
+
+		/**
+		 * Issue read-ahead requests for the free read-ahead slots
+		 */
+		void _read_ahead(Fs_vfs_handle &handle)
+		{
+			for (unsigned i = 0; i < READ_AHEAD_SLOTS && !handle.read_ahead_eof; i++) {
+
+				Request &request = handle.read_ahead[i];
+				if (request.submitted)
+					continue;
+
+				/* read-ahead is opportunistic, skip it if the buffer is used up */
+				Packet_descriptor packet;
+				try { packet = _fs.tx()->alloc_packet(READ_AHEAD_SIZE); }
+				catch (Source::Packet_alloc_failed) { return; }
+
+				_submit(request, Packet_descriptor(packet, 0,
+				                                   handle.file_handle(),
+				                                   Packet_descriptor::READ,
+				                                   READ_AHEAD_SIZE,
+				                                   handle.read_ahead_end));
+
+				handle.read_ahead_end += READ_AHEAD_SIZE;
+			}
+		}
+
+		/**
+		 * Return read-ahead request that covers the specified offset
+		 */
+		Request *_read_ahead_at(Fs_vfs_handle &handle, size_t offset)
+		{
+			for (unsigned i = 0; i < READ_AHEAD_SLOTS; i++) {
+
+				Request &request = handle.read_ahead[i];
+				if (!request.submitted)
+					continue;
+
+				size_t const position = request.packet.position();
+
+				if (offset >= position && offset < position + READ_AHEAD_SIZE)
+					return &request;
+			}
+			return 0;
+		}
+
+		size_t _read(::File_system::Node_handle node_handle, void *buf,
+		             size_t const count, size_t const seek_offset)
+		{
+			size_t const max_packet_size = _fs.tx()->bulk_buffer_size() / 2;
+			size_t const clipped_count = min(max_packet_size, count);
+
+			Request request;
+			_submit(request, Packet_descriptor(_alloc_packet(clipped_count), 0,
+			                                   node_handle,
+			                                   Packet_descriptor::READ,
+			                                   clipped_count,
+			                                   seek_offset));
+			_wait(request);
+
+			size_t const read_num_bytes = min(request.packet.length(), count);
+
+			memcpy(buf, _fs.tx()->packet_content(request.packet), read_num_bytes);
+
+			_finish(request);
 
 			return read_num_bytes;
 		}
@@ -130,33 +462,21 @@ class Vfs::Fs_file_system : public File_system
 		size_t _write(::File_system::Node_handle node_handle,
 		              const char *buf, size_t count, size_t seek_offset)
 		{
-			::File_system::Session::Tx::Source &source = *_fs.tx();
-
-			size_t const max_packet_size = source.bulk_buffer_size() / 2;
+			size_t const max_packet_size = _fs.tx()->bulk_buffer_size() / 2;
 			count = min(max_packet_size, count);
 
-			::File_system::Packet_descriptor
-				packet(source.alloc_packet(count),
-				       0,
-				       node_handle,
-				       ::File_system::Packet_descriptor::WRITE,
-				       count,
-				       seek_offset);
+			Request request;
+			Packet_descriptor const packet(_alloc_packet(count), 0,
+			                               node_handle,
+			                               Packet_descriptor::WRITE,
+			                               count,
+			                               seek_offset);
 
-			memcpy(source.packet_content(packet), buf, count);
+			memcpy(_fs.tx()->packet_content(packet), buf, count);
 
-			/* pass packet to server side */
-			source.submit_packet(packet);
-			source.get_acked_packet();
+			_submit(request, packet);
 
-			/*
-			 * XXX check if acked packet belongs to request,
-			 *     needed for thread safety
-			 */
-
-			source.release_packet(packet);
-
-			return count;
+			return _finish(request) ? count : 0;
 		}
 
 	public:
@@ -168,8 +488,12 @@ class Vfs::Fs_file_system : public File_system
 		:
 			_fs_packet_alloc(env()->heap()),
 			_label(config),
-			_fs(_fs_packet_alloc, 128*1024, _label.string)
-		{ }
+			_fs(_fs_packet_alloc, 128*1024, _label.string),
+			_collecting(false), _ack_waiters(0)
+		{
+			for (unsigned i = 0; i < MAX_PENDING; i++)
+				_pending[i] = 0;
+		}
 
 
 		/*********************************
@@ -206,34 +530,14 @@ class Vfs::Fs_file_system : public File_system
 
 				local_addr = env()->rm_session()->attach(ds_cap);
 
-				::File_system::Session::Tx::Source &source = *_fs.tx();
-				size_t const max_packet_size = source.bulk_buffer_size() / 2;
+				size_t const max_packet_size = _fs.tx()->bulk_buffer_size() / 2;
 
 				for (size_t seek_offset = 0; seek_offset < status.size;
 				     seek_offset += max_packet_size) {
 
 					size_t const count = min(max_packet_size, status.size - seek_offset);
 
-					::File_system::Packet_descriptor
-						packet(source.alloc_packet(count),
-							   0,
-							   file,
-							   ::File_system::Packet_descriptor::READ,
-							   count,
-							   seek_offset);
-
-					/* pass packet to server side */
-					source.submit_packet(packet);
-					source.get_acked_packet();
-
-					memcpy(local_addr + seek_offset, source.packet_content(packet), count);
-
-					/*
-					 * XXX check if acked packet belongs to request,
-					 *     needed for thread safety
-					 */
-
-					source.release_packet(packet);
+					_read(file, local_addr + seek_offset, count, seek_offset);
 				}
 
 				env()->rm_session()->detach(local_addr);
@@ -253,6 +557,11 @@ class Vfs::Fs_file_system : public File_system
 
 		Stat_result stat(char const *path, Stat &out) override
 		{
+			Lock::Guard guard(_lock);
+
+			/* let the status reflect the outstanding writes */
+			_flush_all(true);
+
 			::File_system::Status status;
 
 			try {
@@ -285,8 +594,6 @@ class Vfs::Fs_file_system : public File_system
 		{
 			Lock::Guard guard(_lock);
 
-			::File_system::Session::Tx::Source &source = *_fs.tx();
-
 			if (strcmp(path, "") == 0)
 				path = "/";
 
@@ -295,28 +602,19 @@ class Vfs::Fs_file_system : public File_system
 
 			enum { DIRENT_SIZE = sizeof(::File_system::Directory_entry) };
 
-			::File_system::Packet_descriptor
-				packet(source.alloc_packet(DIRENT_SIZE),
-				       0,
-				       dir_handle,
-				       ::File_system::Packet_descriptor::READ,
-				       DIRENT_SIZE,
-				       index*DIRENT_SIZE);
-
-			/* pass packet to server side */
-			source.submit_packet(packet);
-			source.get_acked_packet();
-
-			/*
-			 * XXX check if acked packet belongs to request,
-			 *     needed for thread safety
-			 */
+			Request request;
+			_submit(request, Packet_descriptor(_alloc_packet(DIRENT_SIZE), 0,
+			                                   dir_handle,
+			                                   Packet_descriptor::READ,
+			                                   DIRENT_SIZE,
+			                                   index*DIRENT_SIZE));
+			_wait(request);
 
 			typedef ::File_system::Directory_entry Directory_entry;
 
 			/* copy-out payload into destination buffer */
 			Directory_entry const *entry =
-				(Directory_entry *)source.packet_content(packet);
+				(Directory_entry *)_fs.tx()->packet_content(request.packet);
 
 			/*
 			 * The default value has no meaning because the switch below
@@ -336,7 +634,7 @@ class Vfs::Fs_file_system : public File_system
 
 			strncpy(out.name, entry->name, sizeof(out.name));
 
-			source.release_packet(packet);
+			_finish(request);
 
 			return DIRENT_OK;
 		}
@@ -365,6 +663,8 @@ class Vfs::Fs_file_system : public File_system
 		Readlink_result readlink(char const *path, char *buf, size_t buf_size,
 		                         size_t &out_len) override
 		{
+			Lock::Guard guard(_lock);
+
 			/*
 			 * Canonicalize path (i.e., path must start with '/')
 			 */
@@ -465,7 +765,10 @@ class Vfs::Fs_file_system : public File_system
 				    _fs.symlink(dir_handle, symlink_name.base() + 1, true);
 				Fs_handle_guard symlink_guard(_fs, symlink_handle);
 
-				_write(symlink_handle, from, strlen(from) + 1, 0);
+				size_t const len = strlen(from) + 1;
+				if (_write(symlink_handle, from, len, 0) < len)
+					return SYMLINK_ERR_NO_ENTRY;
+
 				return SYMLINK_OK;
 			}
 			catch (::File_system::Invalid_handle)      { return SYMLINK_ERR_NO_ENTRY; }
@@ -553,7 +856,12 @@ class Vfs::Fs_file_system : public File_system
 				::File_system::File_handle file = _fs.file(dir, file_name.base() + 1,
 				                                           mode, create);
 
-				*out_handle = new (env()->heap()) Fs_vfs_handle(*this, vfs_mode, file);
+				Fs_vfs_handle *handle =
+					new (env()->heap()) Fs_vfs_handle(*this, vfs_mode, file);
+
+				_handles.insert(handle);
+
+				*out_handle = handle;
 				return OPEN_OK;
 			}
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM; }
@@ -573,6 +881,9 @@ class Vfs::Fs_file_system : public File_system
 
 		void sync() override
 		{
+			Lock::Guard guard(_lock);
+
+			_flush_all();
 			_fs.sync();
 		}
 
@@ -581,44 +892,149 @@ class Vfs::Fs_file_system : public File_system
 		 ** File I/O service interface **
 		 ********************************/
 
+		/**
+		 * Write data asynchronously
+		 *
+		 * The write is submitted without waiting for its completion. The
+		 * outstanding writes of a handle are completed on 'sync', on
+		 * closing the handle, or once all write-behind slots are in use.
+		 *
+		 * A failed or short write is reported by the next write to the
+		 * handle, which is not performed then. An error detected on
+		 * closing the handle is logged.
+		 */
 		Write_result write(Vfs_handle *vfs_handle, char const *buf, size_t buf_size,
 		                   size_t &out_count) override
 		{
 			Lock::Guard guard(_lock);
 
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle &handle = *static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			/* prevent the read-ahead data from becoming stale */
+			_drop_read_ahead(handle);
+
+			/* complete the writes that are acknowledged already */
+			for (unsigned i = 0; i < WRITE_BEHIND_SLOTS; i++)
+				if (handle.writes[i].acked)
+					_finish(handle.writes[i]);
+
+			if (handle.write_failed) {
+				handle.write_failed = false;
+				return WRITE_ERR_IO;
+			}
+
+			Request &request = handle.writes[handle.next_write];
+			handle.next_write = (handle.next_write + 1) % WRITE_BEHIND_SLOTS;
+
+			/* wait for the oldest write if all slots are in use */
+			_finish(request);
+
+			size_t const max_packet_size =
+				_fs.tx()->bulk_buffer_size() / (2*WRITE_BEHIND_SLOTS);
+
+			size_t const count = min(max_packet_size, buf_size);
+
+			Packet_descriptor const packet(_alloc_packet(count), 0,
+			                               handle.file_handle(),
+			                               Packet_descriptor::WRITE,
+			                               count,
+			                               handle.seek());
+
+			memcpy(_fs.tx()->packet_content(packet), buf, count);
 
-			out_count = _write(handle->file_handle(), buf, buf_size, handle->seek());
+			_submit(request, packet);
 
+			out_count = count;
 			return WRITE_OK;
 		}
 
+		/**
+		 * Read data, using read-ahead for sequential access
+		 *
+		 * A read that continues the previous read of the handle triggers
+		 * the asynchronous read of the subsequent parts of the file.
+		 */
 		Read_result read(Vfs_handle *vfs_handle, char *dst, size_t count,
 		                 size_t &out_count) override
 		{
 			Lock::Guard guard(_lock);
 
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle &handle = *static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			size_t const seek = handle.seek();
+
+			/* serve read from read-ahead data */
+			while (Request *request = _read_ahead_at(handle, seek)) {
+
+				/* the request may have been finished meanwhile */
+				if (!request->acked) {
+					_await_ack();
+					continue;
+				}
+
+				Packet_descriptor const &packet = request->packet;
+
+				size_t const end = packet.position() + packet.length();
+
+				if (packet.length() < READ_AHEAD_SIZE)
+					handle.read_ahead_eof = true;
+
+				if (seek < end) {
+
+					out_count = min(count, end - seek);
+
+					memcpy(dst, _fs.tx()->packet_content(packet)
+					            + (seek - packet.position()), out_count);
 
-			::File_system::Status status = _fs.status(handle->file_handle());
+					/* make the slot available for the next read-ahead */
+					if (seek + out_count == end)
+						_finish(*request);
+
+					handle.next_seek = seek + out_count;
+					_read_ahead(handle);
+
+					return READ_OK;
+				}
+				break;
+			}
+
+			bool const sequential = (seek == handle.next_seek);
+
+			_drop_read_ahead(handle);
+			_flush_writes(handle);
+
+			::File_system::Status status = _fs.status(handle.file_handle());
 			size_t const file_size = status.size;
 
-			size_t const file_bytes_left = file_size >= handle->seek()
-			                             ? file_size  - handle->seek() : 0;
+			size_t const file_bytes_left = file_size >= seek
+			                             ? file_size  - seek : 0;
 
-			count = min(count, file_bytes_left);
+			size_t const clipped_count = min(count, file_bytes_left);
 
-			out_count = _read(handle->file_handle(), dst, count, handle->seek());
+			out_count = _read(handle.file_handle(), dst, clipped_count, seek);
+
+			handle.next_seek = seek + out_count;
+
+			/* start read-ahead for sequential access */
+			if (sequential && out_count && out_count < file_bytes_left) {
+				handle.read_ahead_end = handle.next_seek;
+				_read_ahead(handle);
+			}
 
 			return READ_OK;
 		}
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, size_t len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Lock::Guard guard(_lock);
+
+			Fs_vfs_handle &handle = *static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			_flush_writes(handle);
+			_drop_read_ahead(handle);
 
 			try {
-				_fs.truncate(handle->file_handle(), len);
+				_fs.truncate(handle.file_handle(), len);
 			} 
 			catch (::File_system::Invalid_handle)    { return FTRUNCATE_ERR_NO_PERM; }
 			catch (::File_system::Permission_denied) { return FTRUNCATE_ERR_NO_PERM; }
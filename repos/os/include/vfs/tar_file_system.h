@@ -15,6 +15,7 @@
 #define _INCLUDE__VFS__TAR_FILE_SYSTEM_H_
 
 #include <rom_session/connection.h>
+#include <os/path_index.h>
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 
@@ -109,179 +110,37 @@ class Vfs::Tar_file_system : public File_system
 	};
 
 
-	struct Scanner_policy_path_element
-	{
-		static bool identifier_char(char c, unsigned /* i */)
-		{
-			return (c != '/') && (c != 0);
-		}
-	};
-
-
-	typedef Genode::Token<Scanner_policy_path_element> Path_element_token;
-
-
-	struct Node : List<Node>, List<Node>::Element
-	{
-		char const *name;
-		Record const *record;
-
-		Node(char const *name, Record const *record) : name(name), record(record) { }
-
-		Node *lookup(char const *name)
-		{
-			Absolute_path lookup_path(name);
-
-			if (verbose)
-				PDBG("lookup_path = %s", lookup_path.base());
-
-			Node *parent_node = this;
-			Node *child_node;
-
-			Path_element_token t(lookup_path.base());
-
-			while (t) {
-
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
-
-				char path_element[MAX_PATH_LEN];
-
-				t.string(path_element, sizeof(path_element));
-
-				if (verbose)
-					PDBG("path_element = %s", path_element);
-
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (verbose)
-						PDBG("comparing with node %s", child_node->name);
-					if (strcmp(child_node->name, path_element) == 0) {
-						if (verbose)
-							PDBG("found matching child node");
-						parent_node = child_node;
-						break;
-					}
-				}
-
-				if (!child_node)
-					return 0;
-
-				t = t.next();
-			}
-
-			return parent_node;
-		}
+	typedef Genode::Path_index<Record const> Index;
 
-
-		Node *lookup_child(int index)
-		{
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), index--) {
-				if (index == 0)
-					return child_node;
-			}
-
-			return 0;
-		}
-
-
-		size_t num_dirent()
-		{
-			size_t count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
-		}
-
-	} _root_node;
+	/*
+	 * Index of all archive paths, the value of an entry is 0 for
+	 * directories that are present only as part of the paths of other
+	 * records
+	 */
+	Index _index;
 
 
 	/*
-	 *  Create a Node for a tar record and insert it into the node list
+	 *  Insert a tar record into the path index
 	 */
-	class Add_node_action
+	class Add_record_action
 	{
 		private:
 
-			Node &_root_node;
+			Index &_index;
 
 		public:
 
-			Add_node_action(Node &root_node) : _root_node(root_node) { }
+			Add_record_action(Index &index) : _index(index) { }
 
 			void operator()(Record const *record)
 			{
-				Absolute_path current_path(record->name());
-
 				if (verbose)
-					PDBG("current_path = %s", current_path.base());
-
-				char path_element[MAX_PATH_LEN];
-
-				Path_element_token t(current_path.base());
-
-				Node *parent_node = &_root_node;
-				Node *child_node;
-
-				while(t) {
+					PDBG("inserting %s", record->name());
 
-					if (t.type() != Path_element_token::IDENT) {
-							t = t.next();
-							continue;
-					}
-
-					Absolute_path remaining_path(t.start());
-
-					t.string(path_element, sizeof(path_element));
-
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
-
-					if (child_node) {
-
-						if (verbose)
-							PDBG("found node for %s", path_element);
-
-						if (remaining_path.has_single_element()) {
-							/* Found a node for the record to be inserted.
-							 * This is usually a directory node without
-							 * record. */
-							child_node->record = record;
-						}
-					} else {
-						if (remaining_path.has_single_element()) {
-
-							if (verbose)
-								PDBG("creating node for %s", path_element);
-
-							/*
-							 * TODO: find 'path_element' in 'record->name'
-							 * and use the location in the record as name
-							 * pointer to save some memory
-							 */
-							size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)env()->heap()->alloc(name_size);
-							strncpy(name, path_element, name_size);
-							child_node = new (env()->heap()) Node(name, record);
-						} else {
-
-							if (verbose)
-								PDBG("creating node without record for %s", path_element);
-
-							/* create a directory node without record */
-							size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)env()->heap()->alloc(name_size);
-							strncpy(name, path_element, name_size);
-							child_node = new (env()->heap()) Node(name, 0);
-						}
-						parent_node->insert(child_node);
-					}
-
-					parent_node = child_node;
-					t = t.next();
-				}
+				try { _index.insert(record->name(), record); }
+				catch (Index::Path_too_long) {
+					PWRN("skipping TAR record with too long path"); }
 			}
 	};
 
@@ -319,35 +178,6 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
-	struct Num_dirent_cache
-	{
-		Lock             lock;
-		Node            &root_node;
-		bool             valid;              /* true after first lookup */
-		char             key[256];           /* key used for lookup */
-		size_t           cached_num_dirent;  /* cached value */
-
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
-
-		size_t num_dirent(char const *path)
-		{
-			Lock::Guard guard(lock);
-
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				strncpy(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
-			}
-			return cached_num_dirent;
-		}
-	} _cached_num_dirent;
-
-
 	public:
 
 		Tar_file_system(Xml_node config)
@@ -355,13 +185,13 @@ class Vfs::Tar_file_system : public File_system
 			_rom_name(config), _rom(_rom_name.name),
 			_tar_base(env()->rm_session()->attach(_rom.dataspace())),
 			_tar_size(Dataspace_client(_rom.dataspace()).size()),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_index(*env()->heap())
 		{
 			PINF("tar archive '%s' local at %p, size is %zd",
 			     _rom_name.name, _tar_base, _tar_size);
 
-			_for_each_tar_record_do(Add_node_action(_root_node));
+			_for_each_tar_record_do(Add_record_action(_index));
+			_index.finalize();
 		}
 
 
@@ -376,12 +206,12 @@ class Vfs::Tar_file_system : public File_system
 			 */
 			Record const *record = 0;
 			for (;;) {
-				Node *node = _root_node.lookup(path);
+				Index::Entry *entry = _index.lookup(path);
 
-				if (!node)
+				if (!entry)
 					return Dataspace_capability();
 
-				record = node->record;
+				record = entry->value;
 
 				if (record) {
 					if (record->type() == Record::TYPE_HARDLINK) {
@@ -427,19 +257,19 @@ class Vfs::Tar_file_system : public File_system
 			if (verbose)
 				PDBG("path = %s", path);
 
-			Node const *node = 0;
+			Index::Entry const *entry = 0;
 			Record const *record = 0;
 
 			/*
 			 * Walk hardlinks until we reach a file
 			 */
 			for (;;) {
-				node = _root_node.lookup(path);
+				entry = _index.lookup(path);
 
-				if (!node)
+				if (!entry)
 					return STAT_ERR_NO_ENTRY;
 
-				record = node->record;
+				record = entry->value;
 
 				if (record) {
 					if (record->type() == Record::TYPE_HARDLINK) {
@@ -452,7 +282,8 @@ class Vfs::Tar_file_system : public File_system
 						PDBG("found a virtual directoty node");
 
 					memset(&out, 0, sizeof(out));
-					out.mode = STAT_MODE_DIRECTORY;
+					out.mode  = STAT_MODE_DIRECTORY;
+					out.inode = (unsigned long)entry;
 					return STAT_OK;
 				}
 			}
@@ -474,30 +305,32 @@ class Vfs::Tar_file_system : public File_system
 			out.size  = record->size();
 			out.uid   = record->uid();
 			out.gid   = record->gid();
-			out.inode = (unsigned long)node;
+			out.inode = (unsigned long)entry;
 
 			return STAT_OK;
 		}
 
 		Dirent_result dirent(char const *path, off_t index, Dirent &out) override
 		{
-			Node *node = _root_node.lookup(path);
+			Index::Entry *dir = _index.lookup(path);
 
-			if (!node)
+			if (!dir)
 				return DIRENT_ERR_INVALID_PATH;
 
-			node = node->lookup_child(index);
+			Index::Entry *entry = index >= 0 ? dir->child(index) : 0;
 
-			if (!node) {
+			if (!entry) {
 				out.type = DIRENT_TYPE_END;
 				return DIRENT_OK;
 			}
 
-			out.fileno = (unsigned long)node;
+			out.fileno = (unsigned long)entry;
 
-			Record const *record = node->record;
+			Record const *record = entry->value;
 
-			if (record) {
+			if (!record)
+				out.type = DIRENT_TYPE_DIRECTORY;
+			else {
 				switch (record->type()) {
 				case 0: out.type = DIRENT_TYPE_FILE;      break;
 				case 2: out.type = DIRENT_TYPE_SYMLINK;   break;
@@ -509,7 +342,7 @@ class Vfs::Tar_file_system : public File_system
 				}
 			}
 
-			strncpy(out.name, node->name, sizeof(out.name));
+			strncpy(out.name, entry->name(), sizeof(out.name));
 
 			return DIRENT_OK;
 		}
@@ -519,8 +352,8 @@ class Vfs::Tar_file_system : public File_system
 		Readlink_result readlink(char const *path, char *buf, size_t buf_size,
 		                         size_t &out_len) override
 		{
-			Node *node = _root_node.lookup(path);
-			Record const *record = node ? node->record : 0;
+			Index::Entry *entry = _index.lookup(path);
+			Record const *record = entry ? entry->value : 0;
 
 			if (!record || (record->type() != Record::TYPE_SYMLINK))
 				return READLINK_ERR_NO_ENTRY;
@@ -551,17 +384,18 @@ class Vfs::Tar_file_system : public File_system
 
 		size_t num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Index::Entry *entry = _index.lookup(path);
+			return entry ? entry->num_children() : 0;
 		}
 
 		bool is_directory(char const *path) override
 		{
-			Node *node = _root_node.lookup(path);
+			Index::Entry *entry = _index.lookup(path);
 
-			if (!node)
+			if (!entry)
 				return false;
 
-			Record const *record = node->record;
+			Record const *record = entry->value;
 
 			return record ? (record->type() == Record::TYPE_DIR) : true;
 		}
@@ -573,19 +407,18 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
-			return node ? path : 0;
+			return _index.lookup(path) ? path : 0;
 		}
 
 		Open_result open(char const *path, unsigned, Vfs_handle **out_handle) override
 		{
-			Node *node = _root_node.lookup(path);
+			Index::Entry *entry = _index.lookup(path);
 
-			if (!node)
+			if (!entry)
 				return OPEN_ERR_UNACCESSIBLE;
 
 			*out_handle = new (env()->heap())
-				Tar_vfs_handle(*this, 0, node->record);
+				Tar_vfs_handle(*this, 0, entry->value);
 
 			return OPEN_OK;
 		}
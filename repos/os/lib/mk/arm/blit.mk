@@ -1,5 +1,15 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc generic.cc kernels.cc
 REQUIRES = arm 32bit
-INC_DIR += $(REP_DIR)/src/lib/blit/arm
+INC_DIR += $(REP_DIR)/src/lib/blit/arm \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+ifeq ($(filter-out $(SPECS),arm_v7a),)
+SRC_CC         += neon.cc
+CC_OPT_neon    += -mfpu=neon
+CC_OPT_kernels += -DBLIT_NEON
+endif
+
+vpath blit.cc    $(REP_DIR)/src/lib/blit
+vpath generic.cc $(REP_DIR)/src/lib/blit
+vpath kernels.cc $(REP_DIR)/src/lib/blit/arm
+vpath neon.cc    $(REP_DIR)/src/lib/blit/arm
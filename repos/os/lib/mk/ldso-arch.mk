@@ -1,4 +1,5 @@
-SRC_CC = parent_cap.cc binary_name.cc
+SRC_CC = parent_cap.cc binary_name.cc cow_data.cc
 
 vpath parent_cap.cc $(REP_DIR)/src/lib/ldso/arch
 vpath binary_name.cc $(REP_DIR)/src/lib/ldso/arch
+vpath cow_data.cc $(REP_DIR)/src/lib/ldso/arch
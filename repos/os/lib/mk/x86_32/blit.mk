@@ -1,6 +1,13 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc generic.cc kernels.cc sse2.cc avx2.cc
 REQUIRES = x86 32bit
 INC_DIR += $(REP_DIR)/src/lib/blit/x86/x86_32 \
-           $(REP_DIR)/src/lib/blit/x86
+           $(REP_DIR)/src/lib/blit/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+# allow the inline assembly of the SIMD kernels to clobber SSE registers
+CC_OPT_sse2 += -msse2
+CC_OPT_avx2 += -msse2
+
+vpath blit.cc    $(REP_DIR)/src/lib/blit
+vpath generic.cc $(REP_DIR)/src/lib/blit
+vpath %.cc       $(REP_DIR)/src/lib/blit/x86
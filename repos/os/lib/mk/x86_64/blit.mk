@@ -1,6 +1,9 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc generic.cc kernels.cc sse2.cc avx2.cc
 REQUIRES = x86 64bit
 INC_DIR += $(REP_DIR)/src/lib/blit/x86/x86_64 \
-           $(REP_DIR)/src/lib/blit/x86
+           $(REP_DIR)/src/lib/blit/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath blit.cc    $(REP_DIR)/src/lib/blit
+vpath generic.cc $(REP_DIR)/src/lib/blit
+vpath %.cc       $(REP_DIR)/src/lib/blit/x86
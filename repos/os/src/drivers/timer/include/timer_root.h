@@ -38,9 +38,12 @@ namespace Timer {
 			{
 				Genode::size_t ram_quota = Genode::Arg_string::find_arg(args, "ram_quota").ulong_value(0);
 
-				if (ram_quota < sizeof(Session_component)) {
+				/* the session component and its time page */
+				Genode::size_t const require = sizeof(Session_component) + 4096;
+
+				if (ram_quota < require) {
 					PWRN("Insufficient donated ram_quota (%zd bytes), require %zd bytes",
-					     ram_quota, sizeof(Session_component));
+					     ram_quota, require);
 				}
 
 				return new (md_alloc())
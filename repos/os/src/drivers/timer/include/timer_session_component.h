@@ -19,8 +19,10 @@
 /* Genode includes */
 #include <util/list.h>
 #include <os/alarm.h>
+#include <base/env.h>
 #include <base/rpc_server.h>
 #include <timer_session/timer_session.h>
+#include <timer_session/time_page.h>
 
 /* local includes */
 #include "platform_timer.h"
@@ -37,6 +39,165 @@ namespace Timer {
 	};
 
 
+	/**
+	 * Source of the elapsed time of the sessions and their time pages
+	 *
+	 * All functions are called by the entrypoint only.
+	 */
+	class Time_source
+	{
+		public:
+
+			/**
+			 * Time page of a session
+			 */
+			class Page : public Genode::List<Page>::Element
+			{
+				private:
+
+					Genode::Ram_dataspace_capability _ds;
+					Time_page                       *_page;
+					Genode::uint64_t const           _initial_us;
+
+				public:
+
+					/**
+					 * Constructor
+					 *
+					 * \param initial_us  time of session creation
+					 */
+					Page(Genode::uint64_t initial_us)
+					: _page(0), _initial_us(initial_us)
+					{
+						using namespace Genode;
+
+						if (!Time_page::supported())
+							return;
+
+						try {
+							_ds   = env()->ram_session()->alloc(sizeof(Time_page));
+							_page = env()->rm_session()->attach(_ds);
+						} catch (...) {
+							PWRN("could not allocate time page");
+							if (_ds.valid())
+								env()->ram_session()->free(_ds);
+							_ds = Genode::Ram_dataspace_capability();
+						}
+					}
+
+					~Page()
+					{
+						if (!_page)
+							return;
+
+						Genode::env()->rm_session()->detach(_page);
+						Genode::env()->ram_session()->free(_ds);
+					}
+
+					bool valid() const { return _page != 0; }
+
+					Genode::Dataspace_capability dataspace() { return _ds; }
+
+					void update(Genode::uint64_t us, Genode::uint64_t ts,
+					            Genode::uint64_t us_per_ts)
+					{
+						_page->update(us - _initial_us, ts, us_per_ts);
+					}
+			};
+
+		private:
+
+			/*
+			 * Interval of rebasing the time pages on the platform time,
+			 * which also serves for calibrating the timestamp counter
+			 */
+			enum { REBASE_US = 250*1000 };
+
+			Platform_timer    *_platform_timer;
+			unsigned long      _last_time;  /* last read platform time */
+			Genode::uint64_t   _now_us;     /* platform time, not wrapping */
+			Genode::uint64_t   _rebase_us;  /* time of last rebase */
+			Genode::uint64_t   _rebase_ts;  /* timestamp of last rebase */
+			Genode::uint64_t   _us_per_ts;  /* 0 if not calibrated yet */
+			Genode::List<Page> _pages;
+
+		public:
+
+			Time_source(Platform_timer *pt)
+			:
+				_platform_timer(pt), _last_time(pt->curr_time()), _now_us(0),
+				_rebase_us(0), _rebase_ts(Time_page::timestamp()),
+				_us_per_ts(0)
+			{ }
+
+			/**
+			 * Return platform time in microseconds
+			 *
+			 * In contrast to the platform timer, the returned time does not
+			 * wrap around on 32-bit platforms.
+			 */
+			Genode::uint64_t now_us()
+			{
+				unsigned long const t = _platform_timer->curr_time();
+				_now_us   += (unsigned long)(t - _last_time);
+				_last_time = t;
+				return _now_us;
+			}
+
+			/**
+			 * Rebase time pages if the last rebase is long enough ago
+			 */
+			void update()
+			{
+				using Genode::uint64_t;
+
+				if (!Time_page::supported())
+					return;
+
+				uint64_t const us = now_us();
+				uint64_t const ts = Time_page::timestamp();
+
+				if (us - _rebase_us < REBASE_US || ts <= _rebase_ts)
+					return;
+
+				/* keep the fixed-point division within 64 bit */
+				uint64_t d_us = us - _rebase_us, d_ts = ts - _rebase_ts;
+				while (d_us >> (63 - Time_page::SHIFT)) {
+					d_us >>= 1;
+					d_ts >>= 1;
+				}
+
+				if (d_ts)
+					_us_per_ts = (d_us << Time_page::SHIFT) / d_ts;
+
+				_rebase_us = us;
+				_rebase_ts = ts;
+
+				if (!_us_per_ts)
+					return;
+
+				for (Page *p = _pages.first(); p; p = p->next())
+					p->update(us, ts, _us_per_ts);
+			}
+
+			void insert(Page *page)
+			{
+				if (!page->valid())
+					return;
+
+				_pages.insert(page);
+				if (_us_per_ts)
+					page->update(_rebase_us, _rebase_ts, _us_per_ts);
+			}
+
+			void remove(Page *page)
+			{
+				if (page->valid())
+					_pages.remove(page);
+			}
+	};
+
+
 	/**
 	 * Timer interrupt handler
 	 *
@@ -54,6 +215,7 @@ namespace Timer {
 
 			Genode::Alarm_scheduler *_alarm_scheduler;
 			Platform_timer          *_platform_timer;
+			Time_source             *_time_source;
 
 		public:
 
@@ -61,8 +223,9 @@ namespace Timer {
 			 * Constructor
 			 */
 			Irq_dispatcher_component(Genode::Alarm_scheduler *as,
-			                         Platform_timer          *pt)
-			: _alarm_scheduler(as), _platform_timer(pt) { }
+			                         Platform_timer          *pt,
+			                         Time_source             *ts)
+			: _alarm_scheduler(as), _platform_timer(pt), _time_source(ts) { }
 
 
 			/******************************
@@ -79,6 +242,8 @@ namespace Timer {
 				/* trigger timeout alarms */
 				_alarm_scheduler->handle(now);
 
+				_time_source->update();
+
 				/* determine duration for next one-shot timer event */
 				Alarm::Time deadline;
 				if (_alarm_scheduler->next_deadline(&deadline))
@@ -140,6 +305,7 @@ namespace Timer {
 			        Irq_dispatcher_capability;
 
 			Platform_timer           *_platform_timer;
+			Time_source               _time_source;
 			Irq_dispatcher_component  _irq_dispatcher_component;
 			Irq_dispatcher_capability _irq_dispatcher_cap;
 
@@ -174,7 +340,8 @@ namespace Timer {
 			:
 				Thread("timeout_scheduler"),
 				_platform_timer(pt),
-				_irq_dispatcher_component(this, pt),
+				_time_source(pt),
+				_irq_dispatcher_component(this, pt, &_time_source),
 				_irq_dispatcher_cap(ep->manage(&_irq_dispatcher_component))
 			{
 				_platform_timer->schedule_timeout(0);
@@ -201,6 +368,11 @@ namespace Timer {
 			{
 				return _platform_timer->curr_time();
 			}
+
+			/**
+			 * Called from the server activation only
+			 */
+			Time_source &time_source() { return _time_source; }
 	};
 
 
@@ -212,9 +384,13 @@ namespace Timer {
 	{
 		private:
 
-			Timeout_scheduler  &_timeout_scheduler;
-			Wake_up_alarm       _wake_up_alarm;
-			unsigned long const _initial_time;
+			Timeout_scheduler      &_timeout_scheduler;
+			Wake_up_alarm           _wake_up_alarm;
+			Genode::uint64_t const  _initial_us;
+			Time_source::Page       _time_page;
+
+			Time_source &_time_source() {
+				return _timeout_scheduler.time_source(); }
 
 			void _trigger(unsigned us, bool periodic)
 			{
@@ -230,8 +406,11 @@ namespace Timer {
 			Session_component(Timeout_scheduler &ts)
 			:
 				_timeout_scheduler(ts),
-				_initial_time(_timeout_scheduler.curr_time())
-			{ }
+				_initial_us(ts.time_source().now_us()),
+				_time_page(_initial_us)
+			{
+				_time_source().insert(&_time_page);
+			}
 
 			/**
 			 * Destructor
@@ -239,6 +418,7 @@ namespace Timer {
 			~Session_component()
 			{
 				_timeout_scheduler.discard(&_wake_up_alarm);
+				_time_source().remove(&_time_page);
 			}
 
 
@@ -263,8 +443,21 @@ namespace Timer {
 
 			unsigned long elapsed_ms() const
 			{
-				unsigned long const now = _timeout_scheduler.curr_time();
-				return (now - _initial_time) / 1000;
+				return elapsed_us() / 1000;
+			}
+
+			Genode::uint64_t elapsed_us() const
+			{
+				Time_source &source = _timeout_scheduler.time_source();
+
+				/* a client falls back to the RPC if its page is stale */
+				source.update();
+				return source.now_us() - _initial_us;
+			}
+
+			Dataspace_capability time_page()
+			{
+				return _time_page.dataspace();
 			}
 
 			void msleep(unsigned) { /* never called at the server side */ }
@@ -17,65 +17,92 @@
 using namespace Genode;
 
 
-void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
+Alarm *Alarm_scheduler::_meld(Alarm *a, Alarm *b)
 {
-	/* do not enqueue twice */
-	if (alarm->_active)
-		return;
+	if (!a) return b;
+	if (!b) return a;
 
-	alarm->_active++;
+	/* the root with the later deadline becomes the first child of the other */
+	if (_before(b->_deadline, a->_deadline)) {
+		Alarm *tmp = a; a = b; b = tmp; }
 
-	/* if alarmlist is empty add first element */
-	if (!_head) {
-		alarm->_next = 0;
-		_head = alarm;
-		return;
+	b->_prev    = a;
+	b->_sibling = a->_child;
+	if (a->_child)
+		a->_child->_prev = b;
+	a->_child = b;
+
+	return a;
+}
+
+
+Alarm *Alarm_scheduler::_merge_pairs(Alarm *first)
+{
+	/*
+	 * Meld the heaps pairwise from left to right and chain the results in
+	 * reverse order. The iteration avoids a recursion as deep as the number
+	 * of siblings.
+	 */
+	Alarm *pairs = 0;
+	while (first) {
+		Alarm *a = first, *b = first->_sibling;
+		first = b ? b->_sibling : 0;
+
+		a->_sibling = a->_prev = 0;
+		if (b) {
+			b->_sibling = b->_prev = 0;
+			a = _meld(a, b);
+		}
+		a->_sibling = pairs;
+		pairs = a;
 	}
 
-	/* if deadline is smaller than any other deadline, put it on the head */
-	if ((int)alarm->_deadline - (int)_now < (int)_head->_deadline - (int)_now) {
-		alarm->_next = _head;
-		_head = alarm;
-		return;
+	/* meld the resulting heaps from right to left */
+	Alarm *root = 0;
+	while (pairs) {
+		Alarm *next = pairs->_sibling;
+		pairs->_sibling = 0;
+		root = _meld(root, pairs);
+		pairs = next;
 	}
+	return root;
+}
 
-	/* find list element with a higher deadline */
-	Alarm *curr = _head;
-	while (curr->_next &&
-	       (int)curr->_next->_deadline - (int)_now < (int)alarm->_deadline - (int)_now)
-		curr = curr->_next;
 
-	/* if end of list is reached, append new element */
-	if (curr->_next == 0) {
-		curr->_next = alarm;
+void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
+{
+	/* do not enqueue twice */
+	if (alarm->_active)
 		return;
-	}
 
-	/* insert element in middle of list */
-	alarm->_next = curr->_next;
-	curr->_next  = alarm;
+	alarm->_active++;
+	alarm->_child = alarm->_sibling = alarm->_prev = 0;
+
+	_head = _meld(_head, alarm);
 }
 
 
 void Alarm_scheduler::_unsynchronized_dequeue(Alarm *alarm)
 {
-	if (!_head) return;
+	/* alarm is not enqueued */
+	if (!alarm->_active || alarm->_scheduler != this) return;
 
 	if (_head == alarm) {
-		_head = alarm->_next;
+		_head = _merge_pairs(alarm->_child);
 		alarm->_reset();
 		return;
 	}
 
-	/* find predecessor in alarm queue */
-	Alarm *curr;
-	for (curr = _head; curr && (curr->_next != alarm); curr = curr->_next);
+	/* cut subtree of alarm from its parent or previous sibling */
+	if (alarm->_prev->_child == alarm)
+		alarm->_prev->_child = alarm->_sibling;
+	else
+		alarm->_prev->_sibling = alarm->_sibling;
 
-	/* alarm is not enqueued */
-	if (!curr) return;
+	if (alarm->_sibling)
+		alarm->_sibling->_prev = alarm->_prev;
 
-	/* remove alarm from alarm queue */
-	curr->_next = alarm->_next;
+	_head = _meld(_head, _merge_pairs(alarm->_child));
 	alarm->_reset();
 }
 
@@ -84,12 +111,12 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 {
 	Lock::Guard lock_guard(_lock);
 
-	if (!_head || ((int)_head->_deadline - (int)_now >= 0))
+	if (!_head || !_before(_head->_deadline, _now))
 		return 0;
 
-	/* remove alarm from head of the list */
+	/* remove alarm from root of the heap */
 	Alarm *pending_alarm = _head;
-	_head = _head->_next;
+	_head = _merge_pairs(_head->_child);
 
 	/*
 	 * Acquire dispatch lock to defer destruction until the call of 'on_alarm'
@@ -98,7 +125,7 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 	pending_alarm->_dispatch_lock.lock();
 
 	/* reset alarm object */
-	pending_alarm->_next = 0;
+	pending_alarm->_child = pending_alarm->_sibling = pending_alarm->_prev = 0;
 	pending_alarm->_active--;
 
 	return pending_alarm;
@@ -150,6 +177,10 @@ void Alarm_scheduler::schedule_absolute(Alarm *alarm, Alarm::Time timeout)
 {
 	Lock::Guard alarm_list_lock_guard(_lock);
 
+	/* move an alarm that is already scheduled to its new position */
+	if (alarm->_active)
+		_unsynchronized_dequeue(alarm);
+
 	alarm->_assign(0, timeout, this);
 	_unsynchronized_enqueue(alarm);
 }
@@ -159,6 +190,9 @@ void Alarm_scheduler::schedule(Alarm *alarm, Alarm::Time period)
 {
 	Lock::Guard alarm_list_lock_guard(_lock);
 
+	if (alarm->_active)
+		_unsynchronized_dequeue(alarm);
+
 	/* first deadline is overdue */
 	alarm->_assign(period, _now, this);
 	_unsynchronized_enqueue(alarm);
@@ -204,13 +238,13 @@ Alarm_scheduler::~Alarm_scheduler()
 
 	while (_head) {
 
-		Alarm *next = _head->_next;
+		Alarm *alarm = _head;
 
-		/* reset alarm object */
-		_head->_reset();
+		/* remove from heap */
+		_head = _merge_pairs(alarm->_child);
 
-		/* remove from list */
-		_head = next;
+		/* reset alarm object */
+		alarm->_reset();
 	}
 }
 
@@ -0,0 +1,34 @@
+/*
+ * \brief  Selection of blitting kernels for ARM
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * User-level code cannot probe for NEON on ARM. Hence, the NEON kernels
+ * are built for ARMv7 platforms only, which define 'BLIT_NEON'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <kernels.h>
+
+using namespace Blit;
+
+
+Kernels const *Blit::kernels(Blit_kernels which)
+{
+	switch (which) {
+#ifdef BLIT_NEON
+	case BLIT_KERNELS_AUTO:
+	case BLIT_KERNELS_NEON:    return &neon_kernels;
+#else
+	case BLIT_KERNELS_AUTO:
+#endif
+	case BLIT_KERNELS_GENERIC: return &generic_kernels;
+	default:                   return 0;
+	}
+}
@@ -0,0 +1,152 @@
+/*
+ * \brief  Blitting kernels using NEON
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The kernels are written in inline assembly and used on ARMv7 only.
+ * NEON offers no non-temporal stores, hence, the copy kernel merely
+ * prefetches the source.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <util/string.h>
+#include <kernels.h>
+
+using namespace Blit;
+
+
+static void copy(char const *src, unsigned src_w,
+                 char *dst, unsigned dst_w, int w, int h)
+{
+	for (; h-- > 0; src += src_w, dst += dst_w) {
+
+		char const *s = src;
+		char       *d = dst;
+		unsigned long chunks = w / 64;
+
+		if (chunks)
+			asm volatile (
+				"0:                           \n\t"
+				"pld     [%0, #192]           \n\t"
+				"vld1.8  {d0-d3}, [%0]!       \n\t"
+				"vld1.8  {d4-d7}, [%0]!       \n\t"
+				"vst1.8  {d0-d3}, [%1]!       \n\t"
+				"vst1.8  {d4-d7}, [%1]!       \n\t"
+				"subs    %2, %2, #1           \n\t"
+				"bne     0b                   \n\t"
+				: "+r" (s), "+r" (d), "+r" (chunks)
+				:
+				: "memory", "cc", "d0", "d1", "d2", "d3",
+				  "d4", "d5", "d6", "d7");
+
+		Genode::memcpy(d, s, w % 64);
+	}
+}
+
+
+static void rgb565_to_rgba8888(uint32_t *dst, uint16_t const *src, int n)
+{
+	unsigned long chunks = n / 8;
+
+	/*
+	 * The channels are extracted into the upper bits of the blue (d2),
+	 * green (d3), and red (d4) bytes, whose lower bits are filled with the
+	 * upper bits of the channel. Storing interleaves them with alpha (d5).
+	 */
+	if (chunks)
+		asm volatile (
+			"vmov.i8    d5, #255                 \n\t"
+			"0:                                  \n\t"
+			"vld1.16    {q0}, [%0]!              \n\t"
+			"vshrn.i16  d4, q0, #8               \n\t"
+			"vshrn.i16  d3, q0, #3               \n\t"
+			"vmovn.i16  d2, q0                   \n\t"
+			"vshl.i8    d2, d2, #3               \n\t"
+			"vsri.8     d4, d4, #5               \n\t"
+			"vsri.8     d3, d3, #6               \n\t"
+			"vsri.8     d2, d2, #5               \n\t"
+			"vst4.8     {d2-d5}, [%1]!           \n\t"
+			"subs       %2, %2, #1               \n\t"
+			"bne        0b                       \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			:
+			: "memory", "cc", "d0", "d1", "d2", "d3", "d4", "d5");
+
+	for (int i = 0; i < n % 8; i++)
+		dst[i] = rgba8888(src[i]);
+}
+
+
+static void rgba8888_to_rgb565(uint16_t *dst, uint32_t const *src, int n)
+{
+	unsigned long chunks = n / 8;
+
+	if (chunks)
+		asm volatile (
+			"0:                                  \n\t"
+			"vld4.8     {d0-d3}, [%0]!           \n\t"
+			"vshll.u8   q2, d2, #8               \n\t"
+			"vshll.u8   q3, d1, #8               \n\t"
+			"vshll.u8   q8, d0, #8               \n\t"
+			"vsri.16    q2, q3, #5               \n\t"
+			"vsri.16    q2, q8, #11              \n\t"
+			"vst1.16    {q2}, [%1]!              \n\t"
+			"subs       %2, %2, #1               \n\t"
+			"bne        0b                       \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			:
+			: "memory", "cc", "d0", "d1", "d2", "d3", "d4", "d5",
+			  "d6", "d7", "d16", "d17");
+
+	for (int i = 0; i < n % 8; i++)
+		dst[i] = rgb565(src[i]);
+}
+
+
+static void blend_rgba8888(uint32_t *dst, uint32_t const *src, int n)
+{
+	unsigned long chunks = n / 8;
+
+	/*
+	 * Blend channel 'd' with channel 's', 'd20' holds '255 - a'. The
+	 * rounding narrowing equals '(t + (t >> 8)) >> 8' with 't' including
+	 * the bias of 128.
+	 */
+#define BLEND_CHANNEL(s, d)                 \
+	"vmull.u8   q8, " s ", d3        \n\t" \
+	"vmlal.u8   q8, " d ", d20       \n\t" \
+	"vrshr.u16  q9, q8, #8           \n\t" \
+	"vraddhn.i16 " d ", q8, q9       \n\t"
+
+	if (chunks)
+		asm volatile (
+			"0:                                  \n\t"
+			"vld4.8     {d0-d3}, [%0]!           \n\t"
+			"vld4.8     {d4-d7}, [%1]            \n\t"
+			"vmvn       d20, d3                  \n\t"
+			BLEND_CHANNEL("d0", "d4")
+			BLEND_CHANNEL("d1", "d5")
+			BLEND_CHANNEL("d2", "d6")
+			"vst4.8     {d4-d7}, [%1]!           \n\t"
+			"subs       %2, %2, #1               \n\t"
+			"bne        0b                       \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			:
+			: "memory", "cc", "d0", "d1", "d2", "d3", "d4", "d5",
+			  "d6", "d7", "d16", "d17", "d18", "d19", "d20");
+
+#undef BLEND_CHANNEL
+
+	for (int i = 0; i < n % 8; i++)
+		dst[i] = blend(dst[i], src[i]);
+}
+
+
+Kernels const Blit::neon_kernels = {
+	"NEON", copy, rgb565_to_rgba8888, rgba8888_to_rgb565, blend_rgba8888 };
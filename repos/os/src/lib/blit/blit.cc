@@ -1,5 +1,5 @@
 /*
- * \brief  Generic blitting function
+ * \brief  Blitting functions dispatching to the selected kernels
  * \author Norman Feske
  * \date   2007-10-10
  */
@@ -12,45 +12,165 @@
  */
 
 #include <blit/blit.h>
-#include <blit_helper.h>
+#include <kernels.h>
 
+using namespace Blit;
 
-extern "C" void blit(void const *s, unsigned src_w,
-                     void *d, unsigned dst_w,
-                     int w, int h)
+
+static Kernels const *_selected;
+
+
+/**
+ * Return selected kernels, pick the fastest set on the first call
+ *
+ * Concurrent first calls are harmless because all of them select the
+ * same set.
+ */
+static inline Kernels const &_kernels()
 {
-	char const *src = (char const *)s;
-	char       *dst = (char       *)d;
+	if (!_selected)
+		_selected = kernels(BLIT_KERNELS_AUTO);
+
+	return *_selected;
+}
+
+
+extern "C" int blit_select_kernels(enum Blit_kernels which)
+{
+	Kernels const *k = kernels(which);
+	if (!k)
+		return -1;
+
+	_selected = k;
+	return 0;
+}
 
-	if (w <= 0 || h <= 0) return;
 
+extern "C" char const *blit_kernels_name(void) { return _kernels().name; }
+
+
+extern "C" void blit(void const *src, unsigned src_w,
+                     void *dst, unsigned dst_w,
+                     int w, int h)
+{
 	/* we support blitting only at a granularity of 16bit */
 	w &= ~1;
 
-	/* copy unaligned column */
-	if (w && ((long)dst & 2)) {
-		copy_16bit_column(src, src_w, dst, dst_w, h);
-		w -= 2; src += 2; dst += 2;
+	if (w <= 0 || h <= 0) return;
+
+	_kernels().copy((char const *)src, src_w, (char *)dst, dst_w, w, h);
+}
+
+
+static unsigned _bytes_per_pixel(Blit_format format)
+{
+	switch (format) {
+	case BLIT_RGB565: return 2;
+	case BLIT_RGB888: return 3;
+	default:          return 4;
+	}
+}
+
+
+/**
+ * Read pixel of any format as RGBA8888 pixel
+ */
+static uint32_t _read(Blit_format format, char const *p)
+{
+	unsigned char const *b = (unsigned char const *)p;
+
+	switch (format) {
+	case BLIT_RGB565: return rgba8888(*(uint16_t const *)p);
+	case BLIT_RGB888: return 0xff000000 | b[2] << 16 | b[1] << 8 | b[0];
+	default:          return *(uint32_t const *)p;
+	}
+}
+
+
+/**
+ * Write RGBA8888 pixel in any format
+ */
+static void _write(Blit_format format, char *p, uint32_t v)
+{
+	unsigned char *b = (unsigned char *)p;
+
+	switch (format) {
+	case BLIT_RGB565:   *(uint16_t *)p = rgb565(v); break;
+	case BLIT_RGB888:   b[0] = v; b[1] = v >> 8; b[2] = v >> 16; break;
+	case BLIT_RGBA8888: *(uint32_t *)p = v; break;
 	}
+}
+
+
+extern "C" void blit_convert(void const *s, unsigned src_w,
+                             enum Blit_format src_fmt,
+                             void *d, unsigned dst_w,
+                             enum Blit_format dst_fmt, int w, int h)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
 
-	/* now, we are on a 32bit aligned destination address */
+	if (w <= 0 || h <= 0) return;
 
-	/* copy 32byte chunks */
-	if (w >> 5) {
-		copy_block_32byte(src, src_w, dst, dst_w, w >> 5, h);
-		src += w & ~31;
-		dst += w & ~31;
-		w    = w &  31;
+	if (src_fmt == dst_fmt) {
+		blit(src, src_w, dst, dst_w, w*_bytes_per_pixel(src_fmt), h);
+		return;
 	}
 
-	/* copy 32bit chunks */
-	if (w >> 2) {
-		copy_block_32bit(src, src_w, dst, dst_w, w >> 2, h);
-		src += w & ~3;
-		dst += w & ~3;
-		w    = w &  3;
+	Kernels const &k = _kernels();
+
+	for (; h-- > 0; src += src_w, dst += dst_w) {
+
+		if (src_fmt == BLIT_RGB565 && dst_fmt == BLIT_RGBA8888)
+			k.rgb565_to_rgba8888((uint32_t *)dst, (uint16_t const *)src, w);
+
+		else if (src_fmt == BLIT_RGBA8888 && dst_fmt == BLIT_RGB565)
+			k.rgba8888_to_rgb565((uint16_t *)dst, (uint32_t const *)src, w);
+
+		/* conversions from or to RGB888 are uncommon, no kernels for them */
+		else {
+			unsigned const src_bpp = _bytes_per_pixel(src_fmt),
+			               dst_bpp = _bytes_per_pixel(dst_fmt);
+			for (int i = 0; i < w; i++)
+				_write(dst_fmt, dst + i*dst_bpp, _read(src_fmt, src + i*src_bpp));
+		}
 	}
+}
+
+
+extern "C" void blit_alpha(void const *s, unsigned src_w,
+                           void *d, unsigned dst_w,
+                           enum Blit_format dst_fmt, int w, int h)
+{
+	char const *src = (char const *)s;
+	char       *dst = (char       *)d;
+
+	if (w <= 0 || h <= 0 || dst_fmt == BLIT_RGB888) return;
+
+	Kernels const &k = _kernels();
+
+	for (; h-- > 0; src += src_w, dst += dst_w) {
 
-	/* handle trailing row */
-	if (w >> 1) copy_16bit_column(src, src_w, dst, dst_w, h);
+		uint32_t const *src_line = (uint32_t const *)src;
+
+		if (dst_fmt == BLIT_RGBA8888) {
+			k.blend_rgba8888((uint32_t *)dst, src_line, w);
+			continue;
+		}
+
+		/*
+		 * Blend RGB565 pixels in chunks, which are expanded to RGBA8888
+		 * in a buffer on the stack
+		 */
+		enum { CHUNK = 128 };
+		uint32_t buf[CHUNK] __attribute__((aligned(32)));
+
+		uint16_t *dst_line = (uint16_t *)dst;
+		for (int i = 0; i < w; i += CHUNK) {
+			int const n = w - i < CHUNK ? w - i : CHUNK;
+			k.rgb565_to_rgba8888(buf, dst_line + i, n);
+			k.blend_rgba8888(buf, src_line + i, n);
+			k.rgba8888_to_rgb565(dst_line + i, buf, n);
+		}
+	}
 }
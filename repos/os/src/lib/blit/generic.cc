@@ -0,0 +1,74 @@
+/*
+ * \brief  Generic blitting kernels
+ * \author Norman Feske
+ * \date   2007-10-10
+ */
+
+/*
+ * Copyright (C) 2007-2013 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <blit_helper.h>
+#include <kernels.h>
+
+using namespace Blit;
+
+
+static void copy(char const *src, unsigned src_w,
+                 char *dst, unsigned dst_w, int w, int h)
+{
+	/* copy unaligned column */
+	if (w && ((long)dst & 2)) {
+		copy_16bit_column(src, src_w, dst, dst_w, h);
+		w -= 2; src += 2; dst += 2;
+	}
+
+	/* now, we are on a 32bit aligned destination address */
+
+	/* copy 32byte chunks */
+	if (w >> 5) {
+		copy_block_32byte(src, src_w, dst, dst_w, w >> 5, h);
+		src += w & ~31;
+		dst += w & ~31;
+		w    = w &  31;
+	}
+
+	/* copy 32bit chunks */
+	if (w >> 2) {
+		copy_block_32bit(src, src_w, dst, dst_w, w >> 2, h);
+		src += w & ~3;
+		dst += w & ~3;
+		w    = w &  3;
+	}
+
+	/* handle trailing row */
+	if (w >> 1) copy_16bit_column(src, src_w, dst, dst_w, h);
+}
+
+
+static void rgb565_to_rgba8888(uint32_t *dst, uint16_t const *src, int n)
+{
+	for (int i = 0; i < n; i++)
+		dst[i] = rgba8888(src[i]);
+}
+
+
+static void rgba8888_to_rgb565(uint16_t *dst, uint32_t const *src, int n)
+{
+	for (int i = 0; i < n; i++)
+		dst[i] = rgb565(src[i]);
+}
+
+
+static void blend_rgba8888(uint32_t *dst, uint32_t const *src, int n)
+{
+	for (int i = 0; i < n; i++)
+		dst[i] = blend(dst[i], src[i]);
+}
+
+
+Kernels const Blit::generic_kernels = {
+	"generic", copy, rgb565_to_rgba8888, rgba8888_to_rgb565, blend_rgba8888 };
@@ -0,0 +1,24 @@
+/*
+ * \brief  Selection of blitting kernels for CPUs without SIMD kernels
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <kernels.h>
+
+
+Blit::Kernels const *Blit::kernels(Blit_kernels which)
+{
+	switch (which) {
+	case BLIT_KERNELS_AUTO:
+	case BLIT_KERNELS_GENERIC: return &generic_kernels;
+	default:                   return 0;
+	}
+}
@@ -0,0 +1,114 @@
+/*
+ * \brief  Sets of blitting kernels
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LIB__BLIT__KERNELS_H_
+#define _LIB__BLIT__KERNELS_H_
+
+#include <base/stdint.h>
+#include <blit/blit.h>
+
+namespace Blit {
+
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+
+	struct Kernels;
+
+	/**
+	 * Number of bytes per blit operation starting from which the copy
+	 * kernels bypass the cache
+	 *
+	 * Below this size, the destination is likely to be read again soon,
+	 * e.g., by a subsequent blending operation.
+	 */
+	enum { STREAM_THRESHOLD = 512*1024 };
+
+	/**
+	 * Return set of kernels
+	 *
+	 * \return  0 if the set is not supported by the CPU
+	 *
+	 * For 'BLIT_KERNELS_AUTO', the fastest supported set is returned.
+	 * This function is implemented for each architecture.
+	 */
+	Kernels const *kernels(Blit_kernels);
+
+	extern Kernels const generic_kernels;
+	extern Kernels const sse2_kernels;
+	extern Kernels const avx2_kernels;
+	extern Kernels const neon_kernels;
+
+	/**
+	 * Convert RGB565 pixel to opaque RGBA8888 pixel
+	 */
+	inline uint32_t rgba8888(uint16_t p)
+	{
+		uint32_t const r = p >> 11, g = (p >> 5) & 0x3f, b = p & 0x1f;
+
+		return 0xff000000 | ((r << 3 | r >> 2) << 16)
+		                  | ((g << 2 | g >> 4) <<  8)
+		                  |  (b << 3 | b >> 2);
+	}
+
+	/**
+	 * Convert RGBA8888 pixel to RGB565 pixel
+	 */
+	inline uint16_t rgb565(uint32_t p)
+	{
+		return ((p >> 8) & 0xf800) | ((p >> 5) & 0x07e0) | ((p >> 3) & 0x001f);
+	}
+
+	/**
+	 * Composite RGBA8888 pixel 's' over pixel 'd'
+	 *
+	 * Each channel becomes '(t + (t >> 8)) >> 8' with
+	 * 't = s*a + d*(255 - a) + 128', which is exact for the division by
+	 * 255. All kernels must produce the same result.
+	 */
+	inline uint32_t blend(uint32_t d, uint32_t s)
+	{
+		uint32_t const a = s >> 24;
+
+		uint32_t result = d & 0xff000000;
+		for (unsigned shift = 0; shift < 24; shift += 8) {
+			uint32_t t = ((s >> shift) & 0xff)*a
+			           + ((d >> shift) & 0xff)*(255 - a) + 128;
+			result |= ((t + (t >> 8)) >> 8) << shift;
+		}
+		return result;
+	}
+}
+
+
+struct Blit::Kernels
+{
+	char const *name;
+
+	/**
+	 * Copy block
+	 *
+	 * \param w  number of bytes per line, a multiple of 2 and not zero
+	 * \param h  number of lines, not zero
+	 */
+	void (*copy)(char const *src, unsigned src_w,
+	             char *dst, unsigned dst_w, int w, int h);
+
+	/*
+	 * Line kernels operating on 'n' pixels
+	 */
+	void (*rgb565_to_rgba8888)(uint32_t *dst, uint16_t const *src, int n);
+	void (*rgba8888_to_rgb565)(uint16_t *dst, uint32_t const *src, int n);
+	void (*blend_rgba8888)    (uint32_t *dst, uint32_t const *src, int n);
+};
+
+#endif /* _LIB__BLIT__KERNELS_H_ */
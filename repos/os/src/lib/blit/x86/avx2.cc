@@ -0,0 +1,270 @@
+/*
+ * \brief  Blitting kernels using AVX2
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The kernels are written in inline assembly and work on x86_32 and x86_64.
+ * They must only be called if the CPU supports AVX2 and the kernel saves
+ * the AVX register state. Each kernel clears the upper halves of the
+ * registers when done to avoid the penalty of subsequent SSE instructions.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <util/string.h>
+#include <kernels.h>
+
+using namespace Blit;
+
+
+#define SPLAT16(v) { v, v, v, v, v, v, v, v, v, v, v, v, v, v, v, v }
+#define SPLAT8(v)  { v, v, v, v, v, v, v, v }
+
+static uint16_t const c_001f[16] __attribute__((aligned(32))) = SPLAT16(0x001f);
+static uint16_t const c_003f[16] __attribute__((aligned(32))) = SPLAT16(0x003f);
+static uint16_t const c_ff00[16] __attribute__((aligned(32))) = SPLAT16(0xff00);
+static uint16_t const c_0080[16] __attribute__((aligned(32))) = SPLAT16(0x0080);
+static uint16_t const c_0101[16] __attribute__((aligned(32))) = SPLAT16(0x0101);
+static uint32_t const c_r565[8]  __attribute__((aligned(32))) = SPLAT8(0xf800);
+static uint32_t const c_g565[8]  __attribute__((aligned(32))) = SPLAT8(0x07e0);
+static uint32_t const c_b565[8]  __attribute__((aligned(32))) = SPLAT8(0x001f);
+static uint32_t const c_rgb[8]   __attribute__((aligned(32))) = SPLAT8(0x00ffffff);
+static uint32_t const c_a[8]     __attribute__((aligned(32))) = SPLAT8(0xff000000);
+
+
+/**
+ * Copy 128-byte chunks to 32-byte aligned destination
+ *
+ * \param store  instruction used for storing a register
+ */
+#define COPY_128BYTE_CHUNKS(store)         \
+	"0:                             \n\t" \
+	"prefetchnta 512(%0)            \n\t" \
+	"vmovdqu    (%0), %%ymm0        \n\t" \
+	"vmovdqu  32(%0), %%ymm1        \n\t" \
+	"vmovdqu  64(%0), %%ymm2        \n\t" \
+	"vmovdqu  96(%0), %%ymm3        \n\t" \
+	store "   %%ymm0,   (%1)        \n\t" \
+	store "   %%ymm1, 32(%1)        \n\t" \
+	store "   %%ymm2, 64(%1)        \n\t" \
+	store "   %%ymm3, 96(%1)        \n\t" \
+	"add      $128, %0              \n\t" \
+	"add      $128, %1              \n\t" \
+	"dec      %2                    \n\t" \
+	"jnz      0b                    \n\t" \
+	"vzeroupper                     \n\t"
+
+
+static inline void copy_line(char const *src, char *dst, unsigned long n,
+                             bool stream)
+{
+	/* copy head until the destination is aligned */
+	unsigned long const head = (-(unsigned long)dst & 31) < n
+	                         ?  -(unsigned long)dst & 31 : n;
+	Genode::memcpy(dst, src, head);
+	src += head; dst += head; n -= head;
+
+	unsigned long chunks = n / 128;
+	n %= 128;
+
+	if (chunks && stream)
+		asm volatile (COPY_128BYTE_CHUNKS("vmovntdq")
+		              : "+r" (src), "+r" (dst), "+r" (chunks)
+		              :
+		              : "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+	else if (chunks)
+		asm volatile (COPY_128BYTE_CHUNKS("vmovdqa")
+		              : "+r" (src), "+r" (dst), "+r" (chunks)
+		              :
+		              : "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+
+	Genode::memcpy(dst, src, n);
+}
+
+
+static void copy(char const *src, unsigned src_w,
+                 char *dst, unsigned dst_w, int w, int h)
+{
+	bool const stream = (unsigned long)w*h >= STREAM_THRESHOLD;
+
+	for (; h-- > 0; src += src_w, dst += dst_w)
+		copy_line(src, dst, w, stream);
+
+	/* order the non-temporal stores before any subsequent store */
+	if (stream)
+		asm volatile ("sfence" : : : "memory");
+}
+
+
+static void rgb565_to_rgba8888(uint32_t *dst, uint16_t const *src, int n)
+{
+	unsigned long chunks = n / 16;
+
+	if (chunks)
+		asm volatile (
+			"0:                                     \n\t"
+			"vmovdqu    (%0), %%ymm0                \n\t"
+
+			/* red and alpha words */
+			"vpsrlw     $11, %%ymm0, %%ymm1         \n\t"
+			"vpsllw     $3, %%ymm1, %%ymm2          \n\t"
+			"vpsrlw     $2, %%ymm1, %%ymm1          \n\t"
+			"vpor       %%ymm2, %%ymm1, %%ymm1      \n\t"
+			"vpor       %[cff00], %%ymm1, %%ymm1    \n\t"
+
+			/* green byte, shifted to the upper half of the word */
+			"vpsrlw     $5, %%ymm0, %%ymm2          \n\t"
+			"vpand      %[c003f], %%ymm2, %%ymm2    \n\t"
+			"vpsrlw     $4, %%ymm2, %%ymm3          \n\t"
+			"vpsllw     $2, %%ymm2, %%ymm2          \n\t"
+			"vpor       %%ymm3, %%ymm2, %%ymm2      \n\t"
+			"vpsllw     $8, %%ymm2, %%ymm2          \n\t"
+
+			/* blue byte, merged with green */
+			"vpand      %[c001f], %%ymm0, %%ymm0    \n\t"
+			"vpsrlw     $2, %%ymm0, %%ymm3          \n\t"
+			"vpsllw     $3, %%ymm0, %%ymm0          \n\t"
+			"vpor       %%ymm3, %%ymm0, %%ymm0      \n\t"
+			"vpor       %%ymm2, %%ymm0, %%ymm0      \n\t"
+
+			/*
+			 * Interleave green/blue and alpha/red words, which operates
+			 * within 128-bit lanes, and restore the order of the lanes
+			 */
+			"vpunpcklwd %%ymm1, %%ymm0, %%ymm2      \n\t"
+			"vpunpckhwd %%ymm1, %%ymm0, %%ymm3      \n\t"
+			"vperm2i128 $0x20, %%ymm3, %%ymm2, %%ymm0 \n\t"
+			"vperm2i128 $0x31, %%ymm3, %%ymm2, %%ymm1 \n\t"
+			"vmovdqu    %%ymm0,   (%1)              \n\t"
+			"vmovdqu    %%ymm1, 32(%1)              \n\t"
+
+			"add        $32, %0                     \n\t"
+			"add        $64, %1                     \n\t"
+			"dec        %2                          \n\t"
+			"jnz        0b                          \n\t"
+			"vzeroupper                             \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			: [cff00] "m" (c_ff00), [c003f] "m" (c_003f), [c001f] "m" (c_001f)
+			: "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+
+	for (int i = 0; i < n % 16; i++)
+		dst[i] = rgba8888(src[i]);
+}
+
+
+static void rgba8888_to_rgb565(uint16_t *dst, uint32_t const *src, int n)
+{
+	unsigned long chunks = n / 16;
+
+	/*
+	 * The 565 values are computed in dwords, sign-extended, and packed
+	 * into words with signed saturation, which keeps them unchanged.
+	 */
+#define RGB565_DWORDS(x)                       \
+	"vpsrld     $8, " x ", %%ymm2       \n\t" \
+	"vpand      %[r], %%ymm2, %%ymm2    \n\t" \
+	"vpsrld     $5, " x ", %%ymm3       \n\t" \
+	"vpand      %[g], %%ymm3, %%ymm3    \n\t" \
+	"vpsrld     $3, " x ", " x "        \n\t" \
+	"vpand      %[b], " x ", " x "      \n\t" \
+	"vpor       %%ymm2, " x ", " x "    \n\t" \
+	"vpor       %%ymm3, " x ", " x "    \n\t" \
+	"vpslld     $16, " x ", " x "       \n\t" \
+	"vpsrad     $16, " x ", " x "       \n\t"
+
+	if (chunks)
+		asm volatile (
+			"0:                                     \n\t"
+			"vmovdqu    (%0), %%ymm0                \n\t"
+			"vmovdqu    32(%0), %%ymm1              \n\t"
+			RGB565_DWORDS("%%ymm0")
+			RGB565_DWORDS("%%ymm1")
+
+			/* the packing operates within 128-bit lanes */
+			"vpackssdw  %%ymm1, %%ymm0, %%ymm0      \n\t"
+			"vpermq     $0xd8, %%ymm0, %%ymm0       \n\t"
+			"vmovdqu    %%ymm0, (%1)                \n\t"
+
+			"add        $64, %0                     \n\t"
+			"add        $32, %1                     \n\t"
+			"dec        %2                          \n\t"
+			"jnz        0b                          \n\t"
+			"vzeroupper                             \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			: [r] "m" (c_r565), [g] "m" (c_g565), [b] "m" (c_b565)
+			: "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+
+#undef RGB565_DWORDS
+
+	for (int i = 0; i < n % 16; i++)
+		dst[i] = rgb565(src[i]);
+}
+
+
+static void blend_rgba8888(uint32_t *dst, uint32_t const *src, int n)
+{
+	unsigned long chunks = n / 8;
+
+	/*
+	 * Blend pixels unpacked to words as done by the SSE2 kernel. The
+	 * unpacking and packing both operate within 128-bit lanes, which
+	 * leaves the order of the pixels intact.
+	 */
+#define BLEND_WORDS(s, d)                       \
+	"vpshuflw   $0xff, " s ", %%ymm4     \n\t" \
+	"vpshufhw   $0xff, %%ymm4, %%ymm4    \n\t" \
+	"vpsubw     " d ", " s ", " s "      \n\t" \
+	"vpmullw    %%ymm4, " s ", " s "     \n\t" \
+	"vpsllw     $8, " d ", %%ymm4        \n\t" \
+	"vpsubw     " d ", %%ymm4, %%ymm4    \n\t" \
+	"vpaddw     %%ymm4, " s ", " s "     \n\t" \
+	"vpaddw     %[c0080], " s ", " s "   \n\t" \
+	"vpmulhuw   %[c0101], " s ", " s "   \n\t"
+
+	if (chunks)
+		asm volatile (
+			"vpxor      %%ymm7, %%ymm7, %%ymm7      \n\t"
+			"0:                                     \n\t"
+			"vmovdqu    (%0), %%ymm0                \n\t"
+			"vmovdqu    (%1), %%ymm1                \n\t"
+
+			"vpunpcklbw %%ymm7, %%ymm0, %%ymm2      \n\t"
+			"vpunpcklbw %%ymm7, %%ymm1, %%ymm3      \n\t"
+			BLEND_WORDS("%%ymm2", "%%ymm3")
+
+			"vpunpckhbw %%ymm7, %%ymm0, %%ymm5      \n\t"
+			"vpunpckhbw %%ymm7, %%ymm1, %%ymm6      \n\t"
+			BLEND_WORDS("%%ymm5", "%%ymm6")
+
+			/* keep alpha channel of destination */
+			"vpackuswb  %%ymm5, %%ymm2, %%ymm2      \n\t"
+			"vpand      %[rgb], %%ymm2, %%ymm2      \n\t"
+			"vpand      %[a], %%ymm1, %%ymm1        \n\t"
+			"vpor       %%ymm1, %%ymm2, %%ymm2      \n\t"
+			"vmovdqu    %%ymm2, (%1)                \n\t"
+
+			"add        $32, %0                     \n\t"
+			"add        $32, %1                     \n\t"
+			"dec        %2                          \n\t"
+			"jnz        0b                          \n\t"
+			"vzeroupper                             \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			: [c0080] "m" (c_0080), [c0101] "m" (c_0101),
+			  [rgb] "m" (c_rgb), [a] "m" (c_a)
+			: "memory", "xmm0", "xmm1", "xmm2", "xmm3",
+			  "xmm4", "xmm5", "xmm6", "xmm7");
+
+#undef BLEND_WORDS
+
+	for (int i = 0; i < n % 8; i++)
+		dst[i] = blend(dst[i], src[i]);
+}
+
+
+Kernels const Blit::avx2_kernels = {
+	"AVX2", copy, rgb565_to_rgba8888, rgba8888_to_rgb565, blend_rgba8888 };
@@ -0,0 +1,91 @@
+/*
+ * \brief  Selection of blitting kernels for x86
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <kernels.h>
+
+using namespace Blit;
+
+
+struct Cpuid
+{
+	unsigned eax, ebx, ecx, edx;
+
+	Cpuid(unsigned leaf, unsigned subleaf = 0)
+	{
+#ifdef __x86_64__
+		asm volatile ("cpuid"
+		              : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+		              : "a" (leaf), "c" (subleaf));
+#else
+		/* preserve 'ebx', which holds the GOT pointer in PIC code */
+		asm volatile ("xchg %%ebx, %1 \n\t"
+		              "cpuid          \n\t"
+		              "xchg %%ebx, %1 \n\t"
+		              : "=a" (eax), "=&r" (ebx), "=c" (ecx), "=d" (edx)
+		              : "a" (leaf), "c" (subleaf));
+#endif
+	}
+};
+
+
+static bool sse2_supported()
+{
+	enum { EDX_SSE2 = 1 << 26 };
+
+	return Cpuid(1).edx & EDX_SSE2;
+}
+
+
+static bool avx2_supported()
+{
+	enum {
+		ECX_OSXSAVE = 1 << 27,
+		ECX_AVX     = 1 << 28,
+		EBX_AVX2    = 1 << 5,
+		XCR0_SSE    = 1 << 1,
+		XCR0_AVX    = 1 << 2,
+	};
+
+	if (Cpuid(0).eax < 7)
+		return false;
+
+	Cpuid const features(1);
+	if (!(features.ecx & ECX_OSXSAVE) || !(features.ecx & ECX_AVX))
+		return false;
+
+	/* the kernel must have enabled saving the AVX registers */
+	unsigned xcr0_lo, xcr0_hi;
+	asm volatile (".byte 0x0f, 0x01, 0xd0 /* xgetbv */"
+	              : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+
+	if ((xcr0_lo & (XCR0_SSE | XCR0_AVX)) != (XCR0_SSE | XCR0_AVX))
+		return false;
+
+	return Cpuid(7).ebx & EBX_AVX2;
+}
+
+
+Kernels const *Blit::kernels(Blit_kernels which)
+{
+	switch (which) {
+	case BLIT_KERNELS_AUTO:
+		if (avx2_supported()) return &avx2_kernels;
+		if (sse2_supported()) return &sse2_kernels;
+		return &generic_kernels;
+
+	case BLIT_KERNELS_GENERIC: return &generic_kernels;
+	case BLIT_KERNELS_SSE2:    return sse2_supported() ? &sse2_kernels : 0;
+	case BLIT_KERNELS_AVX2:    return avx2_supported() ? &avx2_kernels : 0;
+	default:                   return 0;
+	}
+}
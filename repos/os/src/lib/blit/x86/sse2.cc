@@ -0,0 +1,273 @@
+/*
+ * \brief  Blitting kernels using SSE2
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The kernels are written in inline assembly and work on x86_32 and x86_64.
+ * They must only be called if the CPU supports SSE2.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <util/string.h>
+#include <kernels.h>
+
+using namespace Blit;
+
+
+/*
+ * Constants used as memory operands, which must be 16-byte aligned
+ */
+#define SPLAT8(v) { v, v, v, v, v, v, v, v }
+#define SPLAT4(v) { v, v, v, v }
+
+static uint16_t const c_001f[8] __attribute__((aligned(16))) = SPLAT8(0x001f);
+static uint16_t const c_003f[8] __attribute__((aligned(16))) = SPLAT8(0x003f);
+static uint16_t const c_ff00[8] __attribute__((aligned(16))) = SPLAT8(0xff00);
+static uint16_t const c_0080[8] __attribute__((aligned(16))) = SPLAT8(0x0080);
+static uint16_t const c_0101[8] __attribute__((aligned(16))) = SPLAT8(0x0101);
+static uint32_t const c_r565[4] __attribute__((aligned(16))) = SPLAT4(0xf800);
+static uint32_t const c_g565[4] __attribute__((aligned(16))) = SPLAT4(0x07e0);
+static uint32_t const c_b565[4] __attribute__((aligned(16))) = SPLAT4(0x001f);
+static uint32_t const c_rgb[4]  __attribute__((aligned(16))) = SPLAT4(0x00ffffff);
+static uint32_t const c_a[4]    __attribute__((aligned(16))) = SPLAT4(0xff000000);
+
+
+/**
+ * Copy 64-byte chunks to 16-byte aligned destination
+ *
+ * \param store  instruction used for storing a register
+ */
+#define COPY_64BYTE_CHUNKS(store)          \
+	"0:                             \n\t" \
+	"prefetchnta 256(%0)            \n\t" \
+	"movdqu     (%0), %%xmm0        \n\t" \
+	"movdqu   16(%0), %%xmm1        \n\t" \
+	"movdqu   32(%0), %%xmm2        \n\t" \
+	"movdqu   48(%0), %%xmm3        \n\t" \
+	store "   %%xmm0,   (%1)        \n\t" \
+	store "   %%xmm1, 16(%1)        \n\t" \
+	store "   %%xmm2, 32(%1)        \n\t" \
+	store "   %%xmm3, 48(%1)        \n\t" \
+	"add      $64, %0               \n\t" \
+	"add      $64, %1               \n\t" \
+	"dec      %2                    \n\t" \
+	"jnz      0b                    \n\t"
+
+
+static inline void copy_line(char const *src, char *dst, unsigned long n,
+                             bool stream)
+{
+	/* copy head until the destination is aligned */
+	unsigned long const head = (-(unsigned long)dst & 15) < n
+	                         ?  -(unsigned long)dst & 15 : n;
+	Genode::memcpy(dst, src, head);
+	src += head; dst += head; n -= head;
+
+	unsigned long chunks = n / 64;
+	n %= 64;
+
+	if (chunks && stream)
+		asm volatile (COPY_64BYTE_CHUNKS("movntdq")
+		              : "+r" (src), "+r" (dst), "+r" (chunks)
+		              :
+		              : "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+	else if (chunks)
+		asm volatile (COPY_64BYTE_CHUNKS("movdqa")
+		              : "+r" (src), "+r" (dst), "+r" (chunks)
+		              :
+		              : "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+
+	Genode::memcpy(dst, src, n);
+}
+
+
+static void copy(char const *src, unsigned src_w,
+                 char *dst, unsigned dst_w, int w, int h)
+{
+	bool const stream = (unsigned long)w*h >= STREAM_THRESHOLD;
+
+	for (; h-- > 0; src += src_w, dst += dst_w)
+		copy_line(src, dst, w, stream);
+
+	/* order the non-temporal stores before any subsequent store */
+	if (stream)
+		asm volatile ("sfence" : : : "memory");
+}
+
+
+static void rgb565_to_rgba8888(uint32_t *dst, uint16_t const *src, int n)
+{
+	unsigned long chunks = n / 8;
+
+	if (chunks)
+		asm volatile (
+			"0:                             \n\t"
+			"movdqu    (%0), %%xmm0         \n\t"
+
+			/* red and alpha words */
+			"movdqa    %%xmm0, %%xmm1       \n\t"
+			"psrlw     $11, %%xmm1          \n\t"
+			"movdqa    %%xmm1, %%xmm2       \n\t"
+			"psllw     $3, %%xmm1           \n\t"
+			"psrlw     $2, %%xmm2           \n\t"
+			"por       %%xmm2, %%xmm1       \n\t"
+			"por       %[cff00], %%xmm1     \n\t"
+
+			/* green byte, shifted to the upper half of the word */
+			"movdqa    %%xmm0, %%xmm2       \n\t"
+			"psrlw     $5, %%xmm2           \n\t"
+			"pand      %[c003f], %%xmm2     \n\t"
+			"movdqa    %%xmm2, %%xmm3       \n\t"
+			"psllw     $2, %%xmm2           \n\t"
+			"psrlw     $4, %%xmm3           \n\t"
+			"por       %%xmm3, %%xmm2       \n\t"
+			"psllw     $8, %%xmm2           \n\t"
+
+			/* blue byte, merged with green */
+			"pand      %[c001f], %%xmm0     \n\t"
+			"movdqa    %%xmm0, %%xmm3       \n\t"
+			"psllw     $3, %%xmm0           \n\t"
+			"psrlw     $2, %%xmm3           \n\t"
+			"por       %%xmm3, %%xmm0       \n\t"
+			"por       %%xmm2, %%xmm0       \n\t"
+
+			/* interleave green/blue and alpha/red words */
+			"movdqa    %%xmm0, %%xmm2       \n\t"
+			"punpcklwd %%xmm1, %%xmm0       \n\t"
+			"punpckhwd %%xmm1, %%xmm2       \n\t"
+			"movdqu    %%xmm0,   (%1)       \n\t"
+			"movdqu    %%xmm2, 16(%1)       \n\t"
+
+			"add       $16, %0              \n\t"
+			"add       $32, %1              \n\t"
+			"dec       %2                   \n\t"
+			"jnz       0b                   \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			: [cff00] "m" (c_ff00), [c003f] "m" (c_003f), [c001f] "m" (c_001f)
+			: "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+
+	for (int i = 0; i < n % 8; i++)
+		dst[i] = rgba8888(src[i]);
+}
+
+
+static void rgba8888_to_rgb565(uint16_t *dst, uint32_t const *src, int n)
+{
+	unsigned long chunks = n / 8;
+
+	/*
+	 * The 565 values are computed in dwords, sign-extended, and packed
+	 * into words with signed saturation, which keeps them unchanged.
+	 */
+#define RGB565_DWORDS(x)                   \
+	"movdqa    " x ", %%xmm2        \n\t" \
+	"psrld     $8, %%xmm2           \n\t" \
+	"pand      %[r], %%xmm2         \n\t" \
+	"movdqa    " x ", %%xmm3        \n\t" \
+	"psrld     $5, %%xmm3           \n\t" \
+	"pand      %[g], %%xmm3         \n\t" \
+	"psrld     $3, " x "            \n\t" \
+	"pand      %[b], " x "          \n\t" \
+	"por       %%xmm2, " x "        \n\t" \
+	"por       %%xmm3, " x "        \n\t" \
+	"pslld     $16, " x "           \n\t" \
+	"psrad     $16, " x "           \n\t"
+
+	if (chunks)
+		asm volatile (
+			"0:                             \n\t"
+			"movdqu    (%0), %%xmm0         \n\t"
+			"movdqu    16(%0), %%xmm1       \n\t"
+			RGB565_DWORDS("%%xmm0")
+			RGB565_DWORDS("%%xmm1")
+			"packssdw  %%xmm1, %%xmm0       \n\t"
+			"movdqu    %%xmm0, (%1)         \n\t"
+			"add       $32, %0              \n\t"
+			"add       $16, %1              \n\t"
+			"dec       %2                   \n\t"
+			"jnz       0b                   \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			: [r] "m" (c_r565), [g] "m" (c_g565), [b] "m" (c_b565)
+			: "memory", "xmm0", "xmm1", "xmm2", "xmm3");
+
+#undef RGB565_DWORDS
+
+	for (int i = 0; i < n % 8; i++)
+		dst[i] = rgb565(src[i]);
+}
+
+
+static void blend_rgba8888(uint32_t *dst, uint32_t const *src, int n)
+{
+	unsigned long chunks = n / 4;
+
+	/*
+	 * Blend two pixels unpacked to words, 's' holds the source words and
+	 * becomes the result, 'd' holds the destination words. The blended
+	 * value is computed as '(s - d)*a + d*255 + 128', which is exact in
+	 * 16-bit arithmetics. The multiplication by 0x0101 and taking the
+	 * upper word equals '(t + (t >> 8)) >> 8'.
+	 */
+#define BLEND_WORDS(s, d)                  \
+	"pshuflw   $0xff, " s ", %%xmm4 \n\t" \
+	"pshufhw   $0xff, %%xmm4, %%xmm4\n\t" \
+	"psubw     " d ", " s "         \n\t" \
+	"pmullw    %%xmm4, " s "        \n\t" \
+	"movdqa    " d ", %%xmm4        \n\t" \
+	"psllw     $8, %%xmm4           \n\t" \
+	"psubw     " d ", %%xmm4        \n\t" \
+	"paddw     %%xmm4, " s "        \n\t" \
+	"paddw     %[c0080], " s "      \n\t" \
+	"pmulhuw   %[c0101], " s "      \n\t"
+
+	if (chunks)
+		asm volatile (
+			"pxor      %%xmm7, %%xmm7       \n\t"
+			"0:                             \n\t"
+			"movdqu    (%0), %%xmm0         \n\t"
+			"movdqu    (%1), %%xmm1         \n\t"
+
+			"movdqa    %%xmm0, %%xmm2       \n\t"
+			"punpcklbw %%xmm7, %%xmm2       \n\t"
+			"movdqa    %%xmm1, %%xmm3       \n\t"
+			"punpcklbw %%xmm7, %%xmm3       \n\t"
+			BLEND_WORDS("%%xmm2", "%%xmm3")
+
+			"movdqa    %%xmm0, %%xmm5       \n\t"
+			"punpckhbw %%xmm7, %%xmm5       \n\t"
+			"movdqa    %%xmm1, %%xmm6       \n\t"
+			"punpckhbw %%xmm7, %%xmm6       \n\t"
+			BLEND_WORDS("%%xmm5", "%%xmm6")
+
+			/* keep alpha channel of destination */
+			"packuswb  %%xmm5, %%xmm2       \n\t"
+			"pand      %[rgb], %%xmm2       \n\t"
+			"pand      %[a], %%xmm1         \n\t"
+			"por       %%xmm1, %%xmm2       \n\t"
+			"movdqu    %%xmm2, (%1)         \n\t"
+
+			"add       $16, %0              \n\t"
+			"add       $16, %1              \n\t"
+			"dec       %2                   \n\t"
+			"jnz       0b                   \n\t"
+			: "+r" (src), "+r" (dst), "+r" (chunks)
+			: [c0080] "m" (c_0080), [c0101] "m" (c_0101),
+			  [rgb] "m" (c_rgb), [a] "m" (c_a)
+			: "memory", "xmm0", "xmm1", "xmm2", "xmm3",
+			  "xmm4", "xmm5", "xmm6", "xmm7");
+
+#undef BLEND_WORDS
+
+	for (int i = 0; i < n % 4; i++)
+		dst[i] = blend(dst[i], src[i]);
+}
+
+
+Kernels const Blit::sse2_kernels = {
+	"SSE2", copy, rgb565_to_rgba8888, rgba8888_to_rgb565, blend_rgba8888 };
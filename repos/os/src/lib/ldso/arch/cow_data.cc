@@ -0,0 +1,16 @@
+/*
+ * \brief  Support for copy-on-write data segments
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <ldso/arch.h>
+
+bool Genode::cow_data_arch() { return true; }
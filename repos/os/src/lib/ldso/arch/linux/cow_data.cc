@@ -0,0 +1,19 @@
+/*
+ * \brief  Support for copy-on-write data segments (Linux specific)
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * On Linux, write faults on read-only regions are not reflected to the
+ * fault handler of an RM session. Hence, data segments are copied eagerly.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <ldso/arch.h>
+
+bool Genode::cow_data_arch() { return false; }
@@ -0,0 +1,461 @@
+/*
+ * \brief  Copy-on-write data segment of a shared object
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _DATA_SEGMENT_H_
+#define _DATA_SEGMENT_H_
+
+#include <base/env.h>
+#include <base/lock.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <dataspace/client.h>
+#include <rm_session/connection.h>
+#include <rom_session/rom_session.h>
+#include <util/string.h>
+#include <machine/elf.h>
+#include <sys/param.h>
+
+namespace Genode {
+
+	class Data_segment;
+	class Data_fault_handler;
+
+	inline Data_fault_handler &data_fault_handler();
+}
+
+
+/**
+ * Data segment populated from the ROM dataspace of the object
+ *
+ * The segment is a managed dataspace. The pages of initialized data that
+ * are written at load time are copied right away into a single RAM
+ * dataspace. These are the pages hit by relocations, the page that receives
+ * the parent capability, and the page that holds the end of the initialized
+ * data, which must not expose the bytes of the file that follow the data.
+ *
+ * Each remaining page is attached read-only from the ROM dataspace as a
+ * region of its own. On the first write fault, the page is copied into a
+ * spare page of a RAM dataspace and replaces its region. No other page gets
+ * unmapped. The pages following the initialized data (bss) are backed by a
+ * RAM dataspace, which is zeroed by core.
+ */
+class Genode::Data_segment : public Signal_context
+{
+	private:
+
+		enum {
+			/* pages allocated at once for copying pages on write faults */
+			SPARE_PAGES = 8,
+		};
+
+		struct Page
+		{
+			bool copied;        /* page is backed by a store */
+			bool region_start;  /* page starts an attached region */
+		};
+
+		/**
+		 * RAM dataspace that holds copied pages
+		 */
+		struct Store
+		{
+			Ram_dataspace_capability ds;
+			char                    *local;  /* local mapping of 'ds' */
+			unsigned                 num_pages;
+			unsigned                 used;
+			Store                   *next;
+		};
+
+		Lock                     _lock;
+		Rom_dataspace_capability _rom;
+		char const              *_rom_local;  /* local mapping of ROM */
+		size_t             const _rom_size;
+		off_t              const _offset;     /* offset of segment within ROM */
+		size_t             const _file_size;  /* size of initialized data */
+		unsigned           const _num_pages;  /* pages of initialized data */
+		Page                    *_pages;
+		Store                   *_stores;
+		Ram_dataspace_capability _bss;
+		Rm_connection            _view;
+
+		size_t _page_data(unsigned i) const
+		{
+			return min((size_t)PAGE_SIZE, _file_size - i*PAGE_SIZE);
+		}
+
+		void _attach(Dataspace_capability ds, size_t size, off_t offset,
+		             addr_t at, bool writeable)
+		{
+			for (;;) {
+				try {
+					_view.attach(ds, size, offset, true, at, false, writeable);
+					return;
+				} catch (Rm_session::Out_of_metadata) {
+					env()->parent()->upgrade(_view.cap(), "ram_quota=8K");
+				}
+			}
+		}
+
+		/**
+		 * Mark the pages overlapping with a range of link addresses as copied
+		 */
+		void _mark(addr_t link_base, addr_t addr, size_t size)
+		{
+			for (addr_t a = trunc_page(addr); a < addr + size; a += PAGE_SIZE) {
+				if (a < link_base || a - link_base >= _file_size)
+					continue;
+				_pages[(a - link_base) / PAGE_SIZE].copied = true;
+			}
+		}
+
+		/**
+		 * Return ROM content at a link address, or 0 if not in the file
+		 */
+		char const *_at_link_addr(addr_t addr, size_t size) const
+		{
+			Elf_Ehdr const *ehdr = (Elf_Ehdr const *)_rom_local;
+			Elf_Phdr const *phdr = (Elf_Phdr const *)(_rom_local + ehdr->e_phoff);
+
+			for (unsigned i = 0; i < ehdr->e_phnum; i++) {
+				Elf_Phdr const &p = phdr[i];
+				if (p.p_type != PT_LOAD || addr < p.p_vaddr
+				 || addr + size > p.p_vaddr + p.p_filesz)
+					continue;
+
+				off_t const offset = p.p_offset + (addr - p.p_vaddr);
+				if (offset + size > _rom_size)
+					return 0;
+
+				return _rom_local + offset;
+			}
+			return 0;
+		}
+
+		/**
+		 * Mark the targets of the relocations of a table as copied
+		 */
+		template <typename REL>
+		void _mark_relocations(addr_t link_base, addr_t table, size_t size)
+		{
+			REL const *rel = (REL const *)_at_link_addr(table, size);
+			if (!rel)
+				return;
+
+			for (unsigned i = 0; i < size / sizeof(REL); i++)
+				_mark(link_base, rel[i].r_offset, sizeof(Elf_Addr));
+		}
+
+		/**
+		 * Determine the pages written by the dynamic linker at load time
+		 *
+		 * \param link_base  link address of the segment
+		 */
+		void _mark_written_at_load_time(addr_t link_base)
+		{
+			Elf_Ehdr const *ehdr = (Elf_Ehdr const *)_rom_local;
+			if (_rom_size < sizeof(Elf_Ehdr) || !IS_ELF(*ehdr)
+			 || ehdr->e_phoff + ehdr->e_phnum*sizeof(Elf_Phdr) > _rom_size)
+				return;
+
+			Elf_Phdr const *phdr = (Elf_Phdr const *)(_rom_local + ehdr->e_phoff);
+
+			Elf_Phdr const *dynamic = 0;
+			for (unsigned i = 0; i < ehdr->e_phnum; i++)
+				if (phdr[i].p_type == PT_DYNAMIC)
+					dynamic = &phdr[i];
+
+			if (!dynamic)
+				return;
+
+			/* the dynamic linker updates the dynamic section, e.g., DT_DEBUG */
+			_mark(link_base, dynamic->p_vaddr, dynamic->p_memsz);
+
+			Elf_Dyn const *dyn = (Elf_Dyn const *)_at_link_addr(dynamic->p_vaddr,
+			                                                   dynamic->p_filesz);
+			if (!dyn)
+				return;
+
+			addr_t rel = 0, rela = 0, jmprel = 0;
+			size_t relsz = 0, relasz = 0, pltrelsz = 0;
+			long   pltrel = DT_REL;
+
+			for (; (char const *)(dyn + 1) <= (char const *)dyn + dynamic->p_filesz
+			       && dyn->d_tag != DT_NULL; dyn++) {
+
+				switch (dyn->d_tag) {
+				case DT_REL:      rel      = dyn->d_un.d_ptr; break;
+				case DT_RELSZ:    relsz    = dyn->d_un.d_val; break;
+				case DT_RELA:     rela     = dyn->d_un.d_ptr; break;
+				case DT_RELASZ:   relasz   = dyn->d_un.d_val; break;
+				case DT_JMPREL:   jmprel   = dyn->d_un.d_ptr; break;
+				case DT_PLTRELSZ: pltrelsz = dyn->d_un.d_val; break;
+				case DT_PLTREL:   pltrel   = dyn->d_un.d_val; break;
+
+				/* the first entries of the GOT are set up by the linker */
+				case DT_PLTGOT:
+					_mark(link_base, dyn->d_un.d_ptr, 3*sizeof(Elf_Addr));
+					break;
+				}
+			}
+
+			if (rel)  _mark_relocations<Elf_Rel> (link_base, rel,  relsz);
+			if (rela) _mark_relocations<Elf_Rela>(link_base, rela, relasz);
+
+			if (jmprel && pltrel == DT_RELA)
+				_mark_relocations<Elf_Rela>(link_base, jmprel, pltrelsz);
+			else if (jmprel)
+				_mark_relocations<Elf_Rel>(link_base, jmprel, pltrelsz);
+		}
+
+		Store *_alloc_store(unsigned num_pages)
+		{
+			Store *store = 0;
+			if (!env()->heap()->alloc(sizeof(Store), &store))
+				throw Allocator::Out_of_memory();
+
+			store->ds        = env()->ram_session()->alloc(num_pages*PAGE_SIZE);
+			store->local     = env()->rm_session()->attach(store->ds);
+			store->num_pages = num_pages;
+			store->used      = 0;
+			store->next      = _stores;
+
+			_stores = store;
+			return store;
+		}
+
+		/**
+		 * Copy initialized data of page into the next free page of a store
+		 *
+		 * \return offset of the copy within the dataspace of '_stores'
+		 */
+		off_t _copy(unsigned i)
+		{
+			if (!_stores || _stores->used == _stores->num_pages)
+				_alloc_store(SPARE_PAGES);
+
+			Store &store = *_stores;
+			off_t const offset = store.used++ * PAGE_SIZE;
+
+			memcpy(store.local + offset, _rom_local + _offset + i*PAGE_SIZE,
+			       _page_data(i));
+
+			_pages[i].copied = true;
+			return offset;
+		}
+
+		/**
+		 * Copy page on a write fault and replace its read-only region
+		 */
+		void _copy_on_write(unsigned i)
+		{
+			off_t const offset = _copy(i);
+
+			_view.detach(i*PAGE_SIZE);
+			_attach(_stores->ds, PAGE_SIZE, offset, i*PAGE_SIZE, true);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param rom        ROM dataspace of the object
+		 * \param offset     page-aligned offset of the segment within 'rom'
+		 * \param file_size  size of the initialized data
+		 * \param size       page-aligned size of the segment
+		 * \param link_base  page-aligned link address of the segment
+		 */
+		inline Data_segment(Rom_dataspace_capability rom, off_t offset,
+		                    size_t file_size, size_t size, addr_t link_base);
+
+		inline ~Data_segment();
+
+		/**
+		 * Return capability of the managed dataspace
+		 */
+		Dataspace_capability dataspace() { return _view.dataspace(); }
+
+		/**
+		 * Resolve the faults of the segment
+		 *
+		 * Called by the fault-handler thread.
+		 */
+		void handle_faults()
+		{
+			Lock::Guard guard(_lock);
+
+			Rm_session::State last;
+
+			for (;;) {
+				Rm_session::State const state = _view.state();
+
+				if (state.type == Rm_session::READY)
+					return;
+
+				unsigned const i = state.addr / PAGE_SIZE;
+
+				if (i >= _num_pages
+				 || (state.type == last.type && state.addr == last.addr)) {
+					PERR("unresolvable %s fault at 0x%lx of data segment",
+					     state.type == Rm_session::WRITE_FAULT ? "write" : "read",
+					     state.addr);
+					return;
+				}
+
+				if (state.type == Rm_session::WRITE_FAULT && !_pages[i].copied)
+					_copy_on_write(i);
+
+				last = state;
+			}
+		}
+};
+
+
+/**
+ * Thread that resolves the faults of all data segments
+ */
+class Genode::Data_fault_handler : Thread<4096*sizeof(long)>
+{
+	private:
+
+		Signal_receiver _sig_rec;
+
+		void entry()
+		{
+			for (;;) {
+				Signal signal = _sig_rec.wait_for_signal();
+				static_cast<Data_segment *>(signal.context())->handle_faults();
+			}
+		}
+
+	public:
+
+		Data_fault_handler() : Thread("ldso_data_fault") { start(); }
+
+		Signal_context_capability manage(Data_segment *segment) {
+			return _sig_rec.manage(segment); }
+
+		void dissolve(Data_segment *segment) { _sig_rec.dissolve(segment); }
+};
+
+
+Genode::Data_fault_handler &Genode::data_fault_handler()
+{
+	static Data_fault_handler inst;
+	return inst;
+}
+
+
+Genode::Data_segment::Data_segment(Rom_dataspace_capability rom, off_t offset,
+                                   size_t file_size, size_t size,
+                                   addr_t link_base)
+:
+	_rom(rom), _rom_local(env()->rm_session()->attach(rom)),
+	_rom_size(Dataspace_client(rom).size()),
+	_offset(offset), _file_size(file_size),
+	_num_pages((file_size + PAGE_SIZE - 1) / PAGE_SIZE),
+	_pages(0), _stores(0), _view(0, size)
+{
+	if (_num_pages && !env()->heap()->alloc(_num_pages*sizeof(Page), &_pages))
+		throw Allocator::Out_of_memory();
+
+	for (unsigned i = 0; i < _num_pages; i++) {
+		Page page = { false, false };
+		_pages[i] = page;
+	}
+
+	_mark_written_at_load_time(link_base);
+
+	if (_num_pages) {
+
+		/* the parent capability is written right after loading */
+		_pages[0].copied = true;
+
+		/* keep the file content that follows the initialized data private */
+		if (_page_data(_num_pages - 1) < PAGE_SIZE)
+			_pages[_num_pages - 1].copied = true;
+	}
+
+	unsigned num_copied = 0;
+	for (unsigned i = 0; i < _num_pages; i++)
+		num_copied += _pages[i].copied;
+
+	/* leave room for the first pages copied on write faults */
+	unsigned const spare = min((unsigned)SPARE_PAGES, _num_pages - num_copied);
+
+	if (num_copied + spare)
+		_alloc_store(num_copied + spare);
+
+	/*
+	 * Copy the pages in ascending order into the store, so that runs of
+	 * copied pages are contiguous within the store and can be attached as
+	 * one region.
+	 */
+	for (unsigned i = 0; i < _num_pages; ) {
+
+		_pages[i].region_start = true;
+
+		if (!_pages[i].copied) {
+			_attach(_rom, PAGE_SIZE, _offset + i*PAGE_SIZE, i*PAGE_SIZE, false);
+			i++;
+			continue;
+		}
+
+		unsigned const first = i;
+		off_t    const start = _copy(i);
+		for (i++; i < _num_pages && _pages[i].copied; i++)
+			_copy(i);
+
+		_attach(_stores->ds, (i - first)*PAGE_SIZE, start, first*PAGE_SIZE, true);
+	}
+
+	size_t const bss_size = size - _num_pages*PAGE_SIZE;
+	if (bss_size) {
+		_bss = env()->ram_session()->alloc(bss_size);
+		_attach(_bss, bss_size, 0, _num_pages*PAGE_SIZE, true);
+	}
+
+	_view.fault_handler(data_fault_handler().manage(this));
+}
+
+
+Genode::Data_segment::~Data_segment()
+{
+	/* wait for the completion of a fault being handled */
+	data_fault_handler().dissolve(this);
+
+	Lock::Guard guard(_lock);
+
+	for (unsigned i = 0; i < _num_pages; i++)
+		if (_pages[i].region_start)
+			_view.detach(i*PAGE_SIZE);
+
+	if (_bss.valid()) {
+		_view.detach(_num_pages*PAGE_SIZE);
+		env()->ram_session()->free(_bss);
+	}
+
+	while (Store *store = _stores) {
+		_stores = store->next;
+		env()->rm_session()->detach(store->local);
+		env()->ram_session()->free(store->ds);
+		env()->heap()->free(store, sizeof(Store));
+	}
+
+	if (_pages)
+		env()->heap()->free(_pages, _num_pages*sizeof(Page));
+
+	env()->rm_session()->detach(_rom_local);
+}
+
+#endif /* _DATA_SEGMENT_H_ */
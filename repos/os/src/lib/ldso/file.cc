@@ -21,6 +21,7 @@
 #include <util/construct_at.h>
 
 #include "file.h"
+#include "data_segment.h"
 
 extern int debug;
 
@@ -115,13 +116,14 @@ namespace Genode {
 			addr_t                   _daddr;  /* data start */
 			Rom_dataspace_capability _ds_rom; /* image ds */
 			Ram_dataspace_capability _ds_ram; /* data ds */
+			Data_segment            *_data;   /* copy-on-write data */
 			int                      _fd;     /* file handle */
 			Session_capability       _rom_cap;
 
 		public:
 
 			Fd_handle(int fd, Rom_dataspace_capability ds_rom, Session_capability rom_cap)
-			: _vaddr(~0UL),  _ds_rom(ds_rom), _fd(fd), _rom_cap(rom_cap)
+			: _vaddr(~0UL),  _ds_rom(ds_rom), _data(0), _fd(fd), _rom_cap(rom_cap)
 			{
 				_phdr = (addr_t)env()->rm_session()->attach(_ds_rom, PAGE_SIZE);
 			}
@@ -131,8 +133,26 @@ namespace Genode {
 			Rom_dataspace_capability dataspace()  { return _ds_rom; }
 			addr_t                   phdr()       { return _phdr; }
 
-			void setup_data(addr_t vaddr, addr_t vlimit, addr_t flimit, off_t offset)
+			/**
+			 * \param link_vaddr  link address of the data segment
+			 */
+			void setup_data(addr_t vaddr, addr_t vlimit, addr_t flimit, off_t offset,
+			                addr_t link_vaddr)
 			{
+				_daddr = vaddr;
+
+				/* populate data segment lazily from the ROM dataspace */
+				if (cow_data_arch()) {
+					_data = new (env()->heap())
+					        Data_segment(_ds_rom, offset, flimit - vaddr,
+					                     vlimit - vaddr, link_vaddr);
+					Rm_area::r()->attach_at(_data->dataspace(), vaddr);
+
+					/* set parent cap (arch.lib.a) */
+					set_parent_cap_arch((void *)vaddr);
+					return;
+				}
+
 				/* allocate data segment */
 				_ds_ram = env()->ram_session()->alloc(vlimit - vaddr);
 				Rm_area::r()->attach_at(_ds_ram, vaddr);
@@ -146,8 +166,6 @@ namespace Genode {
 
 				/* set parent cap (arch.lib.a) */
 				set_parent_cap_arch((void *)vaddr);
-
-				_daddr = vaddr;
 			}
 
 			void setup_text(addr_t vaddr, size_t size, off_t offset)
@@ -210,7 +228,10 @@ namespace Genode {
 					Rm_area::r()->detach(_vaddr);
 					Rm_area::r()->detach(_daddr);
 					Rm_area::r()->free_region(_vaddr);
-					env()->ram_session()->free(_ds_ram);
+					if (_data)
+						destroy(env()->heap(), _data);
+					else
+						env()->ram_session()->free(_ds_ram);
 					env()->rm_session()->detach(_phdr);
 				}
 
@@ -408,7 +429,8 @@ extern "C" void *genode_map(int fd, Elf_Phdr **segs)
 	base_offset        = trunc_page(segs[1]->p_offset);
 	
 	/* copy data segment */
-	h->setup_data(base_vaddr, base_vlimit, base_flimit, base_offset);
+	h->setup_data(base_vaddr, base_vlimit, base_flimit, base_offset,
+	              trunc_page(segs[1]->p_vaddr));
 
 	return (void *)h->vaddr();
 }
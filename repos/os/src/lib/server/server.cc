@@ -33,6 +33,20 @@ static Rpc_entrypoint &global_rpc_ep()
 }
 
 
+static Rpc_entrypoint_group &global_rpc_ep_group()
+{
+	enum { MAX = Rpc_entrypoint_group::MAX_ENTRYPOINTS };
+
+	static unsigned const cpus = env()->cpu_session()->affinity_space().total();
+
+	static Rpc_entrypoint_group inst(&global_cap_session(),
+	                                 stack_size(),
+	                                 name(),
+	                                 max(1U, min(cpus, (unsigned)MAX)));
+	return inst;
+}
+
+
 static Entrypoint &global_ep()
 {
 	static Server::Entrypoint inst;
@@ -92,6 +106,10 @@ void Server::Entrypoint::dissolve(Signal_rpc_dispatcher_base &dispatcher)
 Server::Entrypoint::Entrypoint() : _rpc_ep(global_rpc_ep()) { }
 
 
+Rpc_entrypoint_group &Server::Entrypoint::rpc_ep_group() {
+	return global_rpc_ep_group(); }
+
+
 void Server::wait_and_dispatch_one_signal() {
 	::wait_and_dispatch_one_signal(true); }
 
@@ -14,16 +14,48 @@
 #include <os/timed_semaphore.h>
 
 
+void Genode::Timeout_thread::_program(Alarm::Time deadline)
+{
+	Lock::Guard lock_guard(_program_lock);
+
+	if (_programmed && (long)(deadline - _deadline) >= 0)
+		return;
+
+	/*
+	 * An alarm becomes pending not before the current time exceeds its
+	 * deadline. So we wake up one millisecond after the deadline.
+	 */
+	Alarm::Time const now = time();
+	Alarm::Time ms = (long)(deadline - now) >= 0 ? deadline - now + 1 : 0;
+	if (ms > MAX_TIMEOUT_MS)
+		ms = MAX_TIMEOUT_MS;
+
+	_programmed = true;
+	_deadline   = deadline;
+	_timer.trigger_once(ms*1000);
+}
+
+
 void Genode::Timeout_thread::entry()
 {
 	while (true) {
-		Signal s = _receiver.wait_for_signal();
+		_receiver.wait_for_signal();
 
-		/* increase jiffies counter related to received signals */
-		_time +=  JIFFIES_STEP_MS * s.num();
+		{
+			Lock::Guard lock_guard(_program_lock);
+			_programmed = false;
+		}
 
 		/* handle timouts of this point in time */
-		Genode::Alarm_scheduler::handle(_time);
+		Genode::Alarm_scheduler::handle(time());
+
+		/*
+		 * Program the timeout for the next deadline. Deadlines scheduled
+		 * concurrently are covered by '_program' as well.
+		 */
+		Alarm::Time deadline;
+		if (next_deadline(&deadline))
+			_program(deadline);
 	}
 }
 
@@ -0,0 +1,71 @@
+/*
+ * \brief  Trace policy recording the lock statistics of heaps
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <util/string.h>
+#include <trace/policy.h>
+
+using namespace Genode;
+
+/*
+ * Each heap-statistics event is stored as binary record of three counters
+ */
+struct Record
+{
+	unsigned long acquisitions;
+	unsigned long contentions;
+	unsigned long quota_used;
+};
+
+size_t max_event_size()
+{
+	return sizeof(Record);
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return 0;
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return 0;
+}
+
+size_t signal_submit(char *dst, unsigned const)
+{
+	return 0;
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned)
+{
+	return 0;
+}
+
+size_t heap_stats(char *dst, unsigned long acquisitions,
+                  unsigned long contentions, unsigned long quota_used)
+{
+	Record const record = { acquisitions, contentions, quota_used };
+
+	memcpy(dst, (void *)&record, sizeof(record));
+	return sizeof(record);
+}
@@ -0,0 +1,5 @@
+TARGET = heap_stats_policy
+
+TARGET_POLICY = heap_stats
+
+include $(PRG_DIR)/../policy.inc
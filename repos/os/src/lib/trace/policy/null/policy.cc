@@ -37,3 +37,7 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 	return 0;
 }
 
+size_t heap_stats(char *dst, unsigned long, unsigned long, unsigned long)
+{
+	return 0;
+}
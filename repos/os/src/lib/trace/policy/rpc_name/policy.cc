@@ -51,3 +51,8 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 {
 	return 0;
 }
+
+size_t heap_stats(char *dst, unsigned long, unsigned long, unsigned long)
+{
+	return 0;
+}
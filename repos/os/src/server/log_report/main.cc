@@ -55,6 +55,13 @@ class Report::Session_component : public Genode::Rpc_object<Session>
 		{
 			using namespace Genode;
 
+			/*
+			 * The sessions are served by multiple entrypoints. Keep the
+			 * reports of different sessions from interleaving.
+			 */
+			static Lock output_lock;
+			Lock::Guard guard(output_lock);
+
 			printf("\nreport: %s\n", _label.string());
 
 			char buf[1024];
@@ -93,9 +100,15 @@ class Report::Root : public Genode::Root_component<Session_component>
 
 	public:
 
+		/*
+		 * Each session is served by an entrypoint of the group. So the
+		 * submission of a large report by one client does not delay the
+		 * other clients.
+		 */
 		Root(Entrypoint &ep, Genode::Allocator &md_alloc)
 		:
-			Genode::Root_component<Session_component>(&ep.rpc_ep(), &md_alloc)
+			Genode::Root_component<Session_component>(&ep.rpc_ep_group(),
+			                                          &md_alloc)
 		{ }
 };
 
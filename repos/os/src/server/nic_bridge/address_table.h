@@ -0,0 +1,125 @@
+/*
+ * \brief  Hash table of address nodes
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _ADDRESS_TABLE_H_
+#define _ADDRESS_TABLE_H_
+
+/* Genode */
+#include <base/lock.h>
+#include <base/lock_guard.h>
+#include <util/string.h>
+
+namespace Net { template <typename> class Address_table; }
+
+
+/**
+ * Table of address nodes, keyed by their network address
+ *
+ * \param NODE  node type providing 'addr()' and a '_hash_next' member
+ *
+ * Nodes are chained into a fixed number of buckets. Insertions and removals
+ * are serialized by a lock, whereas 'lookup' takes no lock at all. A node
+ * gets published by a single pointer store after it is fully linked. Hence,
+ * a concurrent lookup sees either the old or the new chain but never a
+ * partially linked node. A removed node must not be destructed while a
+ * lookup may still traverse it.
+ *
+ * In the NIC bridge, all lookups are performed while dispatching a signal,
+ * which happens with 'Env::dispatch_lock' held. Nodes are removed and
+ * destructed only with this lock held as well: a session drops its nodes
+ * in its destructor, which 'Root::_destroy_session' calls with the lock
+ * acquired, and it replaces its IPv4 node on DHCP replies, which are
+ * handled while dispatching. The session entrypoint merely inserts nodes
+ * when creating a session.
+ */
+template <typename NODE>
+class Net::Address_table
+{
+	public:
+
+		typedef typename NODE::Address Address;
+
+	private:
+
+		enum { NUM_BUCKETS = 256 };
+
+		NODE * volatile _buckets[NUM_BUCKETS];
+		Genode::Lock    _lock;
+
+		/**
+		 * FNV-1a hash of network address
+		 */
+		static unsigned _bucket(Address const &addr)
+		{
+			unsigned h = 2166136261U;
+			for (unsigned i = 0; i < sizeof(addr.addr); i++) {
+				h ^= addr.addr[i];
+				h *= 16777619U;
+			}
+			return h % NUM_BUCKETS;
+		}
+
+	public:
+
+		Address_table()
+		{
+			for (unsigned i = 0; i < NUM_BUCKETS; i++)
+				_buckets[i] = 0;
+		}
+
+		void insert(NODE *node)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			NODE * volatile &head = _buckets[_bucket(node->addr())];
+			node->_hash_next = head;
+
+			/* make the node's content visible before publishing it */
+			__sync_synchronize();
+			head = node;
+		}
+
+		/**
+		 * Unlink node
+		 *
+		 * The caller must keep the node alive until no lookup can be
+		 * traversing it anymore.
+		 */
+		void remove(NODE *node)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			NODE * volatile *link = &_buckets[_bucket(node->addr())];
+			for (; *link; link = &(*link)->_hash_next)
+				if (*link == node) {
+					*link = node->_hash_next;
+					__sync_synchronize();
+					return;
+				}
+		}
+
+		/**
+		 * Look up node by address
+		 *
+		 * \return  0 if no node with the address exists
+		 */
+		NODE *lookup(Address const &addr) const
+		{
+			for (NODE *n = _buckets[_bucket(addr)]; n; n = n->_hash_next)
+				if (n->addr() == addr)
+					return n;
+			return 0;
+		}
+};
+
+#endif /* _ADDRESS_TABLE_H_ */
@@ -44,9 +44,8 @@ bool Session_component::handle_arp(Ethernet_frame *eth, Genode::size_t size)
 		 if (arp->src_ip() == arp->dst_ip())
 			return false;
 
-		Ipv4_address_node *node = Env::vlan()->ip_tree()->first();
-		if (node)
-			node = node->find_by_address(arp->dst_ip());
+		Ipv4_address_node *node =
+			Env::vlan()->ip_table()->lookup(arp->dst_ip());
 		if (!node) {
 			arp->src_mac(Net::Env::nic()->mac());
 		}
@@ -55,11 +54,106 @@ bool Session_component::handle_arp(Ethernet_frame *eth, Genode::size_t size)
 }
 
 
+void Session_component::_join(Ipv4_packet::Ipv4_address group)
+{
+	if (_num_groups == MAX_GROUPS) {
+		if (verbose)
+			PWRN("too many multicast groups, join ignored");
+		return;
+	}
+
+	if (Env::vlan()->multicast()->join(Multicast::group_mac(group), this))
+		_num_groups++;
+}
+
+
+void Session_component::_leave(Ipv4_packet::Ipv4_address group)
+{
+	if (Env::vlan()->multicast()->leave(Multicast::group_mac(group), this))
+		_num_groups--;
+}
+
+
+void Session_component::_handle_igmp(Ipv4_packet *ip, Genode::size_t size)
+{
+	using Genode::uint8_t;
+
+	enum {
+		V1_REPORT = 0x12, V2_REPORT = 0x16, V2_LEAVE = 0x17, V3_REPORT = 0x22,
+
+		/* record types of IGMPv3 reports */
+		MODE_IS_INCLUDE = 1, MODE_IS_EXCLUDE = 2, CHANGE_TO_INCLUDE = 3,
+		CHANGE_TO_EXCLUDE = 4, ALLOW_NEW_SOURCES = 5,
+	};
+
+	/* IGMP messages carry the router-alert option, so honor the IHL */
+	Genode::size_t const ihl = (*(uint8_t *)ip & 0xf)*4;
+	if (ihl < sizeof(Ipv4_packet) || size < ihl + 8)
+		return;
+
+	uint8_t const *igmp = (uint8_t *)ip + ihl;
+	uint8_t const *end  = (uint8_t *)ip + size;
+
+	switch (igmp[0]) {
+	case V1_REPORT:
+	case V2_REPORT:
+		_join(Ipv4_packet::Ipv4_address((void *)(igmp + 4)));
+		return;
+
+	case V2_LEAVE:
+		_leave(Ipv4_packet::Ipv4_address((void *)(igmp + 4)));
+		return;
+
+	case V3_REPORT:
+		break;
+
+	default:
+		return;
+	}
+
+	unsigned       num_records = (igmp[6] << 8) | igmp[7];
+	uint8_t const *record      = igmp + 8;
+
+	for (; num_records && record + 8 <= end; num_records--) {
+
+		unsigned const type        = record[0];
+		unsigned const aux_len     = record[1]*4;
+		unsigned const num_sources = (record[2] << 8) | record[3];
+
+		Ipv4_packet::Ipv4_address group((void *)(record + 4));
+
+		/*
+		 * A client receives the group's traffic unless it includes an
+		 * empty set of sources.
+		 */
+		switch (type) {
+		case MODE_IS_EXCLUDE:
+		case CHANGE_TO_EXCLUDE:
+			_join(group);
+			break;
+		case MODE_IS_INCLUDE:
+		case ALLOW_NEW_SOURCES:
+		case CHANGE_TO_INCLUDE:
+			if (num_sources)
+				_join(group);
+			else if (type != ALLOW_NEW_SOURCES)
+				_leave(group);
+			break;
+		}
+
+		record += 8 + num_sources*4 + aux_len;
+	}
+}
+
+
 bool Session_component::handle_ip(Ethernet_frame *eth, Genode::size_t size)
 {
 	Ipv4_packet *ip =
 		new (eth->data()) Ipv4_packet(size - sizeof(Ethernet_frame));
 
+	if (ip->protocol() == IGMP_IP_ID)
+		_handle_igmp(ip, size - sizeof(Ethernet_frame));
+
 	if (ip->protocol() == Udp_packet::IP_ID)
 	{
 		Udp_packet *udp = new (ip->data())
@@ -80,11 +174,11 @@ bool Session_component::handle_ip(Ethernet_frame *eth, Genode::size_t size)
 void Session_component::finalize_packet(Ethernet_frame *eth,
                                                     Genode::size_t size)
 {
-	Mac_address_node *node = Env::vlan()->mac_tree()->first();
-	if (node)
-		node = node->find_by_address(eth->dst());
-	if (node)
-		node->component()->send(eth, size);
+	Mac_address_node *node = Env::vlan()->mac_table()->lookup(eth->dst());
+	if (node) {
+		if (!node->component()->send_borrowed(*this))
+			node->component()->send(eth, size);
+	}
 	else {
 		/* set our MAC as sender */
 		eth->src(Net::Env::nic()->mac());
@@ -93,10 +187,61 @@ void Session_component::finalize_packet(Ethernet_frame *eth,
 }
 
 
+void Session_component::_give_back(Packet_descriptor packet)
+{
+	int const slot = view()->slot(packet);
+
+	/*
+	 * The sender is operated by the same thread because sessions are
+	 * destroyed with the dispatch lock held.
+	 */
+	Session_component *sender = Env::vlan()->zero_copy()->give_back(slot);
+	if (sender)
+		sender->_acknowledge(Packet_descriptor(packet.offset() - view()->slot_offset(slot),
+		                                       packet.size()));
+}
+
+
+void Session_component::_release_packet(Packet_descriptor packet)
+{
+	if (!view() || view()->slot(packet) < 0) {
+		source()->release_packet(packet);
+		return;
+	}
+
+	/* ignore acknowledgements of packets never submitted */
+	if (_borrowed.remove(packet))
+		_give_back(packet);
+}
+
+
+bool Session_component::send_borrowed(Session_component &sender)
+{
+	if (!view() || sender._slot < 0 || &sender == this)
+		return false;
+
+	Packet_descriptor const tx = sender._current_packet();
+	Packet_descriptor const packet(view()->slot_offset(sender._slot) + tx.offset(),
+	                               tx.size());
+
+	if (!Env::vlan()->zero_copy()->borrow(sender._slot))
+		return false;
+
+	if (!_borrowed.insert(packet)) {
+		Env::vlan()->zero_copy()->give_back(sender._slot);
+		return false;
+	}
+
+	sender._keep_current_packet();
+	_submit(packet);
+	return true;
+}
+
+
 void Session_component::_free_ipv4_node()
 {
 	if (_ipv4_node) {
-		Env::vlan()->ip_tree()->remove(_ipv4_node);
+		Env::vlan()->ip_table()->remove(_ipv4_node);
 		destroy(this->guarded_allocator(), _ipv4_node);
 	}
 }
@@ -107,7 +252,7 @@ void Session_component::set_ipv4_address(Ipv4_packet::Ipv4_address ip_addr)
 	_free_ipv4_node();
 	_ipv4_node = new (this->guarded_allocator())
 		Ipv4_address_node(ip_addr, this);
-	Net::Env::vlan()->ip_tree()->insert(_ipv4_node);
+	Net::Env::vlan()->ip_table()->insert(_ipv4_node);
 }
 
 
@@ -117,16 +262,26 @@ Session_component::Session_component(Genode::Allocator          *allocator,
                                      Genode::size_t              rx_buf_size,
                                      Ethernet_frame::Mac_address vmac,
                                      Genode::Rpc_entrypoint     &ep,
-                                     char                       *ip_addr)
-: Guarded_range_allocator(allocator, amount),
-  Tx_rx_communication_buffers(tx_buf_size, rx_buf_size),
+                                     char                       *ip_addr,
+                                     bool                        zero_copy)
+: Guarded_range_allocator(allocator, amount, rx_buf_size),
+  Tx_rx_communication_buffers(tx_buf_size, rx_buf_size, zero_copy),
   Session_rpc_object(Tx_rx_communication_buffers::tx_ds(),
                      Tx_rx_communication_buffers::rx_ds(),
                      this->range_allocator(), ep),
   _mac_node(vmac, this),
-  _ipv4_node(0)
+  _ipv4_node(0),
+  _num_groups(0),
+  _slot(-1)
 {
-	Env::vlan()->mac_tree()->insert(&_mac_node);
+	if (Zero_copy::View *v = view()) {
+		Env::vlan()->zero_copy()->add_view(v);
+		_slot = Env::vlan()->zero_copy()->add_sender(this, tx_buf().ram_dataspace());
+		if (_slot < 0)
+			PWRN("no zero-copy slot for tx buffer, peers receive copies");
+	}
+
+	Env::vlan()->mac_table()->insert(&_mac_node);
 	Env::vlan()->mac_list()->insert(&_mac_node);
 
 	/* static ip parsing */
@@ -154,7 +309,20 @@ Session_component::Session_component(Genode::Allocator          *allocator,
 
 
 Session_component::~Session_component() {
-	Env::vlan()->mac_tree()->remove(&_mac_node);
+	Env::vlan()->mac_table()->remove(&_mac_node);
 	Env::vlan()->mac_list()->remove(&_mac_node);
+	Env::vlan()->multicast()->leave_all(this);
 	_free_ipv4_node();
+	_discard_batch();
+
+	if (view()) {
+		Env::vlan()->zero_copy()->remove_view(view());
+
+		/* the packets will never be acknowledged by the client */
+		_borrowed.for_each([&] (Packet_descriptor packet) {
+			_give_back(packet); });
+	}
+
+	if (_slot >= 0 && Env::vlan()->zero_copy()->remove_sender(_slot))
+		tx_buf().disown();
 }
@@ -26,11 +26,42 @@
 #include <os/session_policy.h>
 
 #include "address_node.h"
+#include "env.h"
 #include "mac.h"
 #include "packet_handler.h"
+#include "zero_copy.h"
 
 namespace Net {
 
+	/**
+	 * Packet allocator confined to the first 'limit' bytes of a buffer
+	 *
+	 * The receive buffer of a zero-copy client is followed by the transmit
+	 * buffers of the other clients, which must not be allocated from.
+	 */
+	class Bounded_packet_allocator : public ::Nic::Packet_allocator
+	{
+		private:
+
+			Genode::size_t const _limit;
+
+		public:
+
+			Bounded_packet_allocator(Genode::Allocator *md_alloc,
+			                         Genode::size_t     limit)
+			: ::Nic::Packet_allocator(md_alloc), _limit(limit) { }
+
+			int add_range(Genode::addr_t base, Genode::size_t size) override
+			{
+				if (base >= _limit)
+					return -1;
+
+				return ::Nic::Packet_allocator::add_range(base,
+					Genode::min(size, _limit - base));
+			}
+	};
+
+
 	/**
 	 * Helper class.
 	 *
@@ -39,15 +70,21 @@ namespace Net {
 	{
 		private:
 
-			Genode::Allocator_guard _guarded_alloc;
-			::Nic::Packet_allocator _range_alloc;
+			Genode::Allocator_guard  _guarded_alloc;
+			Bounded_packet_allocator _range_alloc;
 
 		public:
 
+			/**
+			 * Constructor
+			 *
+			 * \param limit  size of the buffer managed by the range allocator
+			 */
 			Guarded_range_allocator(Genode::Allocator *backing_store,
-			                        Genode::size_t     amount)
+			                        Genode::size_t     amount,
+			                        Genode::size_t     limit)
 			: _guarded_alloc(backing_store, amount),
-			  _range_alloc(&_guarded_alloc) {}
+			  _range_alloc(&_guarded_alloc, limit) {}
 
 			Genode::Allocator_guard *guarded_allocator() {
 				return &_guarded_alloc; }
@@ -59,15 +96,31 @@ namespace Net {
 
 	class Communication_buffer : Genode::Ram_dataspace_capability
 	{
+		private:
+
+			bool _owned;
+
 		public:
 
 			Communication_buffer(Genode::size_t size)
-			: Genode::Ram_dataspace_capability(Genode::env()->ram_session()->alloc(size))
+			: Genode::Ram_dataspace_capability(Genode::env()->ram_session()->alloc(size)),
+			  _owned(true)
 			{ }
 
-			~Communication_buffer() { Genode::env()->ram_session()->free(*this); }
+			~Communication_buffer()
+			{
+				if (_owned)
+					Genode::env()->ram_session()->free(*this);
+			}
 
 			Genode::Dataspace_capability dataspace() { return *this; }
+
+			Genode::Ram_dataspace_capability ram_dataspace() { return *this; }
+
+			/**
+			 * Leave the release of the buffer to someone else
+			 */
+			void disown() { _owned = false; }
 	};
 
 
@@ -76,15 +129,50 @@ namespace Net {
 		private:
 
 			Communication_buffer _tx_buf, _rx_buf;
+			Zero_copy::View     *_view;
+
+			Zero_copy::View *_create_view()
+			{
+				try {
+					return new (Genode::env()->heap())
+						Zero_copy::View(_rx_buf.dataspace());
+				} catch (...) {
+					PWRN("zero-copy view unavailable, falling back to copying");
+					return 0;
+				}
+			}
 
 		public:
 
+			/**
+			 * Constructor
+			 *
+			 * \param zero_copy  if true, the client receives frames of other
+			 *                   zero-copy clients without copying
+			 */
 			Tx_rx_communication_buffers(Genode::size_t tx_size,
-			                            Genode::size_t rx_size)
-			: _tx_buf(tx_size), _rx_buf(rx_size) { }
+			                            Genode::size_t rx_size,
+			                            bool           zero_copy)
+			: _tx_buf(tx_size), _rx_buf(rx_size),
+			  _view(zero_copy ? _create_view() : 0) { }
+
+			~Tx_rx_communication_buffers()
+			{
+				if (_view)
+					destroy(Genode::env()->heap(), _view);
+			}
 
 			Genode::Dataspace_capability tx_ds() { return _tx_buf.dataspace(); }
-			Genode::Dataspace_capability rx_ds() { return _rx_buf.dataspace(); }
+
+			Genode::Dataspace_capability rx_ds() {
+				return _view ? _view->dataspace() : _rx_buf.dataspace(); }
+
+			Communication_buffer &tx_buf() { return _tx_buf; }
+
+			/**
+			 * Return zero-copy view, or 0 if the client copies frames
+			 */
+			Zero_copy::View *view() { return _view; }
 	};
 
 
@@ -102,11 +190,36 @@ namespace Net {
 	{
 		private:
 
+			enum {
+				IGMP_IP_ID = 2,
+
+				/* maximum number of multicast groups joined by the client */
+				MAX_GROUPS = 32,
+			};
+
 			Mac_address_node   _mac_node;
 			Ipv4_address_node *_ipv4_node;
+			unsigned           _num_groups;
+			int                _slot;      /* zero-copy slot of tx buffer */
+			Borrowed_packets   _borrowed;  /* frames of zero-copy senders */
 
 			void _free_ipv4_node();
 
+			/**
+			 * Acknowledge borrowed packet to its sender
+			 */
+			void _give_back(Packet_descriptor packet);
+
+			void _join(Ipv4_packet::Ipv4_address group);
+			void _leave(Ipv4_packet::Ipv4_address group);
+
+			/**
+			 * Track multicast group membership by snooping IGMP reports
+			 *
+			 * \param size  size of the IP packet
+			 */
+			void _handle_igmp(Ipv4_packet *ip, Genode::size_t size);
+
 		public:
 
 			/**
@@ -118,6 +231,7 @@ namespace Net {
 			 * \param rx_buf_size  buffer size for rx channel
 			 * \param vmac         virtual mac address
 			 * \param ep           entry point used for packet stream
+			 * \param zero_copy    share frames with other zero-copy clients
 			 */
 			Session_component(Genode::Allocator          *allocator,
 			                  Genode::size_t              amount,
@@ -125,7 +239,8 @@ namespace Net {
 			                  Genode::size_t              rx_buf_size,
 			                  Ethernet_frame::Mac_address vmac,
 			                  Genode::Rpc_entrypoint     &ep,
-			                  char                       *ip_addr = 0);
+			                  char                       *ip_addr = 0,
+			                  bool                        zero_copy = false);
 
 			~Session_component();
 
@@ -139,6 +254,13 @@ namespace Net {
 
 			void set_ipv4_address(Ipv4_packet::Ipv4_address ip_addr);
 
+			/**
+			 * Deliver current packet of sender without copying
+			 *
+			 * \return  false if the packet must be copied
+			 */
+			bool send_borrowed(Session_component &sender);
+
 			/******************************
 			 ** Packet_handler interface **
 			 ******************************/
@@ -152,6 +274,10 @@ namespace Net {
 			bool handle_arp(Ethernet_frame *eth,      Genode::size_t size);
 			bool handle_ip(Ethernet_frame *eth,       Genode::size_t size);
 			void finalize_packet(Ethernet_frame *eth, Genode::size_t size);
+
+		protected:
+
+			void _release_packet(Packet_descriptor packet) override;
 	};
 
 
@@ -177,6 +303,13 @@ namespace Net {
 				using namespace Genode;
 
 				memset(ip_addr, 0, MAX_IP_ADDR_LENGTH);
+				bool zero_copy = false;
+
+				 try {
+					Session_label  label(args);
+					Session_policy policy(label);
+					zero_copy = policy.attribute("zero_copy").has_value("yes");
+				} catch (...) { }
 
 				 try {
 					Session_label  label(args);
@@ -222,13 +355,21 @@ namespace Net {
 					                                          rx_buf_size,
 					                                          _mac_alloc.alloc(),
 					                                          _ep,
-					                                          ip_addr);
+					                                          ip_addr,
+					                                          zero_copy);
 				} catch(Mac_allocator::Alloc_failed) {
 					PWRN("Mac address allocation failed!");
 					return (Session_component*) 0;
 				}
 			}
 
+			void _destroy_session(Session_component *session)
+			{
+				/* do not interfere with the forwarding of packets */
+				Genode::Lock::Guard lock_guard(*Env::dispatch_lock());
+				Genode::Root_component<Session_component>::_destroy_session(session);
+			}
+
 		public:
 
 			Root(Genode::Rpc_entrypoint *session_ep,
@@ -34,3 +34,10 @@ Net::Nic* Net::Env::nic()
 	static Net::Nic nic;
 	return &nic;
 }
+
+
+Genode::Lock* Net::Env::dispatch_lock()
+{
+	static Genode::Lock lock;
+	return &lock;
+}
@@ -16,6 +16,7 @@
 #ifndef _SRC__SERVER__NIC_BRIDGE__ENV_H_
 #define _SRC__SERVER__NIC_BRIDGE__ENV_H_
 
+#include <base/lock.h>
 #include <base/signal.h>
 
 namespace Net {
@@ -31,6 +32,15 @@ struct Net::Env
 	static Vlan *vlan();
 
 	static Net::Nic *nic();
+
+	/**
+	 * Lock held while dispatching a signal
+	 *
+	 * Sessions are destroyed with the lock held, so that the packet
+	 * streams of each session are operated by one thread at a time and
+	 * the address nodes of a session are not destructed during a lookup.
+	 */
+	static Genode::Lock *dispatch_lock();
 };
 
 #endif /* _SRC__SERVER__NIC_BRIDGE__ENV_H_ */
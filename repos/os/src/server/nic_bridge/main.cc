@@ -54,6 +54,8 @@ int main(int, char **)
 
 		while (true) {
 			Signal s = Net::Env::receiver()->wait_for_signal();
+
+			Lock::Guard lock_guard(*Net::Env::dispatch_lock());
 			static_cast<Signal_dispatcher_base *>(s.context())->dispatch(s.num());
 		}
 	} catch (Parent::Service_denied) {
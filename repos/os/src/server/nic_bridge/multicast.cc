@@ -0,0 +1,48 @@
+/*
+ * \brief  Multicast group membership of the clients
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include "component.h"
+#include "multicast.h"
+
+using namespace Net;
+
+
+void Multicast::leave_all(Session_component *component)
+{
+	Genode::Lock::Guard lock_guard(_lock);
+
+	for (Group *group = _group_list.first(); group; ) {
+		Group  *next   = group->next();
+		Member *member = group->member(component);
+		if (member)
+			_leave(group, member);
+		group = next;
+	}
+}
+
+
+bool Multicast::deliver(Ethernet_frame *eth, Genode::size_t size,
+                        Packet_handler *sender)
+{
+	Genode::Lock::Guard lock_guard(_lock);
+
+	Group *group = _groups.lookup(eth->dst());
+	if (!group)
+		return false;
+
+	for (Member *m = group->members().first(); m; m = m->next())
+		if (static_cast<Packet_handler *>(m->component) != sender)
+			m->component->send(eth, size);
+
+	return true;
+}
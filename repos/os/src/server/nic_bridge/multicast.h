@@ -0,0 +1,209 @@
+/*
+ * \brief  Multicast group membership of the clients
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _MULTICAST_H_
+#define _MULTICAST_H_
+
+/* Genode */
+#include <base/env.h>
+#include <base/lock.h>
+#include <util/list.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+
+#include "address_table.h"
+
+namespace Net {
+	class Session_component;
+	class Packet_handler;
+	class Multicast;
+}
+
+
+/**
+ * Table of the multicast groups joined by the clients
+ *
+ * The groups are keyed by their Ethernet multicast address. The memberships
+ * are learned by snooping the IGMP reports sent by the clients. Frames
+ * addressed to a known group are delivered to the members only, frames
+ * addressed to an unknown group are flooded by the caller.
+ */
+class Net::Multicast
+{
+	public:
+
+		typedef Ethernet_frame::Mac_address Mac_address;
+
+		/**
+		 * Return Ethernet address of IPv4 multicast group
+		 */
+		static Mac_address group_mac(Ipv4_packet::Ipv4_address ip)
+		{
+			Mac_address mac;
+			mac.addr[0] = 0x01;
+			mac.addr[1] = 0x00;
+			mac.addr[2] = 0x5e;
+			mac.addr[3] = ip.addr[1] & 0x7f;
+			mac.addr[4] = ip.addr[2];
+			mac.addr[5] = ip.addr[3];
+			return mac;
+		}
+
+		/**
+		 * Return true if Ethernet address denotes a multicast group
+		 */
+		static bool multicast(Mac_address const &mac) {
+			return mac.addr[0] & 1; }
+
+		/**
+		 * Return true if frames to the group must always be flooded
+		 *
+		 * The groups of 224.0.0.0/24 are used by routing and discovery
+		 * protocols without any IGMP report.
+		 */
+		static bool link_local(Mac_address const &mac)
+		{
+			return mac.addr[0] == 0x01 && mac.addr[1] == 0x00
+			    && mac.addr[2] == 0x5e && mac.addr[3] == 0
+			    && mac.addr[4] == 0;
+		}
+
+	private:
+
+		struct Member : Genode::List<Member>::Element
+		{
+			Session_component * const component;
+
+			Member(Session_component *component) : component(component) { }
+		};
+
+		class Group : public Genode::List<Group>::Element
+		{
+			public:
+
+				typedef Mac_address Address;
+
+			private:
+
+				Address                _addr;
+				Group * volatile       _hash_next;
+				Genode::List<Member>   _members;
+
+				template <typename> friend class Address_table;
+
+			public:
+
+				Group(Address addr) : _addr(addr), _hash_next(0) { }
+
+				Address const &addr() const { return _addr; }
+
+				Genode::List<Member> &members() { return _members; }
+
+				Member *member(Session_component *component)
+				{
+					for (Member *m = _members.first(); m; m = m->next())
+						if (m->component == component)
+							return m;
+					return 0;
+				}
+		};
+
+		Address_table<Group> _groups;
+		Genode::List<Group>  _group_list;  /* for iterating all groups */
+		Genode::Lock         _lock;
+
+		/**
+		 * Remove member from group, release group if it got empty
+		 */
+		void _leave(Group *group, Member *member)
+		{
+			group->members().remove(member);
+			destroy(Genode::env()->heap(), member);
+
+			if (group->members().first())
+				return;
+
+			_groups.remove(group);
+			_group_list.remove(group);
+			destroy(Genode::env()->heap(), group);
+		}
+
+	public:
+
+		/**
+		 * Add client to group
+		 *
+		 * \return  true if the client was not a member of the group before
+		 */
+		bool join(Mac_address const &mac, Session_component *component)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			Group *group = _groups.lookup(mac);
+			if (group && group->member(component))
+				return false;
+
+			try {
+				if (!group) {
+					group = new (Genode::env()->heap()) Group(mac);
+					_groups.insert(group);
+					_group_list.insert(group);
+				}
+				group->members().insert(new (Genode::env()->heap())
+				                        Member(component));
+				return true;
+			} catch (Genode::Allocator::Out_of_memory) {
+				if (group && !group->members().first()) {
+					_groups.remove(group);
+					_group_list.remove(group);
+					destroy(Genode::env()->heap(), group);
+				}
+				return false;
+			}
+		}
+
+		/**
+		 * Remove client from group
+		 *
+		 * \return  true if the client was a member of the group
+		 */
+		bool leave(Mac_address const &mac, Session_component *component)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			Group  *group  = _groups.lookup(mac);
+			Member *member = group ? group->member(component) : 0;
+			if (!member)
+				return false;
+
+			_leave(group, member);
+			return true;
+		}
+
+		/**
+		 * Remove client from all groups
+		 */
+		void leave_all(Session_component *component);
+
+		/**
+		 * Deliver frame to the members of its destination group
+		 *
+		 * \param sender  packet handler the frame originates from, which
+		 *                is skipped
+		 * \return        false if no client joined the group
+		 */
+		bool deliver(Ethernet_frame *eth, Genode::size_t size,
+		             Packet_handler *sender);
+};
+
+#endif /* _MULTICAST_H_ */
@@ -27,22 +27,117 @@ using namespace Net;
 
 static const bool verbose = true;
 
+Packet_handler *Packet_handler::_dirty_list;
+Genode::Lock    Packet_handler::_batch_lock;
+
+
+void Packet_handler::_flush()
+{
+	unsigned const num = Genode::min(_batch_count,
+	                                 source()->submit_slots_free());
+
+	source()->submit_packets(_batch, num);
+
+	/* drop the packets that do not fit into the submit queue */
+	for (unsigned i = num; i < _batch_count; i++)
+		_release_packet(_batch[i]);
+
+	if (verbose && num < _batch_count)
+		PWRN("%u packets dropped", _batch_count - num);
+
+	_batch_count = 0;
+}
+
+
+void Packet_handler::_flush_all()
+{
+	Genode::Lock::Guard lock_guard(_batch_lock);
+
+	while (Packet_handler *handler = _dirty_list) {
+		_dirty_list          = handler->_next_dirty;
+		handler->_next_dirty = 0;
+		handler->_dirty      = false;
+		handler->_flush();
+	}
+}
+
+
+void Packet_handler::_discard_batch()
+{
+	Genode::Lock::Guard lock_guard(_batch_lock);
+
+	for (unsigned i = 0; i < _batch_count; i++)
+		_release_packet(_batch[i]);
+	_batch_count = 0;
+
+	if (!_dirty)
+		return;
+
+	for (Packet_handler **h = &_dirty_list; *h; h = &(*h)->_next_dirty)
+		if (*h == this) {
+			*h = _next_dirty;
+			break;
+		}
+	_dirty = false;
+}
+
+
+void Packet_handler::_flush_deferred_acks()
+{
+	while (_deferred_count && sink()->ready_to_ack()) {
+		sink()->acknowledge_packet(_deferred_acks[_deferred_head]);
+		_deferred_head = (_deferred_head + 1) % MAX_DEFERRED_ACKS;
+		_deferred_count--;
+	}
+}
+
+
+void Packet_handler::_acknowledge(Packet_descriptor packet)
+{
+	_flush_deferred_acks();
+
+	if (!_deferred_count && sink()->ready_to_ack()) {
+		sink()->acknowledge_packet(packet);
+		return;
+	}
+
+	if (_deferred_count == MAX_DEFERRED_ACKS) {
+		PERR("too many deferred acknowledgements, packet leaked");
+		return;
+	}
+
+	_deferred_acks[(_deferred_head + _deferred_count) % MAX_DEFERRED_ACKS] = packet;
+	_deferred_count++;
+}
+
+
 void Packet_handler::_ready_to_submit(unsigned)
 {
+	_flush_deferred_acks();
+
 	/* as long as packets are available, and we can ack them */
 	while (sink()->packet_avail()) {
 		_packet = sink()->get_packet();
 		if (!_packet.valid()) continue;
+
+		_packet_kept = false;
 		handle_ethernet(sink()->packet_content(_packet), _packet.size());
 
+		/* the packet is acknowledged once it got released by its receiver */
+		if (_packet_kept)
+			continue;
+
 		if (!sink()->ready_to_ack()) {
 			if (verbose)
 				PWRN("ack state FULL");
-			return;
+			break;
 		}
 
 		sink()->acknowledge_packet(_packet);
 	}
+
+	/* deliver the frames forwarded while handling the signal */
+	_flush_all();
 }
 
 
@@ -50,22 +145,31 @@ void Packet_handler::_ready_to_ack(unsigned)
 {
 	/* check for acknowledgements */
 	while (source()->ack_avail())
-		source()->release_packet(source()->get_acked_packet());
+		_release_packet(source()->get_acked_packet());
 }
 
 
 void Packet_handler::broadcast_to_clients(Ethernet_frame *eth, Genode::size_t size)
 {
-	/* check whether it's really a broadcast packet */
-	if (eth->dst() == Ethernet_frame::BROADCAST) {
-		/* iterate through the list of clients */
-		Mac_address_node *node =
-			Env::vlan()->mac_list()->first();
-		while (node) {
-			/* deliver packet */
+	Ethernet_frame::Mac_address const dst = eth->dst();
+
+	/* check whether it's really a broadcast or multicast packet */
+	if (!Multicast::multicast(dst))
+		return;
+
+	/* deliver multicast packets to the members of a known group only */
+	if (!(dst == Ethernet_frame::BROADCAST) && !Multicast::link_local(dst)
+	 && Env::vlan()->multicast()->deliver(eth, size, this))
+		return;
+
+	/* iterate through the list of clients */
+	Mac_address_node *node =
+		Env::vlan()->mac_list()->first();
+	while (node) {
+		/* deliver packet, but not back to its sender */
+		if (static_cast<Packet_handler *>(node->component()) != this)
 			node->component()->send(eth, size);
-			node = node->next();
-		}
+		node = node->next();
 	}
 }
 
@@ -102,14 +206,31 @@ void Packet_handler::handle_ethernet(void* src, Genode::size_t size)
 }
 
 
+void Packet_handler::_submit(Packet_descriptor packet)
+{
+	Genode::Lock::Guard lock_guard(_batch_lock);
+
+	if (_batch_count == MAX_BATCH)
+		_flush();
+
+	_batch[_batch_count++] = packet;
+
+	if (!_dirty) {
+		_dirty      = true;
+		_next_dirty = _dirty_list;
+		_dirty_list = this;
+	}
+}
+
+
 void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
 {
 	try {
-		/* copy and submit packet */
+		/* copy packet and add it to the batch */
 		Packet_descriptor packet  = source()->alloc_packet(size);
 		char             *content = source()->packet_content(packet);
 		Genode::memcpy((void*)content, (void*)eth, size);
-		source()->submit_packet(packet);
+		_submit(packet);
 	} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
 		if (verbose)
 			PWRN("Packet dropped");
@@ -118,7 +239,8 @@ void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
 
 
 Packet_handler::Packet_handler()
-: _sink_ack(*Net::Env::receiver(), *this, &Packet_handler::_ack_avail),
+: _packet_kept(false), _deferred_head(0), _deferred_count(0), _batch_count(0), _dirty(false), _next_dirty(0),
+  _sink_ack(*Net::Env::receiver(), *this, &Packet_handler::_ack_avail),
   _sink_submit(*Net::Env::receiver(), *this, &Packet_handler::_ready_to_submit),
   _source_ack(*Net::Env::receiver(), *this, &Packet_handler::_ready_to_ack),
   _source_submit(*Net::Env::receiver(), *this, &Packet_handler::_packet_avail)
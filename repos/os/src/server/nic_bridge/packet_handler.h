@@ -15,6 +15,7 @@
 #define _PACKET_HANDLER_H_
 
 /* Genode */
+#include <base/lock.h>
 #include <base/semaphore.h>
 #include <base/thread.h>
 #include <nic_session/connection.h>
@@ -30,9 +31,55 @@ namespace Net {
  */
 class Net::Packet_handler
 {
+	public:
+
+		/*
+		 * Maximum number of packets kept by a handler at a time, must not
+		 * be exceeded by 'Zero_copy::MAX_BORROWED'
+		 */
+		enum { MAX_DEFERRED_ACKS = 256 };
+
 	private:
 
+		enum { MAX_BATCH = 32 };
+
 		Packet_descriptor _packet;
+		bool              _packet_kept;  /* ack of '_packet' is deferred */
+
+		/*
+		 * Acknowledgements of kept packets that found the acknowledgement
+		 * queue full, submitted once the queue has room again
+		 */
+		Packet_descriptor _deferred_acks[MAX_DEFERRED_ACKS];
+		unsigned          _deferred_head, _deferred_count;
+
+		/**
+		 * Submit deferred acknowledgements as far as the queue permits
+		 */
+		void _flush_deferred_acks();
+
+		/*
+		 * Packets sent to the handler's packet stream are collected and
+		 * submitted as a batch once the current signal is handled. Handlers
+		 * with pending packets are chained in the dirty list.
+		 */
+		Packet_descriptor _batch[MAX_BATCH];
+		unsigned          _batch_count;
+		bool              _dirty;
+		Packet_handler   *_next_dirty;
+
+		static Packet_handler *_dirty_list;
+		static Genode::Lock    _batch_lock;
+
+		/**
+		 * Submit pending packets, the batch lock must be held
+		 */
+		void _flush();
+
+		/**
+		 * Submit pending packets of all handlers
+		 */
+		static void _flush_all();
 
 		/**
 		 * submit queue not empty anymore
@@ -42,10 +89,10 @@ class Net::Packet_handler
 		/**
 		 * acknoledgement queue not full anymore
 		 *
-		 * TODO: by now, we assume ACK and SUBMIT queue to be equally
-		 *       dimensioned. That's why we ignore this signal by now.
+		 * Apart from deferred acknowledgements, we assume ACK and SUBMIT
+		 * queue to be equally dimensioned.
 		 */
-		void _ack_avail(unsigned) { }
+		void _ack_avail(unsigned) { _flush_deferred_acks(); }
 
 		/**
 		 * acknoledgement queue not empty anymore
@@ -62,6 +109,46 @@ class Net::Packet_handler
 
 	protected:
 
+		/**
+		 * Return packet currently handled by '_ready_to_submit'
+		 */
+		Packet_descriptor _current_packet() const { return _packet; }
+
+		/**
+		 * Defer acknowledgement of the current packet
+		 *
+		 * The packet must be acknowledged via '_acknowledge' later on.
+		 */
+		void _keep_current_packet() { _packet_kept = true; }
+
+		/**
+		 * Acknowledge packet kept via '_keep_current_packet'
+		 *
+		 * If the acknowledgement queue is full, the acknowledgement is
+		 * deferred until the queue has room again.
+		 */
+		void _acknowledge(Packet_descriptor packet);
+
+		/**
+		 * Add packet of the handler's packet stream to the batch
+		 */
+		void _submit(Packet_descriptor packet);
+
+		/**
+		 * Release packet acknowledged by or not submitted to the other side
+		 */
+		virtual void _release_packet(Packet_descriptor packet) {
+			source()->release_packet(packet); }
+
+		/**
+		 * Drop pending packets and leave the dirty list
+		 *
+		 * Must be called by the destructor of a derived class because the
+		 * packet stream is not accessible anymore when the destructor of
+		 * 'Packet_handler' is executed.
+		 */
+		void _discard_batch();
+
 		Genode::Signal_dispatcher<Packet_handler> _sink_ack;
 		Genode::Signal_dispatcher<Packet_handler> _sink_submit;
 		Genode::Signal_dispatcher<Packet_handler> _source_ack;
@@ -71,13 +158,18 @@ class Net::Packet_handler
 
 		Packet_handler();
 
+		virtual ~Packet_handler() { }
+
 		virtual Packet_stream_sink< ::Nic::Session::Policy>   * sink()   = 0;
 		virtual Packet_stream_source< ::Nic::Session::Policy> * source() = 0;
 
 
 		/**
-		 * Broadcasts ethernet frame to all clients,
-		 * as long as its really a broadcast packtet.
+		 * Broadcasts ethernet frame to all clients but the sender,
+		 * as long as its really a broadcast or multicast packet.
+		 *
+		 * Multicast frames addressed to a group with known members are
+		 * delivered to the members only.
 		 *
 		 * \param eth   ethernet frame to send.
 		 * \param size  ethernet frame's size.
@@ -88,6 +180,8 @@ class Net::Packet_handler
 		/**
 		 * Send ethernet frame
 		 *
+		 * The frame is submitted with the next batch of the handler.
+		 *
 		 * \param eth   ethernet frame to send.
 		 * \param size  ethernet frame's size.
 		 */
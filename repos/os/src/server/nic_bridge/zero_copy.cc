@@ -0,0 +1,44 @@
+/*
+ * \brief  Zero-copy forwarding between clients
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include "component.h"
+#include "zero_copy.h"
+
+using namespace Net;
+
+
+/* each frame borrowed from a sender may have to be acknowledged deferred */
+static_assert((int)Zero_copy::MAX_BORROWED <= (int)Packet_handler::MAX_DEFERRED_ACKS,
+              "deferred-acknowledgement queue too small");
+
+
+Session_component *Zero_copy::give_back(unsigned slot)
+{
+	Genode::Lock::Guard lock_guard(_lock);
+
+	Slot &s = _slots[slot];
+	if (!s.used || !s.borrowed)
+		return 0;
+
+	s.borrowed--;
+
+	if (s.owner)
+		return s.owner;
+
+	/* the sender is gone, release its buffer with the last frame */
+	if (!s.borrowed) {
+		_release(slot);
+		Genode::env()->ram_session()->free(s.ds);
+	}
+	return 0;
+}
@@ -0,0 +1,307 @@
+/*
+ * \brief  Zero-copy forwarding between clients
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _ZERO_COPY_H_
+#define _ZERO_COPY_H_
+
+/* Genode */
+#include <base/env.h>
+#include <base/lock.h>
+#include <dataspace/client.h>
+#include <rm_session/connection.h>
+#include <util/list.h>
+#include <nic_session/nic_session.h>
+
+namespace Net {
+	class Session_component;
+	class Zero_copy;
+	class Borrowed_packets;
+}
+
+
+/**
+ * Registry of the transmit buffers shared among zero-copy clients
+ *
+ * The transmit buffer of each zero-copy client occupies a slot. The receive
+ * buffer of each zero-copy client is a managed dataspace, the view, that
+ * starts with the client's private receive buffer followed by the slots.
+ * The transmit buffers of all zero-copy clients are attached read-only at
+ * their slots of each view. Hence, a frame sent by one zero-copy client is
+ * delivered to another by submitting a packet that refers to the frame
+ * within the sender's slot. The packet is acknowledged to the sender not
+ * before the receiver acknowledged it.
+ *
+ * Because each zero-copy client is able to read the transmit buffers of
+ * all other zero-copy clients, the mode must be enabled for mutually
+ * trusted clients only.
+ */
+class Net::Zero_copy
+{
+	public:
+
+		enum {
+			MAX_SENDERS  = 16,
+			SLOT_SIZE    = 1024*1024,
+
+			/* frames of one slot delivered at a time */
+			MAX_BORROWED = 256,
+		};
+
+		class View : public Genode::List<View>::Element
+		{
+			private:
+
+				Genode::size_t const  _private_size;
+				Genode::Rm_connection _rm;
+
+			public:
+
+				/**
+				 * Exception type
+				 */
+				class Unavailable : public Genode::Exception { };
+
+				/**
+				 * Constructor
+				 *
+				 * \param private_ds  receive buffer used for the frames
+				 *                    copied into the view
+				 *
+				 * \throw Unavailable  if the platform lacks managed
+				 *                     dataspaces, as base-linux does
+				 */
+				View(Genode::Dataspace_capability private_ds)
+				:
+					_private_size(Genode::Dataspace_client(private_ds).size()),
+					_rm(0, _private_size + MAX_SENDERS*SLOT_SIZE)
+				{
+					if (!_rm.dataspace().valid())
+						throw Unavailable();
+
+					_rm.attach_at(private_ds, 0);
+				}
+
+				Genode::Dataspace_capability dataspace() {
+					return _rm.dataspace(); }
+
+				Genode::off_t slot_offset(unsigned slot) const {
+					return _private_size + slot*SLOT_SIZE; }
+
+				/**
+				 * Return slot of packet, or -1 if the packet is private
+				 */
+				int slot(Packet_descriptor packet) const
+				{
+					if (packet.offset() < (Genode::off_t)_private_size)
+						return -1;
+					return (packet.offset() - _private_size) / SLOT_SIZE;
+				}
+
+				void attach(unsigned slot, Genode::Dataspace_capability ds)
+				{
+					try {
+						_rm.attach(ds, 0, 0, true, slot_offset(slot), false, false);
+					} catch (Genode::Rm_session::Out_of_metadata) {
+						Genode::env()->parent()->upgrade(_rm.cap(), "ram_quota=8K");
+						_rm.attach(ds, 0, 0, true, slot_offset(slot), false, false);
+					}
+				}
+
+				void detach(unsigned slot) { _rm.detach(slot_offset(slot)); }
+		};
+
+	private:
+
+		struct Slot
+		{
+			bool                              used;
+			Session_component                *owner;  /* 0 if owner is gone */
+			Genode::Ram_dataspace_capability  ds;
+			unsigned                          borrowed;
+		};
+
+		Slot               _slots[MAX_SENDERS];
+		Genode::List<View> _views;
+		Genode::Lock       _lock;
+
+		void _release(unsigned slot)
+		{
+			for (View *v = _views.first(); v; v = v->next())
+				v->detach(slot);
+			_slots[slot].used = false;
+		}
+
+	public:
+
+		Zero_copy()
+		{
+			for (unsigned i = 0; i < MAX_SENDERS; i++)
+				_slots[i].used = false;
+		}
+
+		/**
+		 * Share transmit buffer of client with all views
+		 *
+		 * \return  slot of the buffer, or -1 if the buffer cannot be shared
+		 */
+		int add_sender(Session_component *owner,
+		               Genode::Ram_dataspace_capability ds)
+		{
+			if (Genode::Dataspace_client(ds).size() > SLOT_SIZE)
+				return -1;
+
+			Genode::Lock::Guard lock_guard(_lock);
+
+			for (unsigned i = 0; i < MAX_SENDERS; i++) {
+				if (_slots[i].used)
+					continue;
+
+				Slot &s = _slots[i];
+				s.used = true; s.owner = owner; s.ds = ds; s.borrowed = 0;
+
+				for (View *v = _views.first(); v; v = v->next())
+					v->attach(i, ds);
+				return i;
+			}
+			return -1;
+		}
+
+		/**
+		 * Withdraw transmit buffer of client that is about to be closed
+		 *
+		 * \return  true if the buffer is still referenced by packets of
+		 *          other clients, in which case its ownership passes to
+		 *          the registry
+		 */
+		bool remove_sender(unsigned slot)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			_slots[slot].owner = 0;
+			if (_slots[slot].borrowed)
+				return true;
+
+			_release(slot);
+			return false;
+		}
+
+		void add_view(View *view)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			for (unsigned i = 0; i < MAX_SENDERS; i++)
+				if (_slots[i].used)
+					view->attach(i, _slots[i].ds);
+			_views.insert(view);
+		}
+
+		void remove_view(View *view)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+			_views.remove(view);
+		}
+
+		/**
+		 * Account a frame of the slot being delivered to another client
+		 *
+		 * \return  false if too many frames of the slot are delivered
+		 *          already, in which case the frame must be copied
+		 */
+		bool borrow(unsigned slot)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			if (_slots[slot].borrowed == MAX_BORROWED)
+				return false;
+
+			_slots[slot].borrowed++;
+			return true;
+		}
+
+		/**
+		 * Return borrowed frame to its sender
+		 *
+		 * \return  sender to acknowledge the frame to, or 0 if the sender
+		 *          is gone
+		 */
+		Session_component *give_back(unsigned slot);
+};
+
+
+/**
+ * Packets of a view that refer to the transmit buffers of other clients
+ */
+class Net::Borrowed_packets
+{
+	public:
+
+		enum { MAX_PACKETS = 256 };
+
+	private:
+
+		Packet_descriptor _packets[MAX_PACKETS];  /* free if size is 0 */
+		unsigned          _count;
+
+		static unsigned _hash(Packet_descriptor packet) {
+			return (packet.offset() >> 6) % MAX_PACKETS; }
+
+	public:
+
+		Borrowed_packets() : _count(0) { }
+
+		/**
+		 * Record packet
+		 *
+		 * \return  false if the table is full
+		 */
+		bool insert(Packet_descriptor packet)
+		{
+			if (_count == MAX_PACKETS)
+				return false;
+
+			for (unsigned i = _hash(packet); ; i = (i + 1) % MAX_PACKETS)
+				if (!_packets[i].size()) {
+					_packets[i] = packet;
+					_count++;
+					return true;
+				}
+		}
+
+		/**
+		 * Remove packet
+		 *
+		 * \return  false if the packet was not recorded
+		 */
+		bool remove(Packet_descriptor packet)
+		{
+			unsigned i = _hash(packet);
+			for (unsigned n = 0; n < MAX_PACKETS; n++, i = (i + 1) % MAX_PACKETS)
+				if (_packets[i].size() && _packets[i].offset() == packet.offset()
+				 && _packets[i].size() == packet.size()) {
+					_packets[i] = Packet_descriptor();
+					_count--;
+					return true;
+				}
+			return false;
+		}
+
+		template <typename FUNC>
+		void for_each(FUNC const &fn)
+		{
+			for (unsigned i = 0; i < MAX_PACKETS; i++)
+				if (_packets[i].size())
+					fn(_packets[i]);
+		}
+};
+
+#endif /* _ZERO_COPY_H_ */
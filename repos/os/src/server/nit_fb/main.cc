@@ -21,6 +21,7 @@
 #include <os/server.h>
 #include <os/attached_dataspace.h>
 #include <timer_session/connection.h>
+#include <util/dirty_region.h>
 
 namespace Nit_fb {
 
@@ -125,6 +126,13 @@ struct Framebuffer::Session_component : Genode::Rpc_object<Framebuffer::Session>
 
 	bool _dataspace_is_new = true;
 
+	/*
+	 * Areas refreshed by the client since the last frame of nitpicker
+	 */
+	Genode::Dirty_region<Nit_fb::Rect, 16> _damage;
+
+	Genode::Signal_context_capability _sync_sigh;
+
 
 	/**
 	 * Constructor
@@ -154,6 +162,22 @@ struct Framebuffer::Session_component : Genode::Rpc_object<Framebuffer::Session>
 		return Nitpicker::Area(_active_mode.width(), _active_mode.height());
 	}
 
+	/**
+	 * Forward the accumulated refreshes to nitpicker
+	 *
+	 * Called at the completion of each frame of nitpicker. Hence, a
+	 * client that refreshes its buffer many times per frame causes only
+	 * one redraw.
+	 */
+	void frame()
+	{
+		_damage.flush([&] (Nit_fb::Rect const &rect) {
+			_nit_fb.refresh(rect.x1(), rect.y1(), rect.w(), rect.h()); });
+
+		if (_sync_sigh.valid())
+			Genode::Signal_transmitter(_sync_sigh).submit();
+	}
+
 
 	/************************************
 	 ** Framebuffer::Session interface **
@@ -191,12 +215,14 @@ struct Framebuffer::Session_component : Genode::Rpc_object<Framebuffer::Session>
 			_dataspace_is_new = false;
 		}
 
-		_nit_fb.refresh(x, y, w, h);
+		if (w > 0 && h > 0)
+			_damage.mark_as_dirty(Nit_fb::Rect(Nit_fb::Point(x, y),
+			                                   Nit_fb::Area(w, h)));
 	}
 
 	void sync_sigh(Genode::Signal_context_capability sigh) override
 	{
-		_nit_fb.sync_sigh(sigh);
+		_sync_sigh = sigh;
 	}
 };
 
@@ -300,6 +326,11 @@ struct Nit_fb::Main : View_updater
 	Signal_rpc_member<Main> input_dispatcher =
 		{ ep, *this, &Main::handle_input};
 
+	void handle_sync(unsigned) { fb_session.frame(); }
+
+	Signal_rpc_member<Main> sync_dispatcher =
+		{ ep, *this, &Main::handle_sync};
+
 	/**
 	 * Constructor
 	 */
@@ -324,6 +355,7 @@ struct Nit_fb::Main : View_updater
 		Genode::config()->sigh(config_update_dispatcher);
 		nitpicker.mode_sigh(mode_update_dispatcher);
 		nitpicker.input()->sigh(input_dispatcher);
+		nitpicker.framebuffer()->sync_sigh(sync_dispatcher);
 	}
 };
 
@@ -1138,6 +1138,7 @@ struct Nitpicker::Main
 
 	Genode::Reporter pointer_reporter = { "pointer" };
 	Genode::Reporter focus_reporter   = { "focus" };
+	Genode::Reporter damage_reporter  = { "damage" };
 
 	Root<PT> np_root = { session_list, *domain_registry, global_keys,
 	                     ep.rpc_ep(), user_state, user_state, pointer_origin,
@@ -1166,16 +1167,93 @@ struct Nitpicker::Main
 	 */
 	Timer::Connection timer;
 
+	/*
+	 * Redraw statistics, reported once per second
+	 */
+	struct Damage_stats
+	{
+		unsigned long frames = 0, rects = 0, pixels = 0, start_ms = 0;
+	} damage_stats;
+
+	void report_damage()
+	{
+		if (!damage_reporter.is_enabled())
+			return;
+
+		unsigned long const now     = timer.elapsed_ms();
+		unsigned long const elapsed = now - damage_stats.start_ms;
+		if (elapsed < 1000)
+			return;
+
+		Damage_stats const &s = damage_stats;
+		Genode::Reporter::Xml_generator xml(damage_reporter, [&] ()
+		{
+			xml.attribute("fps",    s.frames*1000/elapsed);
+			xml.attribute("rects",  s.rects*1000/elapsed);
+			xml.attribute("pixels", s.pixels*1000/elapsed);
+		});
+
+		damage_stats = Damage_stats();
+		damage_stats.start_ms = now;
+	}
+
 	/**
 	 * Perform redraw and flush pixels to the framebuffer
+	 *
+	 * \return  true if any pixels were flushed
 	 */
-	void draw_and_flush()
+	bool draw_and_flush()
 	{
-		user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
+		Damage damage = user_state.draw(fb_screen->screen);
+
+		bool const flushed = damage.count() > 0;
+		if (flushed) {
+			damage_stats.frames++;
+			damage_stats.rects  += damage.count();
+			damage_stats.pixels += damage.pixels();
+		}
+
+		damage.flush([&] (Rect const &rect) {
 			framebuffer.refresh(rect.x1(), rect.y1(),
 			                    rect.w(),  rect.h()); });
+
+		report_damage();
+		return flushed;
 	}
 
+	/*
+	 * Frame scheduling
+	 *
+	 * The damage caused by clients and user input is accumulated and
+	 * redrawn at most once per period of the timer. If the framebuffer
+	 * driver delivers sync signals, a frame is not drawn before the
+	 * driver signalled the completion of the previous one. A frame that
+	 * became due in the meantime is drawn right at the sync signal.
+	 */
+	enum {
+		DEFAULT_PERIOD_MS   = 10,
+		FB_SYNC_TIMEOUT_MS  = 100,  /* give up waiting for the driver */
+	};
+
+	unsigned period_ms          = 0;
+	bool     fb_sync_supported  = false;
+	bool     frame_due          = false;
+	unsigned fb_sync_wait_ms    = 0;    /* 0 if not waiting for the driver */
+
+	void handle_fb_sync(unsigned);
+
+	Signal_rpc_member<Main> fb_sync_dispatcher = { ep, *this, &Main::handle_fb_sync };
+
+	/**
+	 * Redraw damage and signal the completion of the frame to the clients
+	 */
+	void frame();
+
+	/**
+	 * Called once per period
+	 */
+	void schedule_frame();
+
 	Main(Server::Entrypoint &ep) : ep(ep)
 	{
 //		tmp_fb = &framebuffer;
@@ -1184,13 +1262,13 @@ struct Nitpicker::Main
 		user_state.stack(pointer_origin);
 		user_state.stack(background);
 
+		timer.sigh(input_dispatcher);
+
 		config()->sigh(config_dispatcher);
 		handle_config(0);
 
-		timer.sigh(input_dispatcher);
-		timer.trigger_periodic(10*1000);
-
 		framebuffer.mode_sigh(fb_mode_dispatcher);
+		framebuffer.sync_sigh(fb_sync_dispatcher);
 
 		env()->parent()->announce(ep.manage(np_root));
 	}
@@ -1257,18 +1335,8 @@ void Nitpicker::Main::handle_input(unsigned)
 		if (old_pointer_pos != new_pointer_pos)
 			user_state.geometry(pointer_origin, Rect(new_pointer_pos, Area()));
 
-		/* perform redraw and flush pixels to the framebuffer */
-		user_state.draw(fb_screen->screen).flush([&] (Rect const &rect) {
-			framebuffer.refresh(rect.x1(), rect.y1(),
-			                    rect.w(),  rect.h()); });
-
-		user_state.mark_all_views_as_clean();
-
-		/* deliver framebuffer synchronization events */
-		if (!user_state.kill()) {
-			for (::Session *s = session_list.first(); s; s = s->next())
-				s->submit_sync();
-		}
+		/* redraw and flush pixels to the framebuffer if a frame is due */
+		schedule_frame();
 
 		/*
 		 * In kill mode, we do not leave the dispatch function in order to
@@ -1284,6 +1352,51 @@ void Nitpicker::Main::handle_input(unsigned)
 }
 
 
+void Nitpicker::Main::frame()
+{
+	frame_due = false;
+
+	if (draw_and_flush() && fb_sync_supported)
+		fb_sync_wait_ms = period_ms;
+
+	user_state.mark_all_views_as_clean();
+
+	/* deliver frame-completion signals */
+	if (!user_state.kill()) {
+		for (::Session *s = session_list.first(); s; s = s->next())
+			s->submit_sync();
+	}
+}
+
+
+void Nitpicker::Main::schedule_frame()
+{
+	frame_due = true;
+
+	if (fb_sync_wait_ms) {
+
+		/* keep waiting for the driver unless it failed to respond */
+		if (fb_sync_wait_ms < FB_SYNC_TIMEOUT_MS) {
+			fb_sync_wait_ms += period_ms;
+			return;
+		}
+		fb_sync_wait_ms = 0;
+	}
+
+	frame();
+}
+
+
+void Nitpicker::Main::handle_fb_sync(unsigned)
+{
+	fb_sync_supported = true;
+	fb_sync_wait_ms   = 0;
+
+	if (frame_due)
+		frame();
+}
+
+
 void Nitpicker::Main::handle_config(unsigned)
 {
 	config()->reload();
@@ -1310,6 +1423,27 @@ void Nitpicker::Main::handle_config(unsigned)
 		                                           .has_value("yes"));
 	} catch (...) { }
 
+	try {
+		damage_reporter.enabled(config()->xml_node().sub_node("report")
+		                                            .attribute("damage")
+		                                            .has_value("yes"));
+	} catch (...) { }
+
+	/* update frame period */
+	unsigned new_period_ms = DEFAULT_PERIOD_MS;
+	try {
+		config()->xml_node().sub_node("frame")
+		.attribute("period_ms").value(&new_period_ms);
+	} catch (...) { }
+
+	if (new_period_ms == 0)
+		new_period_ms = DEFAULT_PERIOD_MS;
+
+	if (new_period_ms != period_ms) {
+		period_ms = new_period_ms;
+		timer.trigger_periodic(period_ms*1000);
+	}
+
 	/* update domain registry and session policies */
 	for (::Session *s = session_list.first(); s; s = s->next())
 		s->reset_domain();
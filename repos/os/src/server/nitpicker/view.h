@@ -17,7 +17,7 @@
 /* Genode includes */
 #include <util/string.h>
 #include <util/list.h>
-#include <util/dirty_rect.h>
+#include <util/dirty_region.h>
 #include <base/weak_ptr.h>
 #include <base/rpc_server.h>
 
@@ -31,7 +31,7 @@ class Buffer;
 extern Framebuffer::Session *tmp_fb;
 
 
-typedef Genode::Dirty_rect<Rect, 3> Dirty_rect;
+typedef Genode::Dirty_region<Rect, 8> Dirty_region;
 
 
 /*
@@ -90,7 +90,7 @@ class View : public Same_buffer_list_elem,
 		Point      _buffer_off;     /* offset to the visible buffer area    */
 		Session   &_session;        /* session that created the view        */
 		char       _title[TITLE_LEN];
-		Dirty_rect _dirty_rect;
+		Dirty_region _dirty_region;
 
 		Genode::List<View_parent_elem> _children;
 
@@ -284,17 +284,17 @@ class View : public Same_buffer_list_elem,
 		 *
 		 * \param rect  dirty rectangle in absolute coordinates
 		 */
-		void mark_as_dirty(Rect rect) { _dirty_rect.mark_as_dirty(rect); }
+		void mark_as_dirty(Rect rect) { _dirty_region.mark_as_dirty(rect); }
 
 		/**
-		 * Return dirty-rectangle information
+		 * Return dirty region of the view
 		 */
-		Dirty_rect dirty_rect() const { return _dirty_rect; }
+		Dirty_region dirty_region() const { return _dirty_region; }
 
 		/**
-		 * Reset dirty rectangle
+		 * Reset dirty region
 		 */
-		void mark_as_clean() { _dirty_rect = Dirty_rect(); }
+		void mark_as_clean() { _dirty_region = Dirty_region(); }
 };
 
 #endif /* _VIEW_H_ */
@@ -190,7 +190,7 @@ void View_stack::draw_rec(Canvas_base &canvas, View const *view, Rect rect) cons
 	if (next && left.valid()) draw_rec(canvas, next, left);
 
 	/* draw current view */
-	view->dirty_rect().flush([&] (Rect const &dirty_rect) {
+	view->dirty_region().flush([&] (Rect const &dirty_rect) {
 
 		Clip_guard clip_guard(canvas, Rect::intersect(clipped, dirty_rect));
 
@@ -20,6 +20,12 @@
 class Session;
 
 
+/**
+ * Damage of the screen accumulated between two redraws
+ */
+typedef Genode::Dirty_region<Rect, 32> Damage;
+
+
 class View_stack
 {
 	private:
@@ -28,7 +34,7 @@ class View_stack
 		Mode                          &_mode;
 		Genode::List<View_stack_elem>  _views;
 		View                          *_default_background = nullptr;
-		Dirty_rect mutable             _dirty_rect;
+		Damage mutable                 _damage;
 
 		/**
 		 * Return outline geometry of a view
@@ -75,7 +81,7 @@ class View_stack
 		 */
 		void _mark_view_as_dirty(View &view, Rect rect)
 		{
-			_dirty_rect.mark_as_dirty(rect);
+			_damage.mark_as_dirty(rect);
 
 			view.mark_as_dirty(rect);
 		}
@@ -87,7 +93,7 @@ class View_stack
 		 */
 		View_stack(Area size, Mode &mode) : _size(size), _mode(mode)
 		{
-			_dirty_rect.mark_as_dirty(Rect(Point(0, 0), _size));
+			_damage.mark_as_dirty(Rect(Point(0, 0), _size));
 		}
 
 		/**
@@ -111,13 +117,20 @@ class View_stack
 
 		/**
 		 * Draw dirty areas
+		 *
+		 * The damage accumulated since the last call is clipped against
+		 * the view stack once for each of its disjoint rectangles.
+		 *
+		 * \return  redrawn areas, which must be flushed to the framebuffer
 		 */
-		Dirty_rect draw(Canvas_base &canvas) const
+		Damage draw(Canvas_base &canvas) const
 		{
-			Dirty_rect result = _dirty_rect;
+			Damage result;
 
-			_dirty_rect.flush([&] (Rect const &rect) {
-				draw_rec(canvas, _first_view_const(), rect); });
+			_damage.flush([&] (Rect const &rect) {
+				draw_rec(canvas, _first_view_const(), rect);
+				result.mark_as_dirty(rect);
+			});
 
 			return result;
 		}
@@ -130,7 +143,7 @@ class View_stack
 			Rect const whole_screen(Point(), _size);
 
 			_place_labels(whole_screen);
-			_dirty_rect.mark_as_dirty(whole_screen);
+			_damage.mark_as_dirty(whole_screen);
 
 			for (View *view = _first_view(); view; view = view->view_stack_next())
 				view->mark_as_dirty(_outline(*view));
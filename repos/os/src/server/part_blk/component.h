@@ -120,8 +120,9 @@ class Block::Session_component : public Block::Session_rpc_object,
 		Session_component(Ram_dataspace_capability  rq_ds,
 		                  Partition                *partition,
 		                  Rpc_entrypoint           &ep,
-		                  Signal_receiver          &receiver)
-		: Session_rpc_object(rq_ds, ep),
+		                  Signal_receiver          &receiver,
+		                  unsigned                  queue_size = TX_QUEUE_SIZE)
+		: Session_rpc_object(rq_ds, ep, queue_size),
 		  _rq_ds(rq_ds),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
 		  _partition(partition),
@@ -234,6 +235,9 @@ class Block::Root :
 				Arg_string::find_arg(args, "ram_quota"  ).ulong_value(0);
 			size_t tx_buf_size =
 				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
+			unsigned tx_queue_size =
+				Arg_string::find_arg(args, "tx_queue_size")
+				.ulong_value(Block::Session::TX_QUEUE_SIZE);
 
 			/* delete ram quota by the memory needed for the session */
 			size_t session_size = max((size_t)4096,
@@ -253,6 +257,17 @@ class Block::Root :
 				throw Root::Quota_exceeded();
 			}
 
+			/*
+			 * The packet queues are located within the communication
+			 * buffer. Reject queue depths that leave no room for payload.
+			 */
+			if (Block::Session::Tx_policy::queues_size(tx_queue_size, tx_queue_size)
+			    >= tx_buf_size) {
+				PERR("'tx_buf_size' of %zd too small for 'tx_queue_size' %u",
+				     tx_buf_size, tx_queue_size);
+				throw Root::Quota_exceeded();
+			}
+
 			/* Search for configured partition number and the corresponding partition */
 			char label_buf[64];
 			Genode::Arg_string::find_arg(args,
@@ -275,7 +290,7 @@ class Block::Root :
 			return new (md_alloc())
 				Session_component(ds_cap,
 				                  Partition_table::table().partition(num),
-				                  _ep, _receiver);
+				                  _ep, _receiver, tx_queue_size);
 		}
 
 	public:
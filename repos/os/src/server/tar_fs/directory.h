@@ -47,8 +47,7 @@ namespace File_system {
 
 				int64_t index = seek_offset / sizeof(Directory_entry);
 
-				Lookup_member_of_path lookup_criterion(_record->name(), index);
-				Record *record = _lookup(&lookup_criterion);
+				Record *record = lookup_member_of_path(_record->name(), index);
 				if (!record)
 					return 0;
 
@@ -16,7 +16,9 @@
 #define _LOOKUP_H_
 
 /* Genode includes */
+#include <base/allocator.h>
 #include <os/path.h>
+#include <os/path_index.h>
 
 /* local includes */
 #include <node.h>
@@ -28,64 +30,24 @@ namespace File_system {
 
 	typedef Genode::Path<File_system::MAX_PATH_LEN> Absolute_path;
 
-	struct Lookup_criterion { virtual bool match(char const *path) = 0; };
-
-	struct Lookup_exact : public Lookup_criterion
-	{
-		Absolute_path _match_path;
-
-		Lookup_exact(char const *match_path)
-		: _match_path(match_path)
-		{
-			_match_path.remove_trailing('/');
-		}
-
-		bool match(char const *path)
-		{
-			Absolute_path test_path(path);
-			test_path.remove_trailing('/');
-			return _match_path.equals(test_path);
-		}
-	};
+	typedef Genode::Path_index<Record> Index;
 
+	/**
+	 * Index of all records of the archive, created by 'index_archive'
+	 */
+	extern Index *_index;
 
 	/**
-	 * Lookup the Nth record in the specified path
+	 * Build index of the records of the archive
+	 *
+	 * Directories that are not present as records of their own but only
+	 * as part of the paths of other records are equipped with a synthesized
+	 * directory record.
 	 */
-	struct Lookup_member_of_path : public Lookup_criterion
+	void index_archive(Genode::Allocator &alloc)
 	{
-		Absolute_path _dir_path;
-		int const index;
-		int cnt;
-
-		Lookup_member_of_path(char const *dir_path, int index)
-		: _dir_path(dir_path), index(index), cnt(0)
-		{
-			_dir_path.remove_trailing('/');
-		}
+		_index = new (&alloc) Index(alloc);
 
-		bool match(char const *path)
-		{
-			Absolute_path test_path(path);
-
-			if (!test_path.strip_prefix(_dir_path.base()))
-				return false;
-
-			if (!test_path.has_single_element())
-				return false;
-
-			cnt++;
-
-			/* match only if index is reached */
-			if (cnt - 1 != index)
-				return false;
-
-			return true;
-		}
-	};
-
-	Record *_lookup(Lookup_criterion *criterion)
-	{
 		/* measure size of archive in blocks */
 		unsigned block_id = 0, block_cnt = _tar_size/Record::BLOCK_LEN;
 
@@ -94,9 +56,9 @@ namespace File_system {
 
 			Record *record = (Record *)(_tar_base + block_id*Record::BLOCK_LEN);
 
-			/* get infos about current file */
-			if (criterion->match(record->name()))
-				return record;
+			try { _index->insert(record->name(), record); }
+			catch (Index::Path_too_long) {
+				PWRN("skipping TAR record with too long path"); }
 
 			size_t file_size = record->size();
 
@@ -116,9 +78,47 @@ namespace File_system {
 					break;
 		}
 
-		return 0;
+		_index->for_each([&] (Index::Entry &entry) {
+			if (entry.value)
+				return;
+
+			entry.value = new (&alloc) Record;
+			entry.value->init_directory(entry.path());
+		});
+
+		_index->finalize();
+	}
+
+
+	/**
+	 * Look up record by its path
+	 */
+	Record *lookup_exact(char const *path)
+	{
+		Index::Entry *entry = _index->lookup(path);
+		return entry ? entry->value : 0;
+	}
+
+
+	/**
+	 * Look up the Nth record in the specified path
+	 */
+	Record *lookup_member_of_path(char const *dir_path, unsigned index)
+	{
+		Index::Entry *dir   = _index->lookup(dir_path);
+		Index::Entry *entry = dir ? dir->child(index) : 0;
+		return entry ? entry->value : 0;
 	}
 
+
+	/**
+	 * Return number of records in the specified path
+	 */
+	unsigned num_members_of_path(char const *dir_path)
+	{
+		Index::Entry *dir = _index->lookup(dir_path);
+		return dir ? dir->num_children() : 0;
+	}
 }
 
 #endif /* _LOOKUP_H_ */
@@ -44,6 +44,7 @@ namespace File_system {
 
 	char  *_tar_base;
 	size_t _tar_size;
+	Index *_index;
 
 	class Session_component : public Session_rpc_object
 	{
@@ -217,8 +218,7 @@ namespace File_system {
 
 				PDBGV("abs_path = %s", abs_path.base());
 
-				Lookup_exact lookup_criterion(abs_path.base());
-				Record *record = _lookup(&lookup_criterion);
+				Record *record = lookup_exact(abs_path.base());
 
 				if (!record) {
 					PERR("Could not find record for %s", abs_path.base());
@@ -258,8 +258,7 @@ namespace File_system {
 
 				PDBGV("abs_path = %s", abs_path.base());
 
-				Lookup_exact lookup_criterion(abs_path.base());
-				Record *record = _lookup(&lookup_criterion);
+				Record *record = lookup_exact(abs_path.base());
 
 				if (!record) {
 					PERR("Could not find record for %s", abs_path.base());
@@ -290,8 +289,7 @@ namespace File_system {
 					throw Name_too_long();
 				}
 
-				Lookup_exact lookup_criterion(abs_path.base());
-				Record *record = _lookup(&lookup_criterion);
+				Record *record = lookup_exact(abs_path.base());
 
 				if (!record) {
 					PERR("Could not find record for %s", path.string());
@@ -323,8 +321,7 @@ namespace File_system {
 
 				PDBGV("abs_path = %s", abs_path.base());
 
-				Lookup_exact lookup_criterion(abs_path.base());
-				Record *record = _lookup(&lookup_criterion);
+				Record *record = lookup_exact(abs_path.base());
 
 				if (!record) {
 					PERR("Could not find record for %s", path.string());
@@ -383,13 +380,11 @@ namespace File_system {
 				switch (node->record()->type()) {
 					case Record::TYPE_DIR:
 						{
-							status.size = node->record()->size();
-
 							/* count directory entries */
-							Lookup_member_of_path lookup_criterion(node->record()->name(), ~0);
-							_lookup(&lookup_criterion);
+							unsigned const num_entries =
+								num_members_of_path(node->record()->name());
 
-							status.size = lookup_criterion.cnt*sizeof(Directory_entry);
+							status.size = num_entries*sizeof(Directory_entry);
 							status.mode |= Status::MODE_DIRECTORY;
 						break;
 						}
@@ -489,9 +484,7 @@ namespace File_system {
 							if (root[0] != '/')
 								throw Lookup_failed();
 
-							/* TODO: lookup root directory */
-							Lookup_exact lookup_criterion(root);
-							Record *record = _lookup(&lookup_criterion);
+							Record *record = lookup_exact(root);
 							if (!record) {
 								PERR("Could not find record for %s", root);
 								throw Lookup_failed();
@@ -590,6 +583,12 @@ int main(int, char **)
 
 	PINF("using tar archive '%s' with size %zd", tar_filename, _tar_size);
 
+	try { index_archive(*env()->heap()); }
+	catch (...) {
+		PERR("Could not index tar archive");
+		return -3;
+	}
+
 	static Record root_record; /* every member is 0 */
 	static Directory root_dir(&root_record);
 
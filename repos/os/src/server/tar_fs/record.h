@@ -69,6 +69,20 @@ namespace File_system {
 			char const *linked_name() const { return _linked_name; }
 
 			void *data() const { return (char *)this + BLOCK_LEN; }
+
+			/**
+			 * Initialize record as directory
+			 *
+			 * Used for directories that are not present in the archive as
+			 * records of their own.
+			 */
+			void init_directory(char const *name)
+			{
+				memset(this, 0, sizeof(*this));
+				strncpy(_name, name, sizeof(_name));
+				strncpy(_mode, "0000755", sizeof(_mode));
+				_type[0] = '0' + TYPE_DIR;
+			}
 	};
 
 }
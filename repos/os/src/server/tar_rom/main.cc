@@ -22,6 +22,7 @@
 #include <base/env.h>
 #include <base/printf.h>
 #include <os/config.h>
+#include <os/path_index.h>
 
 
 /**
@@ -31,8 +32,8 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 {
 	private:
 
-		const char *_tar_addr, *_filename, *_file_addr;
-		Genode::size_t _file_size, _tar_size;
+		const char *_record, *_filename, *_file_addr;
+		Genode::size_t _file_size;
 		Genode::Ram_dataspace_capability _file_ds;
 
 		enum {
@@ -70,54 +71,17 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 		 */
 		Genode::Ram_dataspace_capability _init_file_ds()
 		{
-			bool file_found = false;
-
-			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
-
-			/* scan metablocks of archive */
-			while (block_id < block_cnt) {
-
-				unsigned long file_size = 0;
-				Genode::ascii_to(_tar_addr + block_id*_BLOCK_LEN + _FIELD_SIZE_LEN,
-				                 &file_size, 8);
-
-				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
-
-				/* skip leading dot of path if present */
-				if (record_filename[0] == '.' && record_filename[1] == '/')
-					record_filename++;
-
-				/* get infos about current file */
-				if (Genode::strcmp(_filename, record_filename) == 0) {
-					_file_size = file_size;
-					_file_addr = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					file_found = true;
-					break;
-				}
-
-				/* some datablocks */       /* one metablock */
-				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
-
-				/* round up */
-				if (file_size % _BLOCK_LEN != 0) block_id++;
-
-				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
-					break;
-
-				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
-						break;
-			}
-
-			if (!file_found) {
+			if (!_record) {
 				PERR("couldn't find file '%s', empty result", _filename);
 				return Genode::Ram_dataspace_capability();
 			}
 
+			unsigned long file_size = 0;
+			Genode::ascii_to(_record + _FIELD_SIZE_LEN, &file_size, 8);
+
+			_file_size = file_size;
+			_file_addr = _record + _BLOCK_LEN;
+
 			/* try to allocate memory for file */
 			Genode::Ram_dataspace_capability file_ds;
 			try {
@@ -136,17 +100,15 @@ class Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
+		 * Constructor
 		 *
-		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
+		 * \param  record    tar record of the requested file, or 0 if the
+		 *                   file is not present in the archive
 		 * \param  filename  name of the requested file
 		 */
-		Rom_session_component(const char *tar_addr, unsigned tar_size,
-		                      const char *filename)
+		Rom_session_component(const char *record, const char *filename)
 		:
-			_tar_addr(tar_addr), _filename(filename), _file_addr(0), _file_size(0),
-			_tar_size(tar_size),
+			_record(record), _filename(filename), _file_addr(0), _file_size(0),
 			_file_ds(_init_file_ds())
 		{
 			if (!_file_ds.valid())
@@ -175,8 +137,56 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 {
 	private:
 
-		char    *_tar_addr;
-		unsigned _tar_size;
+		enum {
+			/* length of on data block in tar */
+			_BLOCK_LEN = 512,
+
+			/* length of the header field "file-size" in tar */
+			_FIELD_SIZE_LEN = 124
+		};
+
+		typedef Genode::Path_index<char const> Index;
+
+		/*
+		 * Index of all records of the archive by their path
+		 */
+		Index _index;
+
+		void _index_archive(char const *tar_addr, Genode::size_t tar_size)
+		{
+			/* measure size of archive in blocks */
+			unsigned block_id = 0, block_cnt = tar_size/_BLOCK_LEN;
+
+			/* scan metablocks of archive */
+			while (block_id < block_cnt) {
+
+				unsigned long file_size = 0;
+				Genode::ascii_to(tar_addr + block_id*_BLOCK_LEN + _FIELD_SIZE_LEN,
+				                 &file_size, 8);
+
+				/* get name of tar record */
+				char const *record = tar_addr + block_id*_BLOCK_LEN;
+
+				try { _index.insert(record, record); }
+				catch (Index::Path_too_long) {
+					PWRN("skipping tar record with too long path"); }
+
+				/* some datablocks */       /* one metablock */
+				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
+
+				/* round up */
+				if (file_size % _BLOCK_LEN != 0) block_id++;
+
+				/* check for end of tar archive */
+				if (block_id*_BLOCK_LEN >= tar_size)
+					break;
+
+				/* lookout for empty eof-blocks */
+				if (*(tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
+					if (*(tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
+						break;
+			}
+		}
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -186,8 +196,11 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 
 			PINF("connection for file '%s' requested\n", filename);
 
+			Index::Entry *entry = _index.lookup(filename);
+
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(_tar_addr, _tar_size, filename);
+			return new (md_alloc())
+				Rom_session_component(entry ? entry->value : 0, filename);
 		}
 
 	public:
@@ -205,8 +218,10 @@ class Rom_root : public Genode::Root_component<Rom_session_component>
 		         char *tar_addr, Genode::size_t tar_size)
 		:
 			Genode::Root_component<Rom_session_component>(entrypoint, md_alloc),
-			_tar_addr(tar_addr), _tar_size(tar_size)
-		{ }
+			_index(*Genode::env()->heap())
+		{
+			_index_archive(tar_addr, tar_size);
+		}
 };
 
 
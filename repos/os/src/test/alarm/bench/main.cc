@@ -0,0 +1,172 @@
+/*
+ * \brief  Scalability benchmark for the alarm scheduler
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The benchmark mimics the timers of a network stack. A number of alarms is
+ * scheduled with random deadlines, re-scheduled repeatedly, partly
+ * discarded, and finally dispatched. The costs per operation are reported
+ * for increasing numbers of alarms.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <os/alarm.h>
+#include <base/printf.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+enum {
+	MAX_ALARMS = 65536,
+	TIME_RANGE = 10000,    /* range of relative deadlines */
+	OPS        = 1 << 18,  /* number of operations per measurement */
+};
+
+
+class Bench_alarm : public Alarm
+{
+	private:
+
+		static Time _last;
+		static bool _in_order;
+
+		Time _scheduled;  /* deadline as passed to the scheduler */
+
+	public:
+
+		static unsigned long triggered;
+
+		static void reset(Time now) { _last = now; _in_order = true; triggered = 0; }
+
+		static bool in_order() { return _in_order; }
+
+		void schedule(Alarm_scheduler &scheduler, Time deadline)
+		{
+			_scheduled = deadline;
+			scheduler.schedule_absolute(this, deadline);
+		}
+
+	protected:
+
+		bool on_alarm(unsigned) override
+		{
+			if ((long)(_scheduled - _last) < 0)
+				_in_order = false;
+
+			_last = _scheduled;
+			triggered++;
+			return false;
+		}
+};
+
+
+Alarm::Time   Bench_alarm::_last;
+bool          Bench_alarm::_in_order;
+unsigned long Bench_alarm::triggered;
+
+
+static unsigned pseudo_random()
+{
+	static unsigned seed = 1;
+	seed = seed*1103515245 + 12345;
+	return seed >> 8;
+}
+
+
+/**
+ * Return nanoseconds per operation
+ */
+static unsigned long ns_per_op(unsigned long ms, unsigned long ops) {
+	return ops ? (unsigned long)((unsigned long long)ms*1000*1000 / ops) : 0; }
+
+
+/*
+ * The scheduler must outlive the alarms, which refer to it after being
+ * dispatched.
+ */
+static Alarm_scheduler scheduler;
+static Bench_alarm     alarms[MAX_ALARMS];
+
+
+static bool bench(unsigned num_alarms, Timer::Connection &timer)
+{
+	Alarm::Time now = 0;
+
+	unsigned const rounds = OPS / num_alarms ? OPS / num_alarms : 1;
+
+	/* schedule all alarms */
+	unsigned long start = timer.elapsed_ms();
+	for (unsigned i = 0; i < num_alarms; i++)
+		alarms[i].schedule(scheduler, now + 1 + pseudo_random() % TIME_RANGE);
+	unsigned long const schedule_ms = timer.elapsed_ms() - start;
+
+	/* re-schedule random alarms, like restarted retransmission timers */
+	start = timer.elapsed_ms();
+	for (unsigned long i = 0; i < (unsigned long)rounds*num_alarms; i++) {
+		Bench_alarm &a = alarms[pseudo_random() % num_alarms];
+		scheduler.discard(&a);
+		a.schedule(scheduler, now + 1 + pseudo_random() % TIME_RANGE);
+	}
+	unsigned long const reschedule_ms = timer.elapsed_ms() - start;
+
+	/* discard every fourth alarm */
+	start = timer.elapsed_ms();
+	for (unsigned i = 0; i < num_alarms; i += 4)
+		scheduler.discard(&alarms[i]);
+	unsigned long const discard_ms = timer.elapsed_ms() - start;
+
+	/* dispatch the remaining alarms */
+	Bench_alarm::reset(now);
+	start = timer.elapsed_ms();
+	for (now = 0; now <= TIME_RANGE + 1; now++)
+		scheduler.handle(now);
+	unsigned long const handle_ms = timer.elapsed_ms() - start;
+
+	unsigned const expected = num_alarms - (num_alarms + 3)/4;
+
+	printf("%6u alarms: schedule %5lu ns, re-schedule %5lu ns, "
+	       "discard %5lu ns, dispatch %5lu ns\n", num_alarms,
+	       ns_per_op(schedule_ms, num_alarms),
+	       ns_per_op(reschedule_ms, (unsigned long)rounds*num_alarms),
+	       ns_per_op(discard_ms, (num_alarms + 3)/4),
+	       ns_per_op(handle_ms, expected));
+
+	bool ok = true;
+	if (Bench_alarm::triggered != expected) {
+		PERR("%lu alarms triggered, expected %u", Bench_alarm::triggered, expected);
+		ok = false;
+	}
+	if (!Bench_alarm::in_order()) {
+		PERR("alarms triggered out of order");
+		ok = false;
+	}
+
+	return ok;
+}
+
+
+int main(int, char **)
+{
+	printf("--- alarm scheduler benchmark ---\n");
+
+	static Timer::Connection timer;
+
+	static unsigned const num_alarms[] = { 16, 256, 4096, 16384, 65536 };
+
+	bool ok = true;
+	for (unsigned i = 0; i < sizeof(num_alarms)/sizeof(num_alarms[0]); i++)
+		ok &= bench(num_alarms[i], timer);
+
+	if (!ok)
+		return -1;
+
+	printf("--- finished alarm scheduler benchmark ---\n");
+	return 0;
+}
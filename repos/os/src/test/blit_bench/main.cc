@@ -0,0 +1,199 @@
+/*
+ * \brief  Throughput benchmark for the blitting kernels
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * For each set of kernels supported by the CPU, the benchmark measures the
+ * throughput of copying, converting, and blending pixels in MPixel/s and
+ * checks that the results match those of the generic kernels.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/env.h>
+#include <base/printf.h>
+#include <blit/blit.h>
+#include <timer_session/connection.h>
+#include <util/string.h>
+
+using namespace Genode;
+
+
+enum {
+	W           = 1024,
+	H           = 768,
+	SMALL       = 64,     /* edge length of rectangle that stays in the cache */
+	DURATION_MS = 500,
+};
+
+
+struct Buffers
+{
+	uint32_t *rgba_src, *rgba_dst;
+	uint16_t *rgb565_src, *rgb565_dst;
+
+	template <typename T>
+	static T *alloc() { return (T *)env()->heap()->alloc(W*H*sizeof(T)); }
+
+	Buffers()
+	:
+		rgba_src(alloc<uint32_t>()), rgba_dst(alloc<uint32_t>()),
+		rgb565_src(alloc<uint16_t>()), rgb565_dst(alloc<uint16_t>())
+	{
+		/* pseudo-random pixels with all kinds of alpha values */
+		uint32_t v = 1;
+		for (unsigned i = 0; i < W*H; i++) {
+			v = v*1103515245 + 12345;
+			rgba_src[i]   = v;
+			rgba_dst[i]   = v ^ 0x5a5a5a5a;
+			rgb565_src[i] = v >> 16;
+			rgb565_dst[i] = v;
+		}
+	}
+};
+
+
+struct Op
+{
+	char const *name;
+	void (*fn)(Buffers &, int w, int h);
+	int w, h;
+};
+
+
+static void copy_16(Buffers &b, int w, int h) {
+	blit(b.rgb565_src, W*2, b.rgb565_dst, W*2, w*2, h); }
+
+
+static void copy_32(Buffers &b, int w, int h) {
+	blit(b.rgba_src, W*4, b.rgba_dst, W*4, w*4, h); }
+
+
+static void rgb565_to_rgba8888(Buffers &b, int w, int h) {
+	blit_convert(b.rgb565_src, W*2, BLIT_RGB565,
+	             b.rgba_dst, W*4, BLIT_RGBA8888, w, h); }
+
+
+static void rgba8888_to_rgb565(Buffers &b, int w, int h) {
+	blit_convert(b.rgba_src, W*4, BLIT_RGBA8888,
+	             b.rgb565_dst, W*2, BLIT_RGB565, w, h); }
+
+
+static void alpha_rgba8888(Buffers &b, int w, int h) {
+	blit_alpha(b.rgba_src, W*4, b.rgba_dst, W*4, BLIT_RGBA8888, w, h); }
+
+
+static void alpha_rgb565(Buffers &b, int w, int h) {
+	blit_alpha(b.rgba_src, W*4, b.rgb565_dst, W*2, BLIT_RGB565, w, h); }
+
+
+static Op const ops[] = {
+	{ "copy 16bpp small",  copy_16,            SMALL, SMALL },
+	{ "copy 16bpp",        copy_16,            W,     H     },
+	{ "copy 32bpp small",  copy_32,            SMALL, SMALL },
+	{ "copy 32bpp",        copy_32,            W,     H     },
+	{ "565 to 8888",       rgb565_to_rgba8888, W,     H     },
+	{ "8888 to 565",       rgba8888_to_rgb565, W,     H     },
+	{ "alpha onto 8888",   alpha_rgba8888,     W,     H     },
+	{ "alpha onto 565",    alpha_rgb565,       W,     H     },
+};
+
+
+/**
+ * Compare results of selected kernels with those of the generic kernels
+ *
+ * An odd width and destination offset exercise the handling of the
+ * unaligned head and the tail of each line.
+ */
+static bool check(Buffers &b, Blit_kernels kernels)
+{
+	enum { CW = 333, CH = 3, N = CH*W };
+	static uint32_t saved_rgba[N], ref_rgba[N];
+	static uint16_t saved_565[N],  ref_565[N];
+
+	Buffers shifted = b;
+	shifted.rgba_dst++;
+	shifted.rgb565_dst++;
+
+	bool ok = true;
+	for (unsigned i = 0; i < sizeof(ops)/sizeof(ops[0]); i++) {
+
+		memcpy(saved_rgba, b.rgba_dst, sizeof(saved_rgba));
+		memcpy(saved_565,  b.rgb565_dst, sizeof(saved_565));
+
+		blit_select_kernels(BLIT_KERNELS_GENERIC);
+		ops[i].fn(shifted, CW, CH);
+		memcpy(ref_rgba, b.rgba_dst, sizeof(ref_rgba));
+		memcpy(ref_565,  b.rgb565_dst, sizeof(ref_565));
+
+		memcpy(b.rgba_dst,   saved_rgba, sizeof(saved_rgba));
+		memcpy(b.rgb565_dst, saved_565,  sizeof(saved_565));
+
+		blit_select_kernels(kernels);
+		ops[i].fn(shifted, CW, CH);
+
+		if (memcmp(ref_rgba, b.rgba_dst, sizeof(ref_rgba))
+		 || memcmp(ref_565, b.rgb565_dst, sizeof(ref_565))) {
+			PERR("%s: result differs from generic kernels", ops[i].name);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+
+static void measure(Buffers &b, Op const &op, Timer::Connection &timer)
+{
+	unsigned long pixels = 0;
+	unsigned long const start = timer.elapsed_ms();
+	unsigned long elapsed = 0;
+
+	do {
+		for (unsigned i = 0; i < 8; i++)
+			op.fn(b, op.w, op.h);
+
+		pixels += 8UL*op.w*op.h;
+		elapsed = timer.elapsed_ms() - start;
+	} while (elapsed < DURATION_MS);
+
+	printf("  %-18s %6lu MPixel/s\n", op.name, pixels/(elapsed*1000));
+}
+
+
+int main(int, char **)
+{
+	printf("--- blit benchmark ---\n");
+
+	static Timer::Connection timer;
+	static Buffers buffers;
+
+	static Blit_kernels const kernels[] = {
+		BLIT_KERNELS_GENERIC, BLIT_KERNELS_SSE2,
+		BLIT_KERNELS_AVX2,    BLIT_KERNELS_NEON };
+
+	for (unsigned k = 0; k < sizeof(kernels)/sizeof(kernels[0]); k++) {
+
+		if (blit_select_kernels(kernels[k]) != 0)
+			continue;
+
+		char const *name = blit_kernels_name();
+
+		if (!check(buffers, kernels[k]))
+			PERR("%s kernels are broken", name);
+
+		printf("%s kernels:\n", name);
+		for (unsigned i = 0; i < sizeof(ops)/sizeof(ops[0]); i++)
+			measure(buffers, ops[i], timer);
+	}
+
+	blit_select_kernels(BLIT_KERNELS_AUTO);
+	printf("default kernels: %s\n", blit_kernels_name());
+
+	printf("--- finished blit benchmark ---\n");
+	return 0;
+}
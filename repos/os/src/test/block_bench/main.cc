@@ -142,13 +142,88 @@ void print_bench_head()
 	printf("----------------------------------------------\n");
 }
 
-int main(int argc, char **argv)
+
+/*
+ * Do a read bench keeping a specific number of requests in flight
+ *
+ * \param timer        timer for measurements
+ * \param queue_depth  number of requests kept in flight, also used as
+ *                     queue size of the block session
+ *
+ * Each run uses a dedicated block session because the queue size is
+ * determined at session-creation time.
+ */
+static void run_queue_depth_benchmark(Timer::Session &timer,
+                                      unsigned        queue_depth)
 {
-	using namespace Genode;
+	enum {
+		TX_BUF_SIZE  = 2 * 1024 * 1024,
+		REQUEST_SIZE = 4096,
+		NUM_REQUESTS = 16384
+	};
 
-	printf("AHCI bench\n");
-	printf("==========\n");
+	Genode::Allocator_avl        block_alloc(Genode::env()->heap());
+	Block::Connection            blk_con(&block_alloc, TX_BUF_SIZE, "",
+	                                     queue_depth);
+	Block::Session::Tx::Source & source = *blk_con.tx();
+
+	Genode::size_t             blk_size = 0;
+	Block::sector_t            blk_cnt  = 0;
+	Block::Session::Operations ops;
+	blk_con.info(&blk_cnt, &blk_size, &ops);
+
+	size_t const block_count = REQUEST_SIZE / blk_size;
+	if (!block_count || blk_cnt < block_count) {
+		PERR("block device too small for queue-depth bench");
+		return;
+	}
 
+	/* the server may have normalized or ignored the requested queue size */
+	unsigned const depth = min(queue_depth, source.submit_queue_size());
+
+	unsigned        submitted = 0;
+	unsigned        completed = 0;
+	Block::sector_t lba       = 0;
+
+	unsigned long const time_before_ms = timer.elapsed_ms();
+	while (completed < NUM_REQUESTS) {
+
+		/* top up the requests in flight */
+		while (submitted < NUM_REQUESTS && submitted - completed < depth) {
+			Block::Packet_descriptor p(source.alloc_packet(REQUEST_SIZE),
+			                           Block::Packet_descriptor::READ,
+			                           lba, block_count);
+			source.submit_packet(p);
+			submitted++;
+
+			lba += block_count;
+			if (lba + block_count > blk_cnt) lba = 0;
+		}
+
+		Block::Packet_descriptor p = source.get_acked_packet();
+		if (!p.succeeded()) {
+			PERR("could not access block %llu",
+			     (unsigned long long)p.block_number());
+			while (1) ;
+		}
+		source.release_packet(p);
+		completed++;
+	}
+	unsigned long const ms = max(timer.elapsed_ms() - time_before_ms, 1UL);
+
+	unsigned long const iops   = (NUM_REQUESTS * 1000UL) / ms;
+	unsigned long const kb_sec = ((unsigned long)NUM_REQUESTS * REQUEST_SIZE) / ms;
+	PLOG(" %5u  %8u  %8lu  %8lu  %8lu", depth, (unsigned)NUM_REQUESTS,
+	     ms, iops, kb_sec);
+}
+
+/*
+ * Do the read and write benches for all request sizes
+ *
+ * \param timer  timer for measurements
+ */
+static void run_request_size_benchmarks(Timer::Session &timer)
+{
 	enum { TX_BUF_SIZE   = 2 * 1024 * 1024 };
 
 	/* get block connection */
@@ -174,8 +249,6 @@ int main(int argc, char **argv)
 	for (unsigned o = 0; o < BUF_SIZE; o += sizeof(unsigned))
 		*(unsigned volatile *)((addr_t)buf + o) = 0x12345678;
 
-	static Timer::Connection timer;
-
 	long const request_sizes[] = {
 		1048576, 262144, 16384, 8192, 4096, 2048, 1024, 512, 0 };
 
@@ -205,6 +278,39 @@ int main(int argc, char **argv)
 	for (unsigned i = 0; request_sizes[i]; i++)
 		run_benchmark(timer, request_sizes[i], source, _blk_size, blk_cnt, buf, 1);
 
+	env()->heap()->free(buf, BUF_SIZE);
+}
+
+int main(int argc, char **argv)
+{
+	using namespace Genode;
+
+	printf("AHCI bench\n");
+	printf("==========\n");
+
+	static Timer::Connection timer;
+
+	/*
+	 * The block service may accept a single session only. Hence, each
+	 * bench opens and closes its own session.
+	 */
+	run_request_size_benchmarks(timer);
+
+	/*
+	 * Benchmark reading with different numbers of requests in flight
+	 */
+
+	printf("\n");
+	printf("queue depth\n");
+	printf("~~~~~~~~~~~\n");
+	printf("\n");
+	printf(" depth  requests        ms      IOPS    KB/sec\n");
+	printf("----------------------------------------------\n");
+
+	unsigned const queue_depths[] = { 1, 4, 16, 64, 256, 0 };
+	for (unsigned i = 0; queue_depths[i]; i++)
+		run_queue_depth_benchmark(timer, queue_depths[i]);
+
 	printf("\n");
 	printf("benchmark finished\n");
 	sleep_forever();
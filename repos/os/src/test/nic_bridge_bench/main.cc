@@ -0,0 +1,241 @@
+/*
+ * \brief  Forwarding benchmark for the NIC bridge
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The benchmark opens several sessions at the NIC bridge, which is connected
+ * to the NIC loop-back service. The first client sends unicast, broadcast,
+ * and multicast frames while all clients count the frames they receive.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <base/printf.h>
+#include <base/allocator_avl.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+#include <timer_session/connection.h>
+#include <util/string.h>
+
+using namespace Genode;
+
+
+enum {
+	BUF_SIZE    = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 128,
+	NUM_CLIENTS = 4,
+	FRAME_SIZE  = 128,
+	DURATION_MS = 2000,
+	ETHER_TYPE  = 0x88b5,  /* local experimental, ignored by the bridge */
+};
+
+
+struct Client
+{
+	Allocator_avl   tx_block_alloc;
+	Nic::Connection nic;
+	Signal_context  rx_ctx, ack_ctx;
+	unsigned long   rx_cnt;
+
+	Client(Signal_receiver &sig_rec)
+	:
+		tx_block_alloc(env()->heap()),
+		nic(&tx_block_alloc, BUF_SIZE, BUF_SIZE),
+		rx_cnt(0)
+	{
+		nic.rx_channel()->sigh_packet_avail(sig_rec.manage(&rx_ctx));
+		nic.tx_channel()->sigh_ack_avail(sig_rec.manage(&ack_ctx));
+	}
+
+	/**
+	 * Submit frame
+	 *
+	 * \return  false if the transmit buffer or queue is exhausted
+	 */
+	bool send(void const *frame, size_t size)
+	{
+		while (nic.tx()->ack_avail())
+			nic.tx()->release_packet(nic.tx()->get_acked_packet());
+
+		if (!nic.tx()->ready_to_submit())
+			return false;
+
+		try {
+			Packet_descriptor p = nic.tx()->alloc_packet(size);
+			memcpy(nic.tx()->packet_content(p), frame, size);
+			nic.tx()->submit_packet(p);
+			return true;
+		} catch (Nic::Session::Tx::Source::Packet_alloc_failed) {
+			return false;
+		}
+	}
+
+	/**
+	 * Acknowledge received frames
+	 *
+	 * \return  number of frames received
+	 */
+	unsigned poll()
+	{
+		unsigned n = 0;
+		while (nic.rx()->packet_avail() && nic.rx()->ready_to_ack()) {
+			nic.rx()->acknowledge_packet(nic.rx()->get_packet());
+			n++;
+		}
+		rx_cnt += n;
+		return n;
+	}
+};
+
+
+static uint16_t checksum(uint8_t const *data, size_t len)
+{
+	uint32_t sum = 0;
+	for (size_t i = 0; i + 1 < len; i += 2)
+		sum += (data[i] << 8) | data[i + 1];
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+	return ~sum;
+}
+
+
+static void put_be16(uint8_t *p, uint16_t v) { p[0] = v >> 8; p[1] = v; }
+
+
+static void ethernet_header(uint8_t *frame, void const *dst,
+                            void const *src, uint16_t type)
+{
+	memcpy(frame,     dst, 6);
+	memcpy(frame + 6, src, 6);
+	put_be16(frame + 12, type);
+}
+
+
+/**
+ * Send IGMPv2 membership report for the group 239.1.1.1
+ */
+static void join_group(Client &client, void const *group_mac)
+{
+	enum { IP_HLEN = 24, IGMP_LEN = 8 };
+
+	uint8_t frame[14 + IP_HLEN + IGMP_LEN];
+	memset(frame, 0, sizeof(frame));
+
+	ethernet_header(frame, group_mac, client.nic.mac_address().addr, 0x0800);
+
+	uint8_t *ip = frame + 14;
+	ip[0] = 0x40 | (IP_HLEN / 4);
+	put_be16(ip + 2, IP_HLEN + IGMP_LEN);
+	ip[8] = 1;     /* TTL */
+	ip[9] = 2;     /* IGMP */
+	ip[16] = 239; ip[17] = 1; ip[18] = 1; ip[19] = 1;
+	ip[20] = 0x94; ip[21] = 0x04;  /* router-alert option */
+	put_be16(ip + 10, checksum(ip, IP_HLEN));
+
+	uint8_t *igmp = ip + IP_HLEN;
+	igmp[0] = 0x16;  /* v2 membership report */
+	memcpy(igmp + 4, ip + 16, 4);
+	put_be16(igmp + 2, checksum(igmp, IGMP_LEN));
+
+	while (!client.send(frame, sizeof(frame)));
+}
+
+
+static void drain(Client *clients[], Timer::Connection &timer)
+{
+	for (unsigned idle = 0; idle < 10; ) {
+		unsigned n = 0;
+		for (unsigned i = 0; i < NUM_CLIENTS; i++)
+			n += clients[i]->poll();
+
+		if (n)
+			idle = 0;
+		else {
+			idle++;
+			timer.msleep(10);
+		}
+	}
+}
+
+
+/**
+ * Send frames to 'dst' from the first client for 'DURATION_MS'
+ */
+static void run(char const *name, void const *dst, Client *clients[],
+                Timer::Connection &timer, Signal_receiver &sig_rec)
+{
+	drain(clients, timer);
+	for (unsigned i = 0; i < NUM_CLIENTS; i++)
+		clients[i]->rx_cnt = 0;
+
+	uint8_t frame[FRAME_SIZE];
+	memset(frame, 0, sizeof(frame));
+	ethernet_header(frame, dst, clients[0]->nic.mac_address().addr, ETHER_TYPE);
+
+	unsigned long tx_cnt = 0;
+	unsigned long const start = timer.elapsed_ms();
+	unsigned long elapsed = 0;
+
+	while (elapsed < DURATION_MS) {
+
+		bool progress = false;
+
+		for (unsigned i = 0; i < 64 && clients[0]->send(frame, sizeof(frame)); i++) {
+			tx_cnt++;
+			progress = true;
+		}
+
+		for (unsigned i = 0; i < NUM_CLIENTS; i++)
+			if (clients[i]->poll())
+				progress = true;
+
+		if (!progress)
+			sig_rec.wait_for_signal();
+
+		elapsed = timer.elapsed_ms() - start;
+	}
+
+	drain(clients, timer);
+
+	printf("%-10s sent %lu frames (%lu/s), received:",
+	       name, tx_cnt, tx_cnt*1000/elapsed);
+	for (unsigned i = 0; i < NUM_CLIENTS; i++)
+		printf(" %lu", clients[i]->rx_cnt);
+	printf("\n");
+}
+
+
+int main(int, char **)
+{
+	printf("--- NIC bridge benchmark ---\n");
+
+	static Timer::Connection timer;
+	static Signal_receiver   sig_rec;
+
+	Client *clients[NUM_CLIENTS];
+	for (unsigned i = 0; i < NUM_CLIENTS; i++)
+		clients[i] = new (env()->heap()) Client(sig_rec);
+
+	static uint8_t const broadcast[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+	static uint8_t const group[]     = { 0x01, 0x00, 0x5e, 0x01, 0x01, 0x01 };
+
+	/* the second and third client join the group, the last one does not */
+	join_group(*clients[1], group);
+	join_group(*clients[2], group);
+
+	Nic::Mac_address const unicast = clients[1]->nic.mac_address();
+
+	run("unicast",   unicast.addr, clients, timer, sig_rec);
+	run("broadcast", broadcast, clients, timer, sig_rec);
+	run("multicast", group,     clients, timer, sig_rec);
+
+	if (clients[NUM_CLIENTS - 1]->rx_cnt)
+		PERR("multicast frames delivered to non-member");
+
+	printf("--- finished NIC bridge benchmark ---\n");
+	return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * \brief  Stress test and benchmark for the packet allocator
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test keeps a pool of live packets of mixed sizes, typical for network
+ * (64 and 1500 bytes) and bulk traffic (64 KiB), and randomly replaces
+ * packets of the pool. The same workload is applied to the
+ * 'Packet_allocator' and to an 'Allocator_avl' for reference.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/env.h>
+#include <base/allocator_avl.h>
+#include <os/packet_allocator.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+enum {
+	BLOCK_SIZE  = 64,
+	BUFFER_BASE = 0x100000,
+	BUFFER_SIZE = 8*1024*1024,
+	POOL_SIZE   = 256,
+	NUM_OPS     = 1000000,
+};
+
+
+/**
+ * Simple pseudo-random number generator, deterministic across runs
+ */
+struct Random
+{
+	unsigned long _state;
+
+	Random() : _state(0x12345678) { }
+
+	unsigned next()
+	{
+		_state = _state*1103515245 + 12345;
+		return (unsigned)(_state >> 16);
+	}
+};
+
+
+/**
+ * Return packet size picked from the mix of 64 B, 1500 B, and 64 KiB
+ */
+static size_t packet_size(Random &random)
+{
+	unsigned const r = random.next() % 100;
+
+	if (r < 60) return 64;
+	if (r < 95) return 1500;
+	return 64*1024;
+}
+
+
+struct Packet
+{
+	void  *addr;
+	size_t size;
+
+	Packet() : addr(0), size(0) { }
+};
+
+
+/**
+ * Apply the workload to 'alloc'
+ *
+ * \return number of failed allocations
+ */
+static unsigned stress(Range_allocator &alloc, Packet *pool)
+{
+	Random   random;
+	unsigned failed = 0;
+
+	for (unsigned i = 0; i < POOL_SIZE; i++)
+		pool[i] = Packet();
+
+	for (unsigned i = 0; i < NUM_OPS; i++) {
+
+		Packet &p = pool[random.next() % POOL_SIZE];
+
+		if (p.addr) {
+			alloc.free(p.addr, p.size);
+			p = Packet();
+		}
+
+		size_t const size = packet_size(random);
+		void *addr = 0;
+		if (!alloc.alloc(size, &addr)) {
+			failed++;
+			continue;
+		}
+
+		/* check that the packet lies within the buffer */
+		if ((addr_t)addr < BUFFER_BASE
+		 || (addr_t)addr + size > BUFFER_BASE + BUFFER_SIZE) {
+			PERR("packet [%p,+0x%zx) outside of buffer", addr, size);
+			throw -1;
+		}
+
+		p.addr = addr;
+		p.size = size;
+	}
+
+	for (unsigned i = 0; i < POOL_SIZE; i++)
+		if (pool[i].addr)
+			alloc.free(pool[i].addr, pool[i].size);
+
+	return failed;
+}
+
+
+static void bench(char const *name, Range_allocator &alloc, Packet *pool,
+                  Timer::Session &timer)
+{
+	unsigned long const start_ms = timer.elapsed_ms();
+	unsigned      const failed   = stress(alloc, pool);
+	unsigned long const ms       = timer.elapsed_ms() - start_ms;
+
+	printf("%-16s %u ops in %lu ms -> %lu ops/ms, %u failed\n",
+	       name, (unsigned)NUM_OPS, ms, ms ? NUM_OPS/ms : 0UL, failed);
+}
+
+
+int main(int, char **)
+{
+	printf("--- packet-allocator test ---\n");
+
+	static Timer::Connection timer;
+	static Packet pool[POOL_SIZE];
+
+	{
+		Packet_allocator alloc(env()->heap(), BLOCK_SIZE);
+		alloc.add_range(BUFFER_BASE, BUFFER_SIZE);
+
+		size_t const avail = alloc.avail();
+		bench("Packet_allocator", alloc, pool, timer);
+
+		/* after freeing all packets, all blocks must be merged again */
+		void *addr = 0;
+		if (alloc.avail() != avail || !alloc.alloc(BUFFER_SIZE, &addr)) {
+			PERR("free blocks not merged, avail %zd of %zd",
+			     alloc.avail(), avail);
+			return -1;
+		}
+		alloc.free(addr, BUFFER_SIZE);
+
+		/* double free must be detected */
+		bool detected = false;
+		alloc.alloc(BLOCK_SIZE, &addr);
+		alloc.free(addr, BLOCK_SIZE);
+		try { alloc.free(addr, BLOCK_SIZE); }
+		catch (Bit_array_base::Invalid_clear) { detected = true; }
+		if (!detected) {
+			PERR("double free not detected");
+			return -1;
+		}
+
+		/* a size beyond the range of 'unsigned' blocks must not wrap */
+		if (sizeof(size_t) > sizeof(unsigned)
+		 && alloc.alloc(((size_t)~0U + 2)*BLOCK_SIZE, &addr)) {
+			PERR("oversized packet allocated");
+			return -1;
+		}
+
+		alloc.remove_range(BUFFER_BASE, BUFFER_SIZE);
+
+		if (alloc.avail() || alloc.alloc(BLOCK_SIZE, &addr)) {
+			PERR("blocks still available after removing the range");
+			return -1;
+		}
+	}
+
+	{
+		Allocator_avl alloc(env()->heap());
+		alloc.add_range(BUFFER_BASE, BUFFER_SIZE);
+		bench("Allocator_avl", alloc, pool, timer);
+	}
+
+	printf("--- end of packet-allocator test ---\n");
+	return 0;
+}
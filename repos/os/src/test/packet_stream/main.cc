@@ -297,6 +297,161 @@ void test_2_flood_submit(Timer::Session *timer, Source *source, Sink *sink)
 }
 
 
+/**
+ * Throughput benchmark
+ *
+ * A source thread streams 'NUM_PACKETS' packets to a sink thread, which
+ * acknowledges them. Both sides exchange the packets in batches of up to
+ * 'batch' packets. A batch size of one exercises the single-packet
+ * functions.
+ */
+namespace Bench {
+
+	typedef Default_packet_stream_policy Policy;
+
+	enum {
+		NUM_PACKETS = 200000,
+		PACKET_SIZE = 64,
+		MAX_BATCH   = 64,
+		MAX_FLIGHT  = 64,  /* number of submit-queue entries */
+		STACK_SIZE  = 4*4096
+	};
+
+	class Source;
+	class Sink;
+}
+
+
+class Bench::Source : public  Genode::Thread<STACK_SIZE>,
+                      private Genode::Allocator_avl,
+                      public  Packet_stream_source<Policy>
+{
+	private:
+
+		unsigned const _batch;
+
+	public:
+
+		Source(Genode::Dataspace_capability ds_cap, unsigned batch)
+		:
+			Thread("bench_source"),
+			Genode::Allocator_avl(Genode::env()->heap()),
+			Packet_stream_source<Policy>(this, ds_cap),
+			_batch(batch)
+		{ }
+
+		void entry()
+		{
+			Packet_descriptor packets[MAX_BATCH];
+
+			unsigned submitted = 0, acked = 0;
+			while (acked < NUM_PACKETS) {
+
+				unsigned const in_flight = submitted - acked;
+				unsigned num = Genode::min(_batch,
+				               Genode::min((unsigned)NUM_PACKETS - submitted,
+				                           (unsigned)MAX_FLIGHT - in_flight));
+
+				for (unsigned i = 0; i < num; i++)
+					packets[i] = alloc_packet(PACKET_SIZE);
+
+				if (_batch == 1 && num)
+					submit_packet(packets[0]);
+				else if (num)
+					submit_packets(packets, num);
+
+				submitted += num;
+
+				/* collect acknowledgements, block if nothing was submitted */
+				if (num && !ack_avail())
+					continue;
+
+				unsigned num_acked = 1;
+				if (_batch == 1)
+					packets[0] = get_acked_packet();
+				else
+					num_acked = get_acked_packets(packets, _batch);
+
+				for (unsigned i = 0; i < num_acked; i++)
+					release_packet(packets[i]);
+
+				acked += num_acked;
+			}
+		}
+};
+
+
+class Bench::Sink : public Genode::Thread<STACK_SIZE>,
+                    public Packet_stream_sink<Policy>
+{
+	private:
+
+		unsigned const _batch;
+
+	public:
+
+		Sink(Genode::Dataspace_capability ds_cap, unsigned batch)
+		:
+			Thread("bench_sink"),
+			Packet_stream_sink<Policy>(ds_cap),
+			_batch(batch)
+		{ }
+
+		void entry()
+		{
+			Packet_descriptor packets[MAX_BATCH];
+
+			for (unsigned processed = 0; processed < NUM_PACKETS; ) {
+
+				if (_batch == 1) {
+					packets[0] = get_packet();
+					acknowledge_packet(packets[0]);
+					processed++;
+					continue;
+				}
+
+				unsigned const num = get_packets(packets, _batch);
+				acknowledge_packets(packets, num);
+				processed += num;
+			}
+		}
+};
+
+
+void test_3_throughput(Timer::Session *timer, unsigned batch)
+{
+	using namespace Genode;
+
+	enum { TRANSPORT_DS_SIZE = 64*1024 };
+	Ram_dataspace_capability ds_cap = env()->ram_session()->alloc(TRANSPORT_DS_SIZE);
+
+	{
+		Bench::Source source(ds_cap, batch);
+		Bench::Sink   sink(ds_cap, batch);
+
+		source.register_sigh_packet_avail(sink.sigh_packet_avail());
+		source.register_sigh_ready_to_ack(sink.sigh_ready_to_ack());
+		sink.register_sigh_ready_to_submit(source.sigh_ready_to_submit());
+		sink.register_sigh_ack_avail(source.sigh_ack_avail());
+
+		unsigned long const start_ms = timer->elapsed_ms();
+
+		sink.start();
+		source.start();
+		source.join();
+		sink.join();
+
+		unsigned long const duration_ms = timer->elapsed_ms() - start_ms;
+
+		printf("batch size %2u: %u packets in %lu ms -> %lu packets/s\n",
+		       batch, (unsigned)Bench::NUM_PACKETS, duration_ms,
+		       duration_ms ? (Bench::NUM_PACKETS*1000UL)/duration_ms : 0UL);
+	}
+
+	env()->ram_session()->free(ds_cap);
+}
+
+
 using namespace Genode;
 
 int main(int, char **)
@@ -328,6 +483,10 @@ int main(int, char **)
 	printf("waiting to settle down\n");
 	timer.msleep(2*1000);
 
+	printf("\n-- test 3: throughput with single and batched operations --\n");
+	for (unsigned batch = 1; batch <= Bench::MAX_BATCH; batch *= 4)
+		test_3_throughput(&timer, batch);
+
 	printf("--- end of packet stream test ---\n");
 	return 0;
 }
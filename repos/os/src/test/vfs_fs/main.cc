@@ -0,0 +1,196 @@
+/*
+ * \brief  Test for the read-ahead and write-behind of the VFS fs file system
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+/* Genode includes */
+#include <base/printf.h>
+#include <base/thread.h>
+#include <vfs/file_system.h>
+#include <vfs/vfs_handle.h>
+#include <vfs/fs_file_system.h>
+
+using namespace Genode;
+
+typedef Vfs::Directory_service Ds;
+typedef Vfs::File_io_service   Io;
+
+
+static char pattern(size_t offset, unsigned seed) {
+	return (char)(offset*7 + seed); }
+
+
+static Vfs::Vfs_handle *open(Vfs::File_system &fs, char const *path, unsigned mode)
+{
+	Vfs::Vfs_handle *handle = 0;
+	if (fs.open(path, mode, &handle) != Ds::OPEN_OK) {
+		PERR("could not open %s", path);
+		return 0;
+	}
+	return handle;
+}
+
+
+/**
+ * Write 'size' bytes of the pattern to the file, return true on success
+ */
+static bool write_file(Vfs::Vfs_handle &handle, size_t size, unsigned seed)
+{
+	enum { CHUNK = 4096 };
+	static char buf[CHUNK];
+
+	for (size_t offset = 0; offset < size; ) {
+
+		for (size_t i = 0; i < CHUNK; i++)
+			buf[i] = pattern(offset + i, seed);
+
+		size_t count = 0;
+		if (handle.fs().write(&handle, buf, min((size_t)CHUNK, size - offset),
+		                      count) != Io::WRITE_OK || !count)
+			return false;
+
+		handle.advance_seek(count);
+		offset += count;
+	}
+	return true;
+}
+
+
+/**
+ * Read the file and compare it with the pattern, return true on success
+ */
+static bool check_file(Vfs::Vfs_handle &handle, size_t size, unsigned seed)
+{
+	/* deliberately not aligned to the read-ahead packets */
+	enum { CHUNK = 3000 };
+	char buf[CHUNK];
+
+	for (size_t offset = 0; offset < size; ) {
+
+		size_t count = 0;
+		if (handle.fs().read(&handle, buf, CHUNK, count) != Io::READ_OK || !count)
+			return false;
+
+		for (size_t i = 0; i < count; i++)
+			if (buf[i] != pattern(offset + i, seed)) {
+				PERR("unexpected content at offset %zu", offset + i);
+				return false;
+			}
+
+		handle.advance_seek(count);
+		offset += count;
+	}
+	return true;
+}
+
+
+struct Reader : Thread<8192>
+{
+	Vfs::Vfs_handle &handle;
+	size_t    const  size;
+	bool             ok;
+
+	Reader(Vfs::Vfs_handle &handle, size_t size)
+	: Thread<8192>("reader"), handle(handle), size(size), ok(false) { start(); }
+
+	void entry() { ok = check_file(handle, size, 1); }
+};
+
+
+int main(int, char **)
+{
+	printf("--- test-vfs_fs started ---\n");
+
+	static Vfs::Fs_file_system fs(Xml_node("<fs/>"));
+
+	enum { SIZE = 256*1024, RW = Ds::OPEN_MODE_CREATE | Ds::OPEN_MODE_RDWR };
+
+	/* write more data than fits into the bulk buffer at once */
+	Vfs::Vfs_handle *data = open(fs, "/data", RW);
+	if (!data || !write_file(*data, SIZE, 1)) {
+		PERR("writing /data failed");
+		return -1;
+	}
+
+	fs.sync();
+
+	Vfs::Directory_service::Stat stat;
+	if (fs.stat("/data", stat) != Ds::STAT_OK || stat.size != SIZE) {
+		PERR("unexpected size of /data");
+		return -1;
+	}
+	printf("write-behind of /data completed\n");
+
+	/* read one file while writing another one from a second thread */
+	Vfs::Vfs_handle *read_handle = open(fs, "/data", Ds::OPEN_MODE_RDONLY);
+	Vfs::Vfs_handle *other       = open(fs, "/other", RW);
+	if (!read_handle || !other)
+		return -1;
+
+	{
+		Reader reader(*read_handle, SIZE);
+
+		if (!write_file(*other, SIZE, 2)) {
+			PERR("writing /other failed");
+			return -1;
+		}
+
+		reader.join();
+
+		if (!reader.ok) {
+			PERR("reading /data concurrently failed");
+			return -1;
+		}
+	}
+
+	other->seek(0);
+	if (!check_file(*other, SIZE, 2)) {
+		PERR("reading /other failed");
+		return -1;
+	}
+	printf("concurrent read-ahead and write-behind completed\n");
+
+	/*
+	 * Provoke a write error beyond the maximum file size of ram_fs. The
+	 * write is acknowledged as failed after it was accepted. So the
+	 * error must be reported by the next write.
+	 */
+	char buf[4096];
+	memset(buf, 0, sizeof(buf));
+
+	size_t count = 0;
+	data->seek(0x7ffff000);
+	if (fs.write(data, buf, sizeof(buf), count) != Io::WRITE_OK) {
+		PERR("write-behind was not accepted");
+		return -1;
+	}
+
+	fs.sync();
+
+	data->seek(0);
+	if (fs.write(data, buf, sizeof(buf), count) != Io::WRITE_ERR_IO) {
+		PERR("failed write-behind was not reported");
+		return -1;
+	}
+
+	if (fs.write(data, buf, sizeof(buf), count) != Io::WRITE_OK) {
+		PERR("write after reported error failed");
+		return -1;
+	}
+	printf("failed write-behind reported\n");
+
+	destroy(env()->heap(), read_handle);
+	destroy(env()->heap(), other);
+	destroy(env()->heap(), data);
+
+	printf("--- test-vfs_fs finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-vfs_fs
+SRC_CC = main.cc
+LIBS   = base
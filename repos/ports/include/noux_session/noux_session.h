@@ -85,6 +85,7 @@ namespace Noux {
 			SYSCALL_UTIMES,
 			SYSCALL_SYNC,
 			SYSCALL_KILL,
+			SYSCALL_SPLICE,
 			SYSCALL_INVALID = -1
 		};
 
@@ -134,6 +135,7 @@ namespace Noux {
 			NOUX_DECL_SYSCALL_NAME(UTIMES)
 			NOUX_DECL_SYSCALL_NAME(SYNC)
 			NOUX_DECL_SYSCALL_NAME(KILL)
+			NOUX_DECL_SYSCALL_NAME(SPLICE)
 			case SYSCALL_INVALID: return 0;
 			}
 			return 0;
@@ -51,6 +51,14 @@ namespace Noux {
 		enum { CHUNK_SIZE = 7*1024 };
 		typedef char Chunk[CHUNK_SIZE];
 
+		/*
+		 * The payload of 'read' and 'write' syscalls that exceed the chunk
+		 * is passed via the I/O window, which follows the 'Sysio' structure
+		 * within the sysio dataspace. Hence, noux and the process must
+		 * attach the whole dataspace.
+		 */
+		enum { IO_WINDOW_SIZE = 512*1024 };
+
 		enum { ARGS_MAX_LEN = 4*1024 };
 		typedef char Args[ARGS_MAX_LEN];
 
@@ -268,6 +276,8 @@ namespace Noux {
 		enum Fcntl_error     { FCNTL_ERR_CMD_INVALID = Vfs::Directory_service::NUM_GENERAL_ERRORS };
 		enum Execve_error    { EXECVE_NONEXISTENT    = Vfs::Directory_service::NUM_GENERAL_ERRORS };
 		enum Select_error    { SELECT_ERR_INTERRUPT };
+		enum Splice_error    { SPLICE_ERR_INTERRUPT  = Vfs::Directory_service::NUM_GENERAL_ERRORS,
+		                       SPLICE_ERR_IO, SPLICE_ERR_AGAIN };
 
 		/**
 		 * Socket related errors
@@ -339,6 +349,7 @@ namespace Noux {
 			Utimes_error   utimes;
 			Wait4_error    wait4;
 			Kill_error     kill;
+			Splice_error   splice;
 
 		} error;
 
@@ -455,7 +466,67 @@ namespace Noux {
 			SYSIO_DECL(sync,        { }, { });
 
 			SYSIO_DECL(kill,        { int pid; Signal sig; }, { });
+
+			SYSIO_DECL(splice,      { int fd_in; int fd_out; size_t count; },
+			                        { size_t count; });
 		};
+
+		/**
+		 * Return offset of I/O window within the sysio dataspace
+		 */
+		static size_t io_window_offset() {
+			return (sizeof(Sysio) + 0xfff) & ~(size_t)0xfff; }
+
+		/**
+		 * Return size of the sysio dataspace including the I/O window
+		 */
+		static size_t dataspace_size() {
+			return io_window_offset() + IO_WINDOW_SIZE; }
+
+		char *io_window() { return (char *)this + io_window_offset(); }
+
+		/**
+		 * Return true if the payload of 'count' bytes is passed via
+		 * the I/O window
+		 */
+		static bool uses_io_window(size_t count) { return count > CHUNK_SIZE; }
+
+		/**
+		 * Return number of bytes to be written by 'write' syscall
+		 */
+		size_t write_count() const
+		{
+			return min(write_in.count, uses_io_window(write_in.count)
+			                           ? (size_t)IO_WINDOW_SIZE
+			                           : (size_t)CHUNK_SIZE);
+		}
+
+		/**
+		 * Return source buffer of 'write' syscall
+		 */
+		char const *write_data()
+		{
+			return uses_io_window(write_in.count) ? io_window() : write_in.chunk;
+		}
+
+		/**
+		 * Return destination buffer of 'read' syscall
+		 *
+		 * \param max_count  maximum number of bytes to read
+		 *
+		 * Must be called before assigning 'read_out' because 'read_in' and
+		 * 'read_out' share the same memory.
+		 */
+		char *read_buffer(size_t &max_count)
+		{
+			if (uses_io_window(read_in.count)) {
+				max_count = min(read_in.count, (size_t)IO_WINDOW_SIZE);
+				return io_window();
+			}
+
+			max_count = min(read_in.count, sizeof(read_out.chunk));
+			return read_out.chunk;
+		}
 	};
 };
 
@@ -93,7 +93,8 @@ namespace Gdb_monitor {
 			 **************************************/
 
 			Local_addr       attach        (Dataspace_capability, Genode::size_t,
-			                                Genode::off_t, bool, Local_addr, bool);
+			                                Genode::off_t, bool, Local_addr, bool,
+			                                bool);
 			void             detach        (Local_addr);
 			Pager_capability add_client    (Thread_capability);
 			void             remove_client (Pager_capability);
@@ -44,6 +44,7 @@
 #include <pwd.h>
 #include <string.h>
 #include <signal.h>
+#include <splice.h>
 
 /**
  * There is a off_t typedef clash between sys/socket.h
@@ -133,7 +134,10 @@ static struct sigaction signal_action[NSIG+1];
 static sigset_t signal_mask;
 
 
-static bool noux_syscall(Noux::Session::Syscall opcode)
+/**
+ * Call signal handlers for the signals delivered with the last syscall
+ */
+static void handle_pending_signals()
 {
 	/*
 	 * Signal handlers might do syscalls themselves, so the 'sysio' object
@@ -141,8 +145,6 @@ static bool noux_syscall(Noux::Session::Syscall opcode)
 	 */
 	Noux::Sysio saved_sysio;
 
-	bool ret = noux()->syscall(opcode);
-
 	/* handle signals */
 	while (!sysio()->pending_signals.empty()) {
 		Noux::Sysio::Signal signal = sysio()->pending_signals.get();
@@ -172,6 +174,14 @@ static bool noux_syscall(Noux::Session::Syscall opcode)
 			}
 		}
 	}
+}
+
+
+static bool noux_syscall(Noux::Session::Syscall opcode)
+{
+	bool ret = noux()->syscall(opcode);
+
+	handle_pending_signals();
 
 	return ret;
 }
@@ -652,6 +662,49 @@ extern "C" int kill(int pid, int sig)
 }
 
 
+/**
+ * Move data between two file descriptors without copying it to the process
+ *
+ * The interface resembles the Linux 'splice' function. File offsets are not
+ * supported, i.e., 'off_in' and 'off_out' must be 0 and the data is
+ * transferred at the current seek positions. A single call transfers at most
+ * the size of the sysio I/O window.
+ *
+ * \return number of transferred bytes, 0 at the end of the input
+ *
+ * The prototype is declared in 'splice.h'.
+ */
+extern "C" ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out,
+                          size_t len, unsigned int flags)
+{
+	if (off_in || off_out) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sysio()->splice_in.fd_in  = fd_in;
+	sysio()->splice_in.fd_out = fd_out;
+	sysio()->splice_in.count  = Genode::min(len, (size_t)Noux::Sysio::IO_WINDOW_SIZE);
+
+	if (!noux_syscall(Noux::Session::SYSCALL_SPLICE)) {
+		switch (sysio()->error.splice) {
+		case Noux::Sysio::SPLICE_ERR_INTERRUPT: errno = EINTR; break;
+		case Noux::Sysio::SPLICE_ERR_IO:        errno = EIO;   break;
+		case Noux::Sysio::SPLICE_ERR_AGAIN:     errno = EAGAIN; break;
+		default:
+			if (sysio()->error.general == Vfs::Directory_service::ERR_FD_INVALID)
+				errno = EBADF;
+			else
+				errno = 0;
+			break;
+		}
+		return -1;
+	}
+
+	return sysio()->splice_out.count;
+}
+
+
 /********************
  ** Time functions **
  ********************/
@@ -1089,11 +1142,13 @@ namespace {
 		char *src = (char *)buf;
 		while (count > 0) {
 
-			Genode::size_t curr_count = Genode::min((::size_t)Noux::Sysio::CHUNK_SIZE, count);
+			/* pass large payloads via the I/O window */
+			Genode::size_t curr_count =
+				Genode::min(count, (::size_t)Noux::Sysio::IO_WINDOW_SIZE);
 
 			sysio()->write_in.fd = noux_fd(fd->context);
 			sysio()->write_in.count = curr_count;
-			Genode::memcpy(sysio()->write_in.chunk, src, curr_count);
+			Genode::memcpy((char *)sysio()->write_data(), src, curr_count);
 
 			if (!noux_syscall(Noux::Session::SYSCALL_WRITE)) {
 				switch (sysio()->error.write) {
@@ -1124,13 +1179,23 @@ namespace {
 
 		while (count > 0) {
 
+			/* receive large payloads via the I/O window */
 			Genode::size_t curr_count =
-				Genode::min(count, sizeof(sysio()->read_out.chunk));
+				Genode::min(count, (::size_t)Noux::Sysio::IO_WINDOW_SIZE);
 
 			sysio()->read_in.fd    = noux_fd(fd->context);
 			sysio()->read_in.count = curr_count;
 
-			if (!noux_syscall(Noux::Session::SYSCALL_READ)) {
+			Genode::size_t max_count = 0;
+			char const    *src       = sysio()->read_buffer(max_count);
+
+			/*
+			 * Signal handlers are called after copying the data because
+			 * they may use the I/O window themselves.
+			 */
+			if (!noux()->syscall(Noux::Session::SYSCALL_READ)) {
+
+				handle_pending_signals();
 
 				switch (sysio()->error.read) {
 				case Vfs::File_io_service::READ_ERR_AGAIN:       errno = EAGAIN;      break;
@@ -1148,19 +1213,19 @@ namespace {
 				return -1;
 			}
 
-			Genode::memcpy((char*)buf + sum_read_count,
-			               sysio()->read_out.chunk,
-			               sysio()->read_out.count);
+			Genode::size_t const read_count =
+				Genode::min((::size_t)sysio()->read_out.count, max_count);
+
+			Genode::memcpy((char*)buf + sum_read_count, src, read_count);
 
-			sum_read_count += sysio()->read_out.count;
+			handle_pending_signals();
 
-			if (sysio()->read_out.count < curr_count)
+			sum_read_count += read_count;
+
+			if (read_count < curr_count)
 				break; /* end of file */
 
-			if (sysio()->read_out.count <= count)
-				count -= sysio()->read_out.count;
-			else
-				break; /* should not happen */
+			count -= read_count;
 		}
 
 		return sum_read_count;
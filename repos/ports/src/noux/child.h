@@ -35,6 +35,7 @@
 #include <interrupt_handler.h>
 #include <kill_broadcaster.h>
 #include <parent_execve.h>
+#include <pipe_io_channel.h>
 
 #include <local_cpu_service.h>
 #include <local_ram_service.h>
@@ -198,8 +199,10 @@ namespace Noux {
 				~Elf() { _root_dir->release(_name, _binary_ds); }
 			} _elf;
 
-			enum { PAGE_SIZE = 4096, PAGE_MASK = ~(PAGE_SIZE - 1) };
-			enum { SYSIO_DS_SIZE = PAGE_MASK & (sizeof(Sysio) + PAGE_SIZE - 1) };
+			/**
+			 * Budget for the buffers of the pipes created by the process
+			 */
+			Shared_pointer<Pipe_buffer_quota> _pipe_buffer_quota;
 
 			Attached_ram_dataspace _sysio_ds;
 			Sysio * const          _sysio;
@@ -263,8 +266,15 @@ namespace Noux {
 			 * \param wr  check for readiness for writing
 			 * \param ex  check for exceptions
 			 */
+			/**
+			 * Block until the I/O channel is ready
+			 *
+			 * \param interruptible  if true, return early when a signal is
+			 *                       pending for the process
+			 */
 			void _block_for_io_channel(Shared_pointer<Io_channel> &io,
-			                           bool rd, bool wr, bool ex)
+			                           bool rd, bool wr, bool ex,
+			                           bool interruptible = true)
 			{
 				/* reset the blocker lock to the 'locked' state */
 				_blocker.unlock();
@@ -275,7 +285,7 @@ namespace Noux {
 
 				for (;;) {
 					if (io->check_unblock(rd, wr, ex) ||
-					    !_pending_signals.empty())
+					    (interruptible && !_pending_signals.empty()))
 						break;
 
 					/* block (unless the lock got unlocked in the meantime) */
@@ -293,6 +303,23 @@ namespace Noux {
 
 			bool _syscall_net(Syscall sc);
 
+			/**
+			 * Perform read operation as specified by 'sysio->read_in'
+			 */
+			bool _read();
+
+			/**
+			 * Perform write operation as specified by 'sysio->write_in'
+			 *
+			 * \param fd     file descriptor, passed separately because
+			 *               'write_in.fd' is overwritten by 'write_out.count'
+			 * \param count  number of bytes actually written
+			 * \param all    if true, block until all bytes are written,
+			 *               regardless of pending signals and non-blocking
+			 *               mode, unless an I/O error occurs
+			 */
+			bool _write(int fd, size_t &count, bool all = false);
+
 		public:
 
 			struct Binary_does_not_exist : Exception { };
@@ -342,7 +369,9 @@ namespace Noux {
 				_args(ARGS_DS_SIZE, args),
 				_env(env),
 				_elf(binary_name, root_dir, root_dir->dataspace(binary_name)),
-				_sysio_ds(Genode::env()->ram_session(), SYSIO_DS_SIZE),
+				_pipe_buffer_quota(new (Genode::env()->heap()) Pipe_buffer_quota,
+				                   Genode::env()->heap()),
+				_sysio_ds(Genode::env()->ram_session(), Sysio::dataspace_size()),
 				_sysio(_sysio_ds.local_addr<Sysio>()),
 				_noux_session_cap(Session_capability(_entrypoint.manage(this))),
 				_local_noux_service(_noux_session_cap),
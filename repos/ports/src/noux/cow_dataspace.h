@@ -0,0 +1,560 @@
+/*
+ * \brief  Copy-on-write dataspaces shared by forked Noux processes
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * When forking a process, large RAM dataspaces are not copied. Instead, the
+ * parent and the child obtain managed dataspaces (views) that refer to the
+ * same backing store, attached read-only. A write access to a shared chunk
+ * of a view is reflected as RM fault, which is resolved by copying the
+ * chunk into a private RAM dataspace that is attached writeable in place of
+ * the shared chunk. If a chunk is not shared anymore, it is attached
+ * writeable without copying.
+ *
+ * Read-only chunks that are adjacent within the same backing store are
+ * attached as one region. A write fault splits only the region that
+ * contains the faulting chunk. So forking costs RM operations for the
+ * chunks written since the previous fork rather than for all chunks.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _NOUX__COW_DATASPACE_H_
+#define _NOUX__COW_DATASPACE_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <rm_session/connection.h>
+#include <util/misc_math.h>
+
+namespace Noux {
+
+	class Cow_backing;
+	class Cow_dataspace;
+	class Cow_fault_handler;
+
+	inline Cow_fault_handler &cow_fault_handler();
+
+	inline bool cow_supported();
+}
+
+
+/**
+ * RAM dataspace that backs the chunks of copy-on-write dataspaces
+ *
+ * Each chunk has a reference counter. In addition, the backing store as a
+ * whole may be held by the owner of the RAM dataspace. The RAM dataspace is
+ * freed once neither a chunk is referenced nor the backing store is held.
+ */
+class Noux::Cow_backing
+{
+	public:
+
+		enum { CHUNK_SIZE = 16*1024 };
+
+	private:
+
+		Lock                           _lock;
+		Ram_dataspace_capability const _ds;
+		size_t                   const _size;
+		unsigned                 const _num_chunks;
+		unsigned                      *_refs;
+		unsigned long                  _total;
+
+		/**
+		 * Drop one reference, destroy backing store if it was the last one
+		 */
+		static void _drop(Cow_backing *backing)
+		{
+			bool last = false;
+			{
+				Lock::Guard guard(backing->_lock);
+				last = (--backing->_total == 0);
+			}
+			if (last)
+				destroy(env()->heap(), backing);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param ds    RAM dataspace, ownership is transferred to the
+		 *              backing store
+		 * \param size  size of the dataspace
+		 *
+		 * The backing store is initially held by the caller.
+		 */
+		Cow_backing(Ram_dataspace_capability ds, size_t size)
+		:
+			_ds(ds), _size(size),
+			_num_chunks((size + CHUNK_SIZE - 1) / CHUNK_SIZE),
+			_refs(0), _total(1)
+		{
+			if (!env()->heap()->alloc(_num_chunks*sizeof(unsigned), &_refs))
+				throw Allocator::Out_of_memory();
+
+			memset(_refs, 0, _num_chunks*sizeof(unsigned));
+		}
+
+		/**
+		 * Destructor, called once the last reference is dropped
+		 */
+		~Cow_backing()
+		{
+			env()->heap()->free(_refs, _num_chunks*sizeof(unsigned));
+			env()->ram_session()->free(_ds);
+		}
+
+		/**
+		 * Create backing store with a copy of the chunk of another one
+		 *
+		 * The new backing store consists of a single chunk that is
+		 * referenced by the caller.
+		 */
+		static Cow_backing *copy(Cow_backing &from, unsigned chunk)
+		{
+			size_t const offset = chunk*CHUNK_SIZE;
+			size_t const size   = min((size_t)CHUNK_SIZE, from._size - offset);
+
+			Ram_dataspace_capability ds = env()->ram_session()->alloc(size);
+
+			char *dst = env()->rm_session()->attach(ds);
+			char *src = env()->rm_session()->attach(from._ds, size, offset);
+
+			memcpy(dst, src, size);
+
+			env()->rm_session()->detach(src);
+			env()->rm_session()->detach(dst);
+
+			Cow_backing *backing = new (env()->heap()) Cow_backing(ds, size);
+			backing->_refs[0] = 1;
+			return backing;
+		}
+
+		Ram_dataspace_capability ds() const { return _ds; }
+
+		void ref(unsigned chunk)
+		{
+			Lock::Guard guard(_lock);
+			_refs[chunk]++;
+			_total++;
+		}
+
+		static void unref(Cow_backing *backing, unsigned chunk)
+		{
+			{
+				Lock::Guard guard(backing->_lock);
+				backing->_refs[chunk]--;
+			}
+			_drop(backing);
+		}
+
+		/**
+		 * Release the backing store held by its owner
+		 */
+		static void release(Cow_backing *backing) { _drop(backing); }
+
+		/**
+		 * Return true if the chunk is referenced by one view only
+		 */
+		bool exclusive(unsigned chunk)
+		{
+			Lock::Guard guard(_lock);
+			return _refs[chunk] == 1;
+		}
+};
+
+
+/**
+ * Managed dataspace composed of the chunks of copy-on-write backing stores
+ */
+class Noux::Cow_dataspace : public Signal_context
+{
+	public:
+
+		enum { CHUNK_SIZE = Cow_backing::CHUNK_SIZE };
+
+	private:
+
+		struct Chunk
+		{
+			Cow_backing *backing;
+			unsigned     index;         /* chunk index within backing store */
+			bool         writeable;
+			bool         region_start;  /* chunk starts an attached region */
+		};
+
+		Lock           _lock;
+		size_t   const _size;
+		unsigned const _num_chunks;
+		Chunk         *_chunks;
+		Rm_connection  _view;
+
+		size_t _chunk_size(unsigned i) const
+		{
+			return min((size_t)CHUNK_SIZE, _size - i*CHUNK_SIZE);
+		}
+
+		void _alloc_chunks()
+		{
+			if (!env()->heap()->alloc(_num_chunks*sizeof(Chunk), &_chunks))
+				throw Allocator::Out_of_memory();
+		}
+
+		/**
+		 * Return true if chunk 'i' follows chunk 'i - 1' in the same backing store
+		 */
+		bool _adjacent(unsigned i) const
+		{
+			return i > 0
+			    && _chunks[i].backing == _chunks[i - 1].backing
+			    && _chunks[i].index   == _chunks[i - 1].index + 1;
+		}
+
+		/**
+		 * Return true if chunk 'i' can share a region with chunk 'i - 1'
+		 */
+		bool _joinable(unsigned i) const
+		{
+			return _adjacent(i) && !_chunks[i].writeable
+			                    && !_chunks[i - 1].writeable;
+		}
+
+		/**
+		 * Attach chunks 'first' to 'end - 1' as one region
+		 */
+		void _attach(unsigned first, unsigned end)
+		{
+			Chunk const &chunk = _chunks[first];
+			size_t const size  = (end - 1 - first)*CHUNK_SIZE + _chunk_size(end - 1);
+
+			for (;;) {
+				try {
+					_view.attach(chunk.backing->ds(), size,
+					             chunk.index*CHUNK_SIZE, true, first*CHUNK_SIZE,
+					             false, chunk.writeable);
+					break;
+				} catch (Rm_session::Out_of_metadata) {
+					env()->parent()->upgrade(_view.cap(), "ram_quota=8K");
+				}
+			}
+
+			for (unsigned i = first; i < end; i++)
+				_chunks[i].region_start = (i == first);
+		}
+
+		/**
+		 * Attach the chunks 'first' to 'end - 1' as few regions as possible
+		 */
+		void _attach_runs(unsigned first, unsigned end)
+		{
+			while (first < end) {
+				unsigned i = first + 1;
+				while (i < end && _joinable(i))
+					i++;
+
+				_attach(first, i);
+				first = i;
+			}
+		}
+
+		unsigned _region_start(unsigned i) const
+		{
+			while (!_chunks[i].region_start)
+				i--;
+			return i;
+		}
+
+		unsigned _region_end(unsigned first) const
+		{
+			unsigned i = first + 1;
+			while (i < _num_chunks && !_chunks[i].region_start)
+				i++;
+			return i;
+		}
+
+		/**
+		 * Re-attach the region that contains chunk 'i'
+		 *
+		 * If the chunk cannot be joined with its neighbours anymore, the
+		 * region gets split. Other regions stay untouched.
+		 */
+		void _reattach(unsigned i)
+		{
+			unsigned const first = _region_start(i);
+			unsigned const end   = _region_end(first);
+
+			_view.detach(first*CHUNK_SIZE);
+			_attach_runs(first, end);
+		}
+
+		/**
+		 * Turn chunk into a private writeable chunk
+		 */
+		void _make_writeable(unsigned i)
+		{
+			Chunk &chunk = _chunks[i];
+
+			if (chunk.writeable)
+				return;
+
+			if (!chunk.backing->exclusive(chunk.index)) {
+				Cow_backing *copy = Cow_backing::copy(*chunk.backing, chunk.index);
+				Cow_backing::unref(chunk.backing, chunk.index);
+				chunk.backing = copy;
+				chunk.index   = 0;
+			}
+			chunk.writeable = true;
+
+			_reattach(i);
+		}
+
+		/**
+		 * Share all chunks read-only
+		 *
+		 * Only the regions that contain writeable chunks are replaced,
+		 * joined with their read-only neighbours.
+		 */
+		void _write_protect()
+		{
+			for (unsigned first = 0; first < _num_chunks; ) {
+
+				unsigned end = first + 1;
+				while (end < _num_chunks && _adjacent(end))
+					end++;
+
+				bool changed = false;
+				for (unsigned i = first; i < end; i++)
+					changed |= _chunks[i].writeable
+					        || (i > first && _chunks[i].region_start);
+
+				if (changed) {
+					for (unsigned i = first; i < end; i++) {
+						if (_chunks[i].region_start)
+							_view.detach(i*CHUNK_SIZE);
+						_chunks[i].writeable = false;
+					}
+					_attach(first, end);
+				}
+				first = end;
+			}
+		}
+
+		inline void _init();
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing  backing store that provides the initial content
+		 *                 of all chunks
+		 * \param size     size of the dataspace
+		 */
+		inline Cow_dataspace(Cow_backing &backing, size_t size);
+
+		/**
+		 * Constructor for creating a copy-on-write copy
+		 *
+		 * All chunks of 'other' become read-only shared by both
+		 * dataspaces.
+		 */
+		inline Cow_dataspace(Cow_dataspace &other);
+
+		inline ~Cow_dataspace();
+
+		/**
+		 * Return capability of the managed dataspace
+		 */
+		Dataspace_capability cap() { return _view.dataspace(); }
+
+		/**
+		 * Write raw byte sequence into dataspace
+		 */
+		void poke(addr_t dst_offset, void const *src, size_t len)
+		{
+			Lock::Guard guard(_lock);
+
+			while (len) {
+
+				unsigned const i      = dst_offset / CHUNK_SIZE;
+				addr_t   const offset = dst_offset % CHUNK_SIZE;
+				size_t   const count  = min(len, _chunk_size(i) - offset);
+
+				_make_writeable(i);
+
+				Chunk const &chunk = _chunks[i];
+				char *dst = env()->rm_session()->attach(chunk.backing->ds(),
+				                                        _chunk_size(i),
+				                                        chunk.index*CHUNK_SIZE);
+				memcpy(dst + offset, src, count);
+				env()->rm_session()->detach(dst);
+
+				dst_offset += count;
+				src         = (char const *)src + count;
+				len        -= count;
+			}
+		}
+
+		/**
+		 * Resolve the faults of the view
+		 *
+		 * Called by the fault-handler thread.
+		 */
+		void handle_faults()
+		{
+			Lock::Guard guard(_lock);
+
+			Rm_session::State last;
+
+			for (;;) {
+				Rm_session::State const state = _view.state();
+
+				if (state.type == Rm_session::READY)
+					return;
+
+				unsigned const i = state.addr / CHUNK_SIZE;
+
+				if (i >= _num_chunks
+				 || (state.type == last.type && state.addr == last.addr)) {
+					PERR("unresolvable %s fault at 0x%lx of copy-on-write dataspace",
+					     state.type == Rm_session::WRITE_FAULT ? "write" : "read",
+					     state.addr);
+					return;
+				}
+
+				if (state.type == Rm_session::WRITE_FAULT && !_chunks[i].writeable)
+					_make_writeable(i);
+
+				/*
+				 * The fault hit the chunk while being re-attached. Attach
+				 * its region once more to let the faulter continue.
+				 */
+				else
+					_reattach(i);
+
+				last = state;
+			}
+		}
+};
+
+
+/**
+ * Thread that resolves the faults of all copy-on-write dataspaces
+ */
+class Noux::Cow_fault_handler : Thread<4096*sizeof(long)>
+{
+	private:
+
+		Signal_receiver _sig_rec;
+
+		void entry()
+		{
+			for (;;) {
+				Signal signal = _sig_rec.wait_for_signal();
+				static_cast<Cow_dataspace *>(signal.context())->handle_faults();
+			}
+		}
+
+	public:
+
+		Cow_fault_handler() : Thread("cow_fault_handler") { start(); }
+
+		Signal_context_capability manage(Cow_dataspace *ds) {
+			return _sig_rec.manage(ds); }
+
+		void dissolve(Cow_dataspace *ds) { _sig_rec.dissolve(ds); }
+};
+
+
+Noux::Cow_fault_handler &Noux::cow_fault_handler()
+{
+	static Cow_fault_handler inst;
+	return inst;
+}
+
+
+/**
+ * Return true if the platform supports copy-on-write dataspaces
+ *
+ * Copy-on-write dataspaces are managed dataspaces that depend on the
+ * reflection of write faults. Where core lacks support for managed
+ * dataspaces (base-linux), the dataspace of an RM session is invalid.
+ */
+bool Noux::cow_supported()
+{
+	static bool const supported =
+		Rm_connection(0, Cow_backing::CHUNK_SIZE).dataspace().valid();
+
+	return supported;
+}
+
+
+void Noux::Cow_dataspace::_init()
+{
+	_attach_runs(0, _num_chunks);
+
+	_view.fault_handler(cow_fault_handler().manage(this));
+}
+
+
+Noux::Cow_dataspace::Cow_dataspace(Cow_backing &backing, size_t size)
+:
+	_size(size), _num_chunks((size + CHUNK_SIZE - 1) / CHUNK_SIZE),
+	_chunks(0), _view(0, size)
+{
+	_alloc_chunks();
+
+	for (unsigned i = 0; i < _num_chunks; i++) {
+		Chunk chunk = { &backing, i, false, false };
+		_chunks[i] = chunk;
+		backing.ref(i);
+	}
+	_init();
+}
+
+
+Noux::Cow_dataspace::Cow_dataspace(Cow_dataspace &other)
+:
+	_size(other._size), _num_chunks(other._num_chunks),
+	_chunks(0), _view(0, other._size)
+{
+	_alloc_chunks();
+
+	Lock::Guard guard(other._lock);
+
+	other._write_protect();
+
+	for (unsigned i = 0; i < _num_chunks; i++) {
+		_chunks[i] = other._chunks[i];
+		_chunks[i].backing->ref(_chunks[i].index);
+	}
+	_init();
+}
+
+
+Noux::Cow_dataspace::~Cow_dataspace()
+{
+	/* wait for the completion of a fault being handled */
+	cow_fault_handler().dissolve(this);
+
+	Lock::Guard guard(_lock);
+
+	for (unsigned i = 0; i < _num_chunks; i++) {
+		if (_chunks[i].region_start)
+			_view.detach(i*CHUNK_SIZE);
+		Cow_backing::unref(_chunks[i].backing, _chunks[i].index);
+	}
+	env()->heap()->free(_chunks, _num_chunks*sizeof(Chunk));
+}
+
+#endif /* _NOUX__COW_DATASPACE_H_ */
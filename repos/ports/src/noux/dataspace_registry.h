@@ -27,6 +27,11 @@ namespace Noux {
 	struct Dataspace_user : List<Dataspace_user>::Element
 	{
 		virtual void dissolve(Dataspace_info &ds) = 0;
+
+		/**
+		 * Re-attach dataspace after its 'view' changed
+		 */
+		virtual void reattach(Dataspace_info &ds) = 0;
 	};
 
 
@@ -81,6 +86,26 @@ namespace Noux {
 				}
 			}
 
+			void reattach_users()
+			{
+				Lock::Guard guard(_users_lock);
+				for (Dataspace_user *user = _users.first(); user; user = user->next())
+					user->reattach(*this);
+			}
+
+			/**
+			 * Return dataspace to be attached in place of the dataspace
+			 *
+			 * By default, the dataspace is attached as is. A copy-on-write
+			 * dataspace is attached via a managed dataspace instead.
+			 */
+			virtual Dataspace_capability view() { return _ds_cap; }
+
+			/**
+			 * Return true if the content of the dataspace cannot change
+			 */
+			virtual bool read_only() const { return false; }
+
 			/**
 			 * Create shadow copy of dataspace
 			 *
@@ -82,6 +82,22 @@ namespace Noux {
 			virtual bool     ioctl(Sysio *sysio)                 { return false; }
 			virtual bool     lseek(Sysio *sysio)                 { return false; }
 
+			/**
+			 * Announce that the caller is about to block in a 'read' syscall
+			 *
+			 * A channel may let the producer of data deliver the data
+			 * directly into the destination buffer of the syscall.
+			 */
+			virtual void prepare_blocking_read(Sysio *sysio) { }
+
+			/**
+			 * Revoke announcement made by 'prepare_blocking_read'
+			 *
+			 * \return true if data was delivered meanwhile, which must be
+			 *         picked up by calling 'read'
+			 */
+			virtual bool cancel_blocking_read(Sysio *sysio) { return false; }
+
 			/**
 			 * Return true if an unblocking condition of the channel is satisfied
 			 *
@@ -92,6 +108,14 @@ namespace Noux {
 			virtual bool check_unblock(bool rd, bool wr, bool ex) const {
 				return false; }
 
+			/**
+			 * Return number of bytes the channel accepts without blocking
+			 *
+			 * Used by 'splice' to consume no more input than can be passed
+			 * on to the channel.
+			 */
+			virtual size_t write_capacity() const { return ~0UL; }
+
 			/**
 			 * Return true if the channel is set to non-blocking mode
 			 */
@@ -149,6 +149,57 @@ namespace Noux {
  ** Noux syscall dispatcher **
  *****************************/
 
+bool Noux::Child::_read()
+{
+	Shared_pointer<Io_channel> io = _lookup_channel(_sysio->read_in.fd);
+
+	if (!io->is_nonblocking()) {
+		io->prepare_blocking_read(_sysio);
+		_block_for_io_channel(io, true, false, false);
+	}
+
+	if (io->check_unblock(true, false, false)
+	 || io->cancel_blocking_read(_sysio))
+		return io->read(_sysio);
+
+	_sysio->error.read = Vfs::File_io_service::READ_ERR_INTERRUPT;
+	return false;
+}
+
+
+bool Noux::Child::_write(int const fd, size_t &offset, bool const all)
+{
+	bool result = false;
+
+	size_t const count_in = _sysio->write_count();
+
+	for (offset = 0; offset != count_in; ) {
+
+		Shared_pointer<Io_channel> io = _lookup_channel(fd);
+
+		if (all || !io->is_nonblocking())
+			_block_for_io_channel(io, false, true, false, !all);
+
+		if (io->check_unblock(false, true, false)) {
+			/*
+			 * 'io->write' is expected to update
+			 * '_sysio->write_out.count' and 'offset'
+			 */
+			result = io->write(_sysio, offset);
+			if (result == false)
+				break;
+		} else {
+			if (result == false) {
+				/* nothing was written yet */
+				_sysio->error.write = Vfs::File_io_service::WRITE_ERR_INTERRUPT;
+			}
+			break;
+		}
+	}
+	return result;
+}
+
+
 bool Noux::Child::syscall(Noux::Session::Syscall sc)
 {
 	if (trace_syscalls)
@@ -162,46 +213,87 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_WRITE:
 			{
-				size_t const count_in = _sysio->write_in.count;
+				size_t count = 0;
+				result = _write(_sysio->write_in.fd, count);
+				break;
+			}
 
-				for (size_t offset = 0; offset != count_in; ) {
+		case SYSCALL_READ:
 
-					Shared_pointer<Io_channel> io = _lookup_channel(_sysio->write_in.fd);
+			result = _read();
+			break;
 
-					if (!io->is_nonblocking())
-						_block_for_io_channel(io, false, true, false);
+		case SYSCALL_SPLICE:
+			{
+				/*
+				 * Forward data from one I/O channel to another by reading
+				 * into the I/O window (or the chunk for small requests) and
+				 * writing from there, without involving the process.
+				 */
+				int    const fd_in  = _sysio->splice_in.fd_in;
+				int    const fd_out = _sysio->splice_in.fd_out;
+				size_t const count  = _sysio->splice_in.count;
 
-					if (io->check_unblock(false, true, false)) {
-						/*
-						 * 'io->write' is expected to update
-						 * '_sysio->write_out.count' and 'offset'
-						 */
-						result = io->write(_sysio, offset);
-						if (result == false)
-							break;
-					} else {
-						if (result == false) {
-							/* nothing was written yet */
-							_sysio->error.write = Vfs::File_io_service::WRITE_ERR_INTERRUPT;
-						}
-						break;
-					}
+				/* look up both channels before consuming any data */
+				Shared_pointer<Io_channel> out = _lookup_channel(fd_out);
+				_lookup_channel(fd_in);
+
+				/*
+				 * Wait until the output accepts data and read no more than
+				 * it takes without blocking, so that the data read can be
+				 * written without delay in the common case.
+				 */
+				if (!out->is_nonblocking())
+					_block_for_io_channel(out, false, true, false);
+
+				if (!out->check_unblock(false, true, false)) {
+					_sysio->error.splice = out->is_nonblocking()
+					                     ? Sysio::SPLICE_ERR_AGAIN
+					                     : Sysio::SPLICE_ERR_INTERRUPT;
+					break;
 				}
-				break;
-			}
 
-		case SYSCALL_READ:
-			{
-				Shared_pointer<Io_channel> io = _lookup_channel(_sysio->read_in.fd);
+				_sysio->read_in.fd    = fd_in;
+				_sysio->read_in.count = min(count, out->write_capacity());
 
-				if (!io->is_nonblocking())
-					_block_for_io_channel(io, true, false, false);
+				size_t      max_count = 0;
+				char const *src       = _sysio->read_buffer(max_count);
 
-				if (io->check_unblock(true, false, false))
-					result = io->read(_sysio);
-				else
-					_sysio->error.read = Vfs::File_io_service::READ_ERR_INTERRUPT;
+				if (!_read()) {
+					_sysio->error.splice =
+						(_sysio->error.read == Vfs::File_io_service::READ_ERR_INTERRUPT)
+						? Sysio::SPLICE_ERR_INTERRUPT : Sysio::SPLICE_ERR_IO;
+					break;
+				}
+
+				size_t const n = min((size_t)_sysio->read_out.count, max_count);
+
+				size_t written = 0;
+
+				if (n) {
+
+					/* payloads that fit into the chunk are written from there */
+					if (!Sysio::uses_io_window(n))
+						memmove(_sysio->write_in.chunk, src, n);
+
+					_sysio->write_in.fd    = fd_out;
+					_sysio->write_in.count = n;
 
+					/*
+					 * The data is already consumed from the input. Hence,
+					 * write all of it even if a concurrent writer to the
+					 * same output fills it up or a signal arrives. Only an
+					 * I/O error of the output makes the write come up short,
+					 * in which case the bytes actually written are reported.
+					 */
+					if (!_write(fd_out, written, true) && !written) {
+						_sysio->error.splice = Sysio::SPLICE_ERR_IO;
+						break;
+					}
+				}
+
+				_sysio->splice_out.count = written;
+				result = true;
 				break;
 			}
 
@@ -656,7 +748,8 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_PIPE:
 			{
-				Shared_pointer<Pipe> pipe(new Pipe, Genode::env()->heap());
+				Shared_pointer<Pipe> pipe(new Pipe(_pipe_buffer_quota),
+				                          Genode::env()->heap());
 
 				Shared_pointer<Io_channel> pipe_sink(new Pipe_sink_io_channel(pipe, *_sig_rec),
 				                                     Genode::env()->heap());
@@ -71,12 +71,12 @@ namespace Noux {
 
 			bool write(Sysio *sysio, size_t &count)
 			{
-				ssize_t result = ::write(_socket, sysio->write_in.chunk,
-				                         sysio->write_in.count);
+				ssize_t result = ::write(_socket, sysio->write_data() + count,
+				                         sysio->write_count() - count);
 
 				if (result > -1) {
-					sysio->write_out.count = result;
-					count = result;
+					count += result;
+					sysio->write_out.count = count;
 
 					return true;
 				}
@@ -96,9 +96,10 @@ namespace Noux {
 
 			bool read(Sysio *sysio)
 			{
-				size_t const max_count = Genode::min(sysio->read_in.count, sizeof(sysio->read_out.chunk));
+				size_t max_count = 0;
+				char  *dst       = sysio->read_buffer(max_count);
 
-				ssize_t result = ::read(_socket, sysio->read_out.chunk, max_count);
+				ssize_t result = ::read(_socket, dst, max_count);
 
 				if (result > -1) {
 					sysio->read_out.count = result;
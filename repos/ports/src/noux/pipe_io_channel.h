@@ -14,46 +14,189 @@
 #ifndef _NOUX__PIPE_IO_CHANNEL_H_
 #define _NOUX__PIPE_IO_CHANNEL_H_
 
+/* Genode includes */
+#include <base/thread.h>
+
 /* Noux includes */
 #include <io_channel.h>
 
 namespace Noux {
 
+	/**
+	 * Budget for the pipe buffers created by one process
+	 *
+	 * Pipe buffers are allocated from the heap of noux. To keep a single
+	 * process from draining the heap, the memory a pipe occupies beyond its
+	 * initial buffer is charged to the budget of the process that created
+	 * the pipe. Because pipes may outlive their creator, the budget is
+	 * reference counted.
+	 */
+	class Pipe_buffer_quota : public Reference_counter
+	{
+		private:
+
+			Lock         _lock;
+			size_t const _limit;
+			size_t       _used;
+
+		public:
+
+			enum { DEFAULT_LIMIT = 4*1024*1024 };
+
+			Pipe_buffer_quota(size_t limit = DEFAULT_LIMIT)
+			: _limit(limit), _used(0) { }
+
+			/**
+			 * Charge 'size' bytes to the budget
+			 *
+			 * eturn false if the budget does not suffice
+			 */
+			bool withdraw(size_t size)
+			{
+				Lock::Guard guard(_lock);
+
+				if (size > _limit - _used)
+					return false;
+
+				_used += size;
+				return true;
+			}
+
+			void replenish(size_t size)
+			{
+				Lock::Guard guard(_lock);
+				_used -= size;
+			}
+	};
+
+
+	/**
+	 * Pipe buffer shared by the sink and source I/O channels of a pipe
+	 *
+	 * The ring buffer is allocated from the heap of noux. It starts small
+	 * and grows whenever a writer would otherwise stall, up to
+	 * 'MAX_BUFFER_SIZE' and as far as the 'Pipe_buffer_quota' of the
+	 * creating process permits.
+	 *
+	 * If a reader blocks at an empty pipe, it may announce its destination
+	 * buffer via 'arm_read'. The next writer then deposits its data directly
+	 * into this buffer instead of going through the ring buffer. Readers are
+	 * identified by the thread that executes their syscalls.
+	 */
 	class Pipe : public Reference_counter
 	{
 		private:
 
 			Lock mutable _lock;
 
-			enum { BUFFER_SIZE = 4096 };
-			char _buffer[BUFFER_SIZE];
+			enum {
+				INITIAL_BUFFER_SIZE = 16*1024,
+				MAX_BUFFER_SIZE     = 1024*1024,
+			};
+
+			Shared_pointer<Pipe_buffer_quota> _quota;
 
-			unsigned _read_offset;
-			unsigned _write_offset;
+			char   *_buffer;
+			size_t  _buffer_size;
+
+			size_t _read_offset;
+			size_t _write_offset;
 
 			Signal_context_capability _read_ready_sigh;
 			Signal_context_capability _write_ready_sigh;
 
 			bool _writer_is_gone;
 
+			/*
+			 * Destination buffer announced by a blocked reader
+			 */
+			struct Pending_read
+			{
+				bool         armed;
+				Thread_base *owner;
+				char        *dst;
+				size_t       max_count;
+				size_t       count;   /* bytes deposited by a writer */
+			} _pending_read;
+
+			void _disarm()
+			{
+				Pending_read pending_read = { false, 0, 0, 0, 0 };
+				_pending_read = pending_read;
+			}
+
+			bool _armed_by_myself() const
+			{
+				return _pending_read.armed
+				    && _pending_read.owner == Thread_base::myself();
+			}
+
+			size_t _used_buffer_space() const
+			{
+				if (_read_offset <= _write_offset)
+					return _write_offset - _read_offset;
+
+				return _buffer_size - _read_offset + _write_offset;
+			}
+
 			/**
 			 * Return space available in the buffer for writing, in bytes
 			 */
 			size_t _avail_buffer_space() const
 			{
-				if (_read_offset < _write_offset)
-					return (BUFFER_SIZE - _write_offset) + _read_offset - 1;
+				return _buffer_size - _used_buffer_space() - 1;
+			}
+
+			bool _any_space_avail_for_writing() const
+			{
+				return _avail_buffer_space() > 0;
+			}
 
-				if (_read_offset > _write_offset)
-					return _read_offset - _write_offset - 1;
+			bool _ring_empty() const { return _read_offset == _write_offset; }
 
-				/* _read_offset == _write_offset */
-				return BUFFER_SIZE - 1;
+			/**
+			 * Enlarge buffer to hold at least 'needed' bytes
+			 *
+			 * If the allocation fails, the buffer keeps its size.
+			 */
+			void _grow(size_t needed)
+			{
+				size_t size = _buffer_size;
+				while (size - 1 < needed && size < MAX_BUFFER_SIZE)
+					size *= 2;
+
+				if (size == _buffer_size || !_quota->withdraw(size - _buffer_size))
+					return;
+
+				char *buffer = 0;
+				if (!env()->heap()->alloc(size, &buffer)) {
+					_quota->replenish(size - _buffer_size);
+					return;
+				}
+
+				size_t const used = _read(buffer, _used_buffer_space());
+
+				env()->heap()->free(_buffer, _buffer_size);
+
+				_buffer       = buffer;
+				_buffer_size  = size;
+				_read_offset  = 0;
+				_write_offset = used;
 			}
 
-			bool _any_space_avail_for_writing() const
+			/**
+			 * Copy data out of the ring buffer
+			 */
+			size_t _read(char *dst, size_t dst_len)
 			{
-				return _avail_buffer_space() > 0;;
+				size_t const len = min(dst_len, _used_buffer_space());
+
+				size_t const upper_len = min(len, _buffer_size - _read_offset);
+				memcpy(dst, &_buffer[_read_offset], upper_len);
+				memcpy(dst + upper_len, &_buffer[0], len - upper_len);
+
+				_read_offset = (_read_offset + len) % _buffer_size;
+				return len;
 			}
 
 			void _wake_up_reader()
@@ -70,12 +213,28 @@ namespace Noux {
 
 		public:
 
-			Pipe()
-			: _read_offset(0), _write_offset(0), _writer_is_gone(false) { }
+			/**
+			 * Constructor
+			 *
+			 * \param quota  budget of the creating process, charged for
+			 *               growing the buffer
+			 */
+			Pipe(Shared_pointer<Pipe_buffer_quota> quota)
+			:
+				_quota(quota), _buffer(0), _buffer_size(INITIAL_BUFFER_SIZE),
+				_read_offset(0), _write_offset(0), _writer_is_gone(false)
+			{
+				if (!env()->heap()->alloc(_buffer_size, &_buffer))
+					throw Allocator::Out_of_memory();
+
+				_disarm();
+			}
 
 			~Pipe()
 			{
 				Lock::Guard guard(_lock);
+				env()->heap()->free(_buffer, _buffer_size);
+				_quota->replenish(_buffer_size - INITIAL_BUFFER_SIZE);
 			}
 
 			void writer_close()
@@ -105,44 +264,92 @@ namespace Noux {
 				return _any_space_avail_for_writing();
 			}
 
+			/**
+			 * Return number of bytes that can be written without blocking
+			 *
+			 * The value does not account for a possible growth of the
+			 * buffer.
+			 */
+			size_t avail_space_for_writing() const
+			{
+				Lock::Guard guard(_lock);
+				return _avail_buffer_space();
+			}
+
+			/**
+			 * Return true if the calling reader would obtain data
+			 */
 			bool data_avail_for_reading() const
 			{
 				Lock::Guard guard(_lock);
+				return !_ring_empty() || (_armed_by_myself() && _pending_read.count);
+			}
 
-				return _read_offset != _write_offset;
+			/**
+			 * Announce destination buffer of the calling reader about to block
+			 *
+			 * The buffer is not armed if data is available already or if
+			 * another reader is armed.
+			 */
+			void arm_read(char *dst, size_t max_count)
+			{
+				Lock::Guard guard(_lock);
+
+				if (_pending_read.armed || !_ring_empty() || !max_count)
+					return;
+
+				Pending_read pending_read = { true, Thread_base::myself(),
+				                              dst, max_count, 0 };
+				_pending_read = pending_read;
 			}
 
-			size_t read(char *dst, size_t dst_len)
+			/**
+			 * Withdraw destination buffer of the calling reader
+			 *
+			 * \return number of bytes deposited into the buffer by a writer
+			 */
+			size_t disarm_read()
 			{
 				Lock::Guard guard(_lock);
 
-				if (_read_offset < _write_offset) {
+				if (!_armed_by_myself())
+					return 0;
 
-					size_t len = min(dst_len, _write_offset - _read_offset);
-					memcpy(dst, &_buffer[_read_offset], len);
+				size_t const count = _pending_read.count;
+				_disarm();
+				return count;
+			}
 
-					_read_offset += len;
-					_wake_up_writer();
+			/**
+			 * Withdraw destination buffer unless data was deposited
+			 *
+			 * \return true if data was deposited, which is to be picked up
+			 *         via 'disarm_read'
+			 */
+			bool cancel_read()
+			{
+				Lock::Guard guard(_lock);
 
-					return len;
-				}
+				if (!_armed_by_myself())
+					return false;
 
-				if (_read_offset > _write_offset) {
+				if (_pending_read.count)
+					return true;
+
+				_disarm();
+				return false;
+			}
 
-					size_t const upper_len = min(dst_len, BUFFER_SIZE - _read_offset);
-					memcpy(dst, &_buffer[_read_offset], upper_len);
+			size_t read(char *dst, size_t dst_len)
+			{
+				Lock::Guard guard(_lock);
 
-					size_t const lower_len = min(dst_len - upper_len, _write_offset);
-					memcpy(dst + upper_len, &_buffer[0], lower_len);
+				size_t const len = _read(dst, dst_len);
 
-					_read_offset = lower_len;
+				if (len)
 					_wake_up_writer();
 
-					return upper_len + lower_len;
-				}
-
-				/* _read_offset == _write_offset */
-				return 0;
+				return len;
 			}
 
 			/**
@@ -150,47 +357,54 @@ namespace Noux {
 			 *
 			 * \return number of written bytes (may be less than 'len')
 			 */
-			size_t write(char *src, size_t len)
+			size_t write(char const *src, size_t len)
 			{
 				Lock::Guard guard(_lock);
 
-				/* trim write request to the available buffer space */
-				size_t const trimmed_len = min(len, _avail_buffer_space());
-
 				/*
 				 * Remember pipe state prior writing to see whether a reader
 				 * must be unblocked after writing.
 				 */
-				bool const pipe_was_empty = (_read_offset == _write_offset);
+				bool const pipe_was_empty = _ring_empty() && !_pending_read.count;
+
+				size_t written = 0;
+
+				/* hand data directly to a blocked reader */
+				if (_pending_read.armed && pipe_was_empty) {
+					written = min(len, _pending_read.max_count);
+					memcpy(_pending_read.dst, src, written);
+					_pending_read.count = written;
+				}
+
+				if (_avail_buffer_space() < len - written)
+					_grow(_used_buffer_space() + len - written);
+
+				/* trim write request to the available buffer space */
+				size_t const trimmed_len = min(len - written, _avail_buffer_space());
+				src += written;
 
 				/* write data up to the upper boundary of the pipe buffer */
-				size_t const upper_len = min(BUFFER_SIZE - _write_offset, trimmed_len);
+				size_t const upper_len = min(_buffer_size - _write_offset, trimmed_len);
 				memcpy(&_buffer[_write_offset], src, upper_len);
 
-				_write_offset += upper_len;
-
 				/*
-				 * Determine number of remaining bytes beyond the buffer boundary.
-				 * The buffer wraps. So this data will end up in the lower part
-				 * of the pipe buffer.
+				 * The remaining bytes beyond the buffer boundary wrap around
+				 * to the lower part of the pipe buffer.
 				 */
-				size_t const lower_len = trimmed_len - upper_len;
+				memcpy(&_buffer[0], src + upper_len, trimmed_len - upper_len);
 
-				if (lower_len > 0) {
+				_write_offset = (_write_offset + trimmed_len) % _buffer_size;
 
-					/* pipe buffer wrap-around, write remaining data to the lower part */
-					memcpy(&_buffer[0], src + upper_len, lower_len);
-					_write_offset = lower_len;
-				}
+				written += trimmed_len;
 
 				/*
 				 * Wake up reader who may block for incoming data.
 				 */
-				if (pipe_was_empty || !_any_space_avail_for_writing())
+				if (written && (pipe_was_empty || !_avail_buffer_space()))
 					_wake_up_reader();
 
 				/* return number of written bytes */
-				return trimmed_len;
+				return written;
 			}
 
 			void register_write_ready_sigh(Signal_context_capability sigh)
@@ -234,6 +448,11 @@ namespace Noux {
 				return wr && _pipe->any_space_avail_for_writing();
 			}
 
+			size_t write_capacity() const override
+			{
+				return _pipe->avail_space_for_writing();
+			}
+
 			bool write(Sysio *sysio, size_t &offset) override
 			{
 				/*
@@ -246,8 +465,8 @@ namespace Noux {
 				 */
 
 				/* dimension the pipe write operation to the not yet written data */
-				size_t curr_count = _pipe->write(sysio->write_in.chunk + offset,
-				                                 sysio->write_in.count - offset);
+				size_t curr_count = _pipe->write(sysio->write_data() + offset,
+				                                 sysio->write_count() - offset);
 				offset += curr_count;
 				return true;
 			}
@@ -303,14 +522,31 @@ namespace Noux {
 				return (rd && _pipe->data_avail_for_reading());
 			}
 
+			void prepare_blocking_read(Sysio *sysio) override
+			{
+				size_t max_count = 0;
+				char  *dst       = sysio->read_buffer(max_count);
+
+				_pipe->arm_read(dst, max_count);
+			}
+
+			bool cancel_blocking_read(Sysio *sysio) override
+			{
+				return _pipe->cancel_read();
+			}
+
 			bool read(Sysio *sysio) override
 			{
-				size_t const max_count =
-					min(sysio->read_in.count,
-					    sizeof(sysio->read_out.chunk));
+				/* data deposited by the writer while we were blocking */
+				if (size_t const count = _pipe->disarm_read()) {
+					sysio->read_out.count = count;
+					return true;
+				}
+
+				size_t max_count = 0;
+				char  *dst       = sysio->read_buffer(max_count);
 
-				sysio->read_out.count =
-					_pipe->read(sysio->read_out.chunk, max_count);
+				sysio->read_out.count = _pipe->read(dst, max_count);
 
 				return true;
 			}
@@ -30,70 +30,132 @@
 
 /* Noux includes */
 #include <dataspace_registry.h>
+#include <cow_dataspace.h>
 
 namespace Noux {
 
-	struct Ram_dataspace_info : Dataspace_info,
-	                            List<Ram_dataspace_info>::Element
+	class Ram_session_component;
+
+	class Ram_dataspace_info : public Dataspace_info,
+	                           public List<Ram_dataspace_info>::Element
 	{
-		Ram_dataspace_info(Ram_dataspace_capability ds_cap)
-		: Dataspace_info(ds_cap) { }
+		private:
+
+			/*
+			 * Dataspaces smaller than this are copied eagerly at fork time.
+			 * Larger dataspaces are shared copy-on-write if supported by
+			 * the platform.
+			 */
+			enum { COW_MIN_SIZE = 128*1024 };
+
+			/*
+			 * Backing store of the copy-on-write views of the dataspace,
+			 * held by the original dataspace until it gets freed
+			 */
+			Cow_backing *_backing;
 
-		Dataspace_capability fork(Ram_session_capability ram,
-		                          Dataspace_registry    &,
-		                          Rpc_entrypoint        &)
-		{
-			size_t const size = Dataspace_client(ds_cap()).size();
+			Cow_dataspace *_cow;
 
-			Ram_dataspace_capability dst_ds;
+			/**
+			 * Attach the dataspace copy-on-write from now on
+			 */
+			void _make_cow()
+			{
+				_backing = new (env()->heap())
+					Cow_backing(static_cap_cast<Ram_dataspace>(ds_cap()), size());
+				_cow = new (env()->heap()) Cow_dataspace(*_backing, size());
 
-			try {
-				dst_ds = Ram_session_client(ram).alloc(size);
-			} catch (...) {
-				return Dataspace_capability();
+				reattach_users();
 			}
 
-			void *src = 0;
-			try {
-				src = env()->rm_session()->attach(ds_cap());
-			} catch (...) { }
+			Dataspace_capability _copy(Ram_session_capability ram)
+			{
+				size_t const size = Dataspace_client(ds_cap()).size();
+
+				Ram_dataspace_capability dst_ds;
+
+				try {
+					dst_ds = Ram_session_client(ram).alloc(size);
+				} catch (...) {
+					return Dataspace_capability();
+				}
+
+				void *src = 0;
+				try {
+					src = env()->rm_session()->attach(ds_cap());
+				} catch (...) { }
 
-			void *dst = 0;
-			try {
-				dst = env()->rm_session()->attach(dst_ds);
-			} catch (...) { }
+				void *dst = 0;
+				try {
+					dst = env()->rm_session()->attach(dst_ds);
+				} catch (...) { }
 
-			if (src && dst)
-				memcpy(dst, src, size);
+				if (src && dst)
+					memcpy(dst, src, size);
 
-			if (src) env()->rm_session()->detach(src);
-			if (dst) env()->rm_session()->detach(dst);
+				if (src) env()->rm_session()->detach(src);
+				if (dst) env()->rm_session()->detach(dst);
+
+				if (!src || !dst) {
+					Ram_session_client(ram).free(dst_ds);
+					return Dataspace_capability();
+				}
 
-			if (!src || !dst) {
-				Ram_session_client(ram).free(dst_ds);
-				return Dataspace_capability();
+				return dst_ds;
 			}
 
-			return dst_ds;
-		}
+		public:
+
+			Ram_dataspace_info(Ram_dataspace_capability ds_cap)
+			: Dataspace_info(ds_cap), _backing(0), _cow(0) { }
+
+			/**
+			 * Constructor for a copy-on-write copy of a dataspace
+			 */
+			Ram_dataspace_info(Cow_dataspace *cow)
+			: Dataspace_info(cow->cap()), _backing(0), _cow(cow) { }
+
+			~Ram_dataspace_info()
+			{
+				if (_cow)
+					destroy(env()->heap(), _cow);
 
-		void poke(addr_t dst_offset, void const *src, size_t len)
-		{
-			if ((dst_offset >= size()) || (dst_offset + len > size())) {
-			 	PERR("illegal attemt to write beyond dataspace boundary");
-			 	return;
+				if (_backing)
+					Cow_backing::release(_backing);
+
+				/* original dataspace not shared copy-on-write */
+				if (!_cow && !_backing)
+					env()->ram_session()->free(static_cap_cast<Ram_dataspace>(ds_cap()));
 			}
 
-			char *dst = 0;
-			try {
-				dst = env()->rm_session()->attach(ds_cap());
-			} catch (...) { }
+			Dataspace_capability view() { return _cow ? _cow->cap() : ds_cap(); }
 
-			if (src && dst)
-				memcpy(dst + dst_offset, src, len);
+			inline Dataspace_capability fork(Ram_session_capability ram,
+			                                 Dataspace_registry    &,
+			                                 Rpc_entrypoint        &ep);
 
-			if (dst) env()->rm_session()->detach(dst);
-		}
+			void poke(addr_t dst_offset, void const *src, size_t len)
+			{
+				if ((dst_offset >= size()) || (dst_offset + len > size())) {
+				 	PERR("illegal attemt to write beyond dataspace boundary");
+				 	return;
+				}
+
+				if (_cow) {
+					_cow->poke(dst_offset, src, len);
+					return;
+				}
+
+				char *dst = 0;
+				try {
+					dst = env()->rm_session()->attach(ds_cap());
+				} catch (...) { }
+
+				if (src && dst)
+					memcpy(dst + dst_offset, src, len);
+
+				if (dst) env()->rm_session()->detach(dst);
+			}
 	};
 
 
@@ -168,10 +230,26 @@ namespace Noux {
 				_list.remove(ds_info);
 				_used_quota -= ds_info->size();
 
-				env()->ram_session()->free(ds_cap);
+				/* the RAM dataspace is freed along with its last user */
 				destroy(env()->heap(), ds_info);
 			}
 
+			/**
+			 * Take over copy-on-write copy of a dataspace of another session
+			 */
+			Dataspace_capability adopt(Cow_dataspace *cow)
+			{
+				Ram_dataspace_info *ds_info = new (env()->heap())
+				                              Ram_dataspace_info(cow);
+
+				_used_quota += ds_info->size();
+
+				_registry.insert(ds_info);
+				_list.insert(ds_info);
+
+				return ds_info->ds_cap();
+			}
+
 			int ref_account(Ram_session_capability) { return 0; }
 			int transfer_quota(Ram_session_capability, size_t) { return 0; }
 			size_t quota() { return env()->ram_session()->quota(); }
@@ -179,4 +257,32 @@ namespace Noux {
 	};
 }
 
+
+Noux::Dataspace_capability
+Noux::Ram_dataspace_info::fork(Ram_session_capability ram,
+                               Dataspace_registry    &,
+                               Rpc_entrypoint        &ep)
+{
+	if (size() < COW_MIN_SIZE || !cow_supported())
+		return _copy(ram);
+
+	Object_pool<Rpc_object_base>::Guard
+		obj(ep.lookup_and_lock(ram));
+
+	Ram_session_component *dst = dynamic_cast<Ram_session_component *>(obj.object());
+	if (!dst)
+		return _copy(ram);
+
+	try {
+		if (!_cow)
+			_make_cow();
+
+		return dst->adopt(new (env()->heap()) Cow_dataspace(*_cow));
+
+	} catch (...) {
+		PERR("fork: could not create copy-on-write dataspace");
+		return Dataspace_capability();
+	}
+}
+
 #endif /* _NOUX__RAM_SESSION_COMPONENT_H_ */
@@ -22,6 +22,8 @@
 /* Genode includes */
 #include <rm_session/connection.h>
 #include <base/rpc_server.h>
+#include <ram_session/client.h>
+#include <util/string.h>
 
 namespace Noux
 {
@@ -47,13 +49,17 @@ class Noux::Rm_session_component : public Rpc_object<Rm_session>
 			size_t                size;
 			off_t                 offset;
 			addr_t                local_addr;
+			bool                  executable;
+			bool                  writeable;
 
 			Region(Rm_session_component &rm,
 			       Dataspace_capability ds, size_t size,
-			       off_t offset, addr_t local_addr)
+			       off_t offset, addr_t local_addr,
+			       bool executable, bool writeable)
 			:
 				rm(rm), ds(ds), size(size), offset(offset),
-				local_addr(local_addr)
+				local_addr(local_addr), executable(executable),
+				writeable(writeable)
 			{ }
 
 			/**
@@ -70,6 +76,7 @@ class Noux::Rm_session_component : public Rpc_object<Rm_session>
 			}
 
 			inline void dissolve(Dataspace_info &ds);
+			inline void reattach(Dataspace_info &ds);
 		};
 
 		Lock         _region_lock;
@@ -92,6 +99,75 @@ class Noux::Rm_session_component : public Rpc_object<Rm_session>
 
 		Dataspace_registry &_ds_registry;
 
+		void _attach(Dataspace_capability ds, size_t size, off_t offset,
+		             bool use_local_addr, Local_addr &local_addr,
+		             bool executable, bool writeable)
+		{
+			for (;;) {
+				try {
+					local_addr = _rm.attach(ds, size, offset, use_local_addr,
+					                        local_addr, executable, writeable);
+					break;
+				} catch (Rm_session::Out_of_metadata) {
+					Genode::env()->parent()->upgrade(_rm, "ram_quota=8096");
+				}
+			}
+		}
+
+		/**
+		 * Replace attached dataspace of region by the current view
+		 *
+		 * The region list stays untouched. Hence, the function does not
+		 * acquire the '_region_lock', which may be held by 'replay'.
+		 */
+		void _reattach(Region &region, Dataspace_capability view)
+		{
+			Local_addr local_addr = region.local_addr;
+
+			_rm.detach(local_addr);
+			_attach(view, region.size, region.offset, true, local_addr,
+			        region.executable, region.writeable);
+		}
+
+		/**
+		 * Create private copy of the content of a region
+		 */
+		Dataspace_capability _copy(Region const &region,
+		                           Ram_session_capability ram)
+		{
+			Ram_dataspace_capability dst_ds;
+
+			try {
+				dst_ds = Ram_session_client(ram).alloc(region.size);
+			} catch (...) {
+				return Dataspace_capability();
+			}
+
+			char *src = 0;
+			try {
+				src = env()->rm_session()->attach(region.ds, region.size,
+				                                  region.offset);
+			} catch (...) { }
+
+			char *dst = 0;
+			try {
+				dst = env()->rm_session()->attach(dst_ds);
+			} catch (...) { }
+
+			if (src && dst)
+				memcpy(dst, src, region.size);
+
+			if (src) env()->rm_session()->detach(src);
+			if (dst) env()->rm_session()->detach(dst);
+
+			if (!src || !dst) {
+				Ram_session_client(ram).free(dst_ds);
+				return Dataspace_capability();
+			}
+
+			return dst_ds;
+		}
+
 	public:
 
 		/**
@@ -163,6 +239,29 @@ class Noux::Rm_session_component : public Rpc_object<Rm_session>
 
 				Object_pool<Dataspace_info>::Guard info(_ds_registry.lookup_info(curr->ds));
 
+				/*
+				 * A read-only attachment of a ROM dataspace may get
+				 * populated copy-on-write by a fault handler of the
+				 * process, e.g., a data segment loaded by the dynamic
+				 * linker. The thread of the handler does not exist in
+				 * the new process. Hence, attach a private copy. Text
+				 * segments are never written and remain shared.
+				 */
+				if (info && info->read_only() && !curr->writeable
+				 && !curr->executable) {
+
+					ds = _copy(*curr, dst_ram);
+					if (!ds.valid()) {
+						PERR("replay: Error while copying read-only region");
+						continue;
+					}
+
+					Rm_session_client(dst_rm).attach(ds, curr->size, 0, true,
+					                                 curr->local_addr,
+					                                 curr->executable, true);
+					continue;
+				}
+
 				if (info) {
 
 					ds = info->fork(dst_ram, ds_registry, ep);
@@ -199,7 +298,9 @@ class Noux::Rm_session_component : public Rpc_object<Rm_session>
 				Rm_session_client(dst_rm).attach(ds, curr->size,
 				                                 curr->offset,
 				                                 true,
-				                                 curr->local_addr);
+				                                 curr->local_addr,
+				                                 curr->executable,
+				                                 curr->writeable);
 			}
 		}
 
@@ -254,30 +355,31 @@ class Noux::Rm_session_component : public Rpc_object<Rm_session>
 		                  size_t size = 0, off_t offset = 0,
 		                  bool use_local_addr = false,
 		                  Local_addr local_addr = (addr_t)0,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool writeable = true)
 		{
 			/*
 			 * Rm_session subtracts offset from size if size is 0
 			 */
 			if (size == 0) size = Dataspace_client(ds).size() - offset;
 
-			for (;;) {
-				try {
-					local_addr = _rm.attach(ds, size, offset, use_local_addr,
-					                        local_addr, executable);
-					break;
-				} catch (Rm_session::Out_of_metadata) {
-					Genode::env()->parent()->upgrade(_rm, "ram_quota=8096");
-				}
-			}
-
-			Region * region = new (env()->heap())
-			                  Region(*this, ds, size, offset, local_addr);
+			Region *region = 0;
 
 			/* register region as user of RAM dataspaces */
 			{
 				Object_pool<Dataspace_info>::Guard info(_ds_registry.lookup_info(ds));
 
+				/*
+				 * Attach the view of a known dataspace while holding its
+				 * info, which prevents the view from changing meanwhile.
+				 */
+				_attach(info ? info->view() : ds, size, offset,
+				        use_local_addr, local_addr, executable, writeable);
+
+				region = new (env()->heap())
+				         Region(*this, ds, size, offset, local_addr,
+				                executable, writeable);
+
 				if (info) {
 					info->register_user(*region);
 				} else {
@@ -359,4 +461,10 @@ inline void Noux::Rm_session_component::Region::dissolve(Dataspace_info &ds)
 }
 
 
+inline void Noux::Rm_session_component::Region::reattach(Dataspace_info &ds)
+{
+	rm._reattach(*this, ds.view());
+}
+
+
 #endif /* _NOUX__RM_SESSION_COMPONENT_H_ */
@@ -26,6 +26,8 @@ namespace Noux {
 
 		~Rom_dataspace_info() { }
 
+		bool read_only() const { return true; }
+
 		Dataspace_capability fork(Ram_session_capability,
 		                          Dataspace_registry &ds_registry,
 		                          Rpc_entrypoint &)
@@ -60,10 +60,9 @@ namespace Noux {
 
 		bool write(Sysio *sysio, size_t &offset) override
 		{
-			size_t const count = min(sysio->write_in.count,
-			                         sizeof(sysio->write_in.chunk));
+			size_t const count = sysio->write_count();
 
-			terminal.write(sysio->write_in.chunk, count);
+			terminal.write(sysio->write_data(), count);
 
 			sysio->write_out.count = count;
 			offset = count;
@@ -85,9 +84,8 @@ namespace Noux {
 				return true;
 			}
 
-			size_t const max_count =
-				min(sysio->read_in.count,
-				    sizeof(sysio->read_out.chunk));
+			size_t max_count = 0;
+			char  *dst       = sysio->read_buffer(max_count);
 
 			for (sysio->read_out.count = 0;
 			     (sysio->read_out.count < max_count) && !read_buffer.empty();
@@ -114,7 +112,7 @@ namespace Noux {
 					return true;
 				}
 
-				sysio->read_out.chunk[sysio->read_out.count] = c;
+				dst[sysio->read_out.count] = c;
 			}
 
 			return true;
@@ -48,26 +48,28 @@ namespace Noux {
 		{
 			size_t out_count = 0;
 
-			sysio->error.write = _fh->fs().write(_fh, sysio->write_in.chunk,
-		                                         sysio->write_in.count, out_count);
+			sysio->error.write = _fh->fs().write(_fh, sysio->write_data() + offset,
+		                                         sysio->write_count() - offset,
+		                                         out_count);
 		    if (sysio->error.write != Vfs::File_io_service::WRITE_OK)
 		    	return false;
 
 			_fh->advance_seek(out_count);
 
-			sysio->write_out.count = out_count;
-			offset = out_count;
+			offset += out_count;
+			sysio->write_out.count = offset;
 
 			return true;
 		}
 
 		bool read(Sysio *sysio) override
 		{
-			size_t count = min(sysio->read_in.count, sizeof(sysio->read_out.chunk));
+			size_t count = 0;
+			char  *dst   = sysio->read_buffer(count);
 
 			size_t out_count = 0;
 
-			sysio->error.read = _fh->fs().read(_fh, sysio->read_out.chunk, count, out_count);
+			sysio->error.read = _fh->fs().read(_fh, dst, count, out_count);
 
 			if (sysio->error.read != Vfs::File_io_service::READ_OK)
 				return false;
@@ -0,0 +1,114 @@
+/*
+ * \brief  Benchmark of the fork and exec latency depending on the heap size
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * With copy-on-write fork, the latency of 'fork' followed by '_exit' or
+ * 'execve' in the child should not grow with the size of the parent's heap.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+enum { ROUNDS = 10 };
+
+static char *self;
+
+
+static unsigned long usecs()
+{
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec*1000*1000 + tv.tv_usec;
+}
+
+
+/**
+ * Fork child and wait for its exit
+ *
+ * \param exec  if true, the child executes the benchmark binary in
+ *              child mode, otherwise it exits immediately
+ */
+static int fork_and_wait(bool exec)
+{
+	pid_t pid = fork();
+	if (pid < 0) {
+		printf("Error: fork returned %d, errno=%d\n", pid, errno);
+		return -1;
+	}
+
+	if (pid == 0) {
+		if (exec) {
+			char *args[] = { self, (char *)"child", 0 };
+			execve(self, args, 0);
+			printf("Error: execve failed, errno=%d\n", errno);
+		}
+		_exit(0);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+	return 0;
+}
+
+
+static void measure(size_t heap_size)
+{
+	/* populate the heap so that it must be present in the child */
+	char *heap = (char *)malloc(heap_size);
+	if (!heap) {
+		printf("Error: could not allocate heap of %zu KiB\n", heap_size/1024);
+		return;
+	}
+	memset(heap, 0x55, heap_size);
+
+	unsigned long fork_usecs = 0, exec_usecs = 0;
+
+	for (unsigned i = 0; i < ROUNDS; i++) {
+
+		unsigned long start = usecs();
+		if (fork_and_wait(false)) break;
+		fork_usecs += usecs() - start;
+
+		start = usecs();
+		if (fork_and_wait(true)) break;
+		exec_usecs += usecs() - start;
+
+		/* dirty the heap to let the next fork share it anew */
+		heap[i*4096 % heap_size]++;
+	}
+
+	printf("heap %6zu KiB: fork+exit %8lu us, fork+exec %8lu us\n",
+	       heap_size/1024, fork_usecs/ROUNDS, exec_usecs/ROUNDS);
+
+	free(heap);
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc > 1 && strcmp(argv[1], "child") == 0)
+		return 0;
+
+	self = argv[0];
+
+	printf("--- fork benchmark started ---\n");
+
+	for (size_t mib = 1; mib <= 64; mib *= 4)
+		measure(mib*1024*1024);
+
+	printf("--- fork benchmark finished ---\n");
+	return 0;
+}
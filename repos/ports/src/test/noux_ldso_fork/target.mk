@@ -0,0 +1,4 @@
+TARGET   = test-noux_ldso_fork
+SRC_CC   = test.cc
+LIBS     = libc libc_noux test-ldso_cow_lib
+INC_DIR += $(call select_from_repositories,src/test/ldso_cow/include)
@@ -0,0 +1,106 @@
+/*
+ * \brief  Test for forking a process with copy-on-write library data
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The data segments of shared libraries are populated on demand by a
+ * fault handler of the dynamic linker, which does not exist in the forked
+ * process. Hence, the fork must hand out private copies of the pages not
+ * written yet.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/wait.h>
+
+#include "test-ldso_cow.h"
+
+enum { PARENT_VALUE = 0x11111111, CHILD_VALUE = 0x22222222 };
+
+
+/**
+ * Check words of all pages of the library data
+ *
+ * \param first  expected value of the first word of each page
+ * \param skip   number of pages at the start not to check
+ */
+static int check(unsigned first, unsigned skip)
+{
+	for (unsigned i = skip*LDSO_COW_PAGE_WORDS; i < LDSO_COW_WORDS; i++) {
+		unsigned const expected = (i % LDSO_COW_PAGE_WORDS) ? LDSO_COW_PATTERN : first;
+		if (ldso_cow_data[i] != expected) {
+			printf("Error: pid %d: word %u is 0x%x, expected 0x%x\n",
+			       getpid(), i, ldso_cow_data[i], expected);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+
+int main(int, char **)
+{
+	/* populate the first half of the pages before forking */
+	unsigned const half = LDSO_COW_PAGES / 2;
+	for (unsigned i = 0; i < half; i++)
+		ldso_cow_data[i*LDSO_COW_PAGE_WORDS] = PARENT_VALUE;
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		printf("Error: fork returned %d, errno=%d\n", pid, errno);
+		return -1;
+	}
+
+	if (pid == 0) {
+
+		/* the child sees the parent's writes and the untouched pages */
+		for (unsigned i = 0; i < half; i++)
+			if (ldso_cow_data[i*LDSO_COW_PAGE_WORDS] != PARENT_VALUE) {
+				printf("Error: child lost write of parent to page %u\n", i);
+				_exit(1);
+			}
+		if (check(LDSO_COW_PATTERN, half))
+			_exit(1);
+
+		/* write to all pages, including those not populated yet */
+		for (unsigned i = 0; i < LDSO_COW_PAGES; i++)
+			ldso_cow_data[i*LDSO_COW_PAGE_WORDS] = CHILD_VALUE;
+
+		_exit(check(CHILD_VALUE, 0) ? 1 : 0);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+		printf("Error: child failed\n");
+		return -1;
+	}
+
+	/* the writes of the child must not be visible to the parent */
+	for (unsigned i = 0; i < half; i++)
+		if (ldso_cow_data[i*LDSO_COW_PAGE_WORDS] != PARENT_VALUE) {
+			printf("Error: parent sees write of child to page %u\n", i);
+			return -1;
+		}
+	if (check(LDSO_COW_PATTERN, half))
+		return -1;
+
+	/* the parent can still populate its remaining pages */
+	for (unsigned i = half; i < LDSO_COW_PAGES; i++)
+		ldso_cow_data[i*LDSO_COW_PAGE_WORDS] = PARENT_VALUE;
+
+	if (check(PARENT_VALUE, 0))
+		return -1;
+
+	printf("--- noux ldso fork test succeeded ---\n");
+	return 0;
+}
@@ -61,11 +61,12 @@ class Sub_rm_connection : public Genode::Rm_connection
 		                  Genode::size_t size = 0, Genode::off_t offset = 0,
 		                  bool use_local_addr = false,
 		                  Local_addr local_addr = (void *)0,
-		                  bool executable = false)
+		                  bool executable = false,
+		                  bool writeable = true)
 		{
 			Local_addr addr = Rm_connection::attach(ds, size, offset,
 			                                        use_local_addr, local_addr,
-			                                        executable);
+			                                        executable, writeable);
 			Genode::addr_t new_addr = addr;
 			new_addr += _offset;
 			return Local_addr(new_addr);